@@ -0,0 +1,491 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "modos.h"
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções do ajuste de parâmetros.
+// * -----------------------------------------------------------------------------
+
+/*
+ * Function: criar_ajuste
+ * -----------------------------------------------------------------------------
+ *   Lê as instâncias relacionadas no arquivo de lista (um caminho por linha) e
+ *   cria o ajuste de parâmetros. As instâncias são lidas uma única vez e
+ *   compartilhadas, somente leitura, por todas as execuções do ajuste.
+ *
+ *   lista: arquivo com os caminhos das instâncias.
+ *   execucoes: quantidade de execuções (sementes) por instância e
+ *   configuração.
+ *   threads: quantidade de threads (0 utiliza uma thread por processador).
+ *   corrida: TRUE elimina as configurações claramente piores a cada rodada.
+ *
+ *   returns: o ajuste alocado ou NULL caso a lista ou uma das instâncias não
+ *   possa ser lida.
+ */
+struct ajuste* criar_ajuste(char* lista, int execucoes, int threads, int corrida) {
+    struct ajuste* a;
+    FILE* fp;
+    char caminho[4096];
+    int capacidade = 16;
+    
+    fp = fopen(lista, "r");
+    if(!fp) {
+        printf("Não foi possível abrir o arquivo %s\n", lista);
+        return NULL;
+    }
+    
+    a = malloc(sizeof(struct ajuste));
+    memset(a, 0, sizeof(struct ajuste));
+    inicializar_opcoes(&a->opcoes);
+    
+    a->arquivos = malloc(capacidade * sizeof(char*));
+    
+    while(fgets(caminho, sizeof(caminho), fp)) {
+        caminho[strcspn(caminho, "\r\n")] = '\0';
+        
+        if(caminho[0] == '\0' || caminho[0] == '#') {
+            continue;
+        }
+        
+        if(a->quantidade_instancias == capacidade) {
+            capacidade *= 2;
+            a->arquivos = realloc(a->arquivos, capacidade * sizeof(char*));
+        }
+        
+        a->arquivos[a->quantidade_instancias++] = strdup(caminho);
+    }
+    
+    fclose(fp);
+    
+    a->instancias = malloc(a->quantidade_instancias * sizeof(struct problema));
+    
+    for(int i = 0; i < a->quantidade_instancias; i++) {
+        int erro = ler_arquivo(&a->instancias[i], a->arquivos[i], a->opcoes.paginas_grandes);
+        
+        if(!erro) {
+            erro = preparar_contexto(&a->instancias[i], NULL);
+            
+            if(erro) {
+                liberar_problema(&a->instancias[i]);
+            }
+        }
+        
+        if(erro) {
+            printf("Não foi possível preparar a instância %s: %s\n", a->arquivos[i], descrever_erro(erro));
+            
+            for(int k = 0; k < a->quantidade_instancias; k++) {
+                if(k < i) {
+                    liberar_problema(&a->instancias[k]);
+                }
+                
+                free(a->arquivos[k]);
+            }
+            
+            free(a->instancias);
+            free(a->arquivos);
+            free(a);
+            
+            return NULL;
+        }
+    }
+    
+    if(threads <= 0) {
+        threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    
+    a->execucoes = execucoes;
+    a->threads = threads < 1 ? 1 : threads;
+    a->corrida = corrida;
+    pthread_mutex_init(&a->mutex, NULL);
+    
+    return a;
+}
+
+/*
+ * Function: definir_grade_ajuste
+ * -----------------------------------------------------------------------------
+ *   Define as configurações avaliadas pelo ajuste como o produto cartesiano
+ *   dos valores informados para cada parâmetro.
+ *
+ *   a: ajuste de parâmetros.
+ *   iteracoes, quantidade_iteracoes: valores de iterações do GVNS.
+ *   vizinhancas, quantidade_vizinhancas: valores de vizinhanças exploradas.
+ *   construcoes, quantidade_construcoes: valores do modo de construção (0
+ *   gulosa, 1 aleatória).
+ */
+void definir_grade_ajuste(struct ajuste* a, int* iteracoes, int quantidade_iteracoes, int* vizinhancas, int quantidade_vizinhancas, int* construcoes, int quantidade_construcoes) {
+    int c = 0;
+    
+    a->quantidade_configuracoes = quantidade_iteracoes * quantidade_vizinhancas * quantidade_construcoes;
+    a->configuracoes = malloc(a->quantidade_configuracoes * sizeof(struct configuracao_ajuste));
+    
+    for(int i = 0; i < quantidade_iteracoes; i++) {
+        for(int v = 0; v < quantidade_vizinhancas; v++) {
+            for(int k = 0; k < quantidade_construcoes; k++) {
+                a->configuracoes[c].iteracoes = iteracoes[i];
+                a->configuracoes[c].vizinhancas = vizinhancas[v];
+                a->configuracoes[c].construcao_aleatoria = construcoes[k];
+                c++;
+            }
+        }
+    }
+    
+    a->custos = malloc((size_t) a->quantidade_configuracoes * a->quantidade_instancias * a->execucoes * sizeof(long long));
+    a->tempos = malloc((size_t) a->quantidade_configuracoes * a->quantidade_instancias * a->execucoes * sizeof(double));
+    a->tarefas = malloc((size_t) a->quantidade_configuracoes * a->quantidade_instancias * sizeof(struct tarefa_ajuste));
+}
+
+/*
+ * Function: executar_ajuste
+ * -----------------------------------------------------------------------------
+ *   Realiza o ajuste de parâmetros. As instâncias são agrupadas em classes
+ *   pelo tamanho e cada classe é ajustada separadamente, em rodadas: na
+ *   rodada r todas as configurações ainda ativas são executadas com a semente
+ *   r em todas as instâncias da classe, com as execuções distribuídas entre
+ *   as threads. Ao término, a melhor configuração de cada classe é impressa:
+ *
+ *   <CLASSE>;<ITERACOES>;<VIZINHANCAS>;<CONSTRUCAO>;<DESVIO_MEDIO>;<TEMPO_MEDIO>;<ATIVAS>
+ *
+ *   <DESVIO_MEDIO>: desvio relativo médio do custo em relação ao melhor custo
+ *   obtido pelas configurações ativas na mesma instância e semente.
+ *   <TEMPO_MEDIO>: tempo de relógio médio de cada execução, em segundos.
+ *   <ATIVAS>: configurações que não foram eliminadas pela corrida.
+ *
+ *   a: ajuste de parâmetros.
+ */
+void executar_ajuste(struct ajuste* a) {
+    int* classe = malloc(a->quantidade_instancias * sizeof(int));
+    int* processada = calloc(a->quantidade_instancias, sizeof(int));
+    int quantidade;
+    int melhor;
+    int ativas;
+    
+    for(int i = 0; i < a->quantidade_instancias; i++) {
+        if(processada[i]) {
+            continue;
+        }
+        
+        //agrupando as instâncias de mesmo tamanho
+        quantidade = 0;
+        for(int j = i; j < a->quantidade_instancias; j++) {
+            if(!processada[j] && a->instancias[j].tamanho == a->instancias[i].tamanho) {
+                classe[quantidade++] = j;
+                processada[j] = TRUE;
+            }
+        }
+        
+        for(int c = 0; c < a->quantidade_configuracoes; c++) {
+            a->configuracoes[c].ativa = TRUE;
+        }
+        
+        for(int r = 0; r < a->execucoes; r++) {
+            executar_rodada_ajuste(a, classe, quantidade, r);
+            
+            if(a->corrida && r + 1 >= AJUSTE_RODADAS_MINIMAS) {
+                eliminar_configuracoes(a, classe, quantidade, r + 1);
+            }
+        }
+        
+        melhor = avaliar_configuracoes(a, classe, quantidade, a->execucoes);
+        
+        ativas = 0;
+        for(int c = 0; c < a->quantidade_configuracoes; c++) {
+            ativas += a->configuracoes[c].ativa;
+        }
+        
+        printf("n=%d;%d;%d;%d;%.6f;%.6f;%d\n", a->instancias[i].tamanho, a->configuracoes[melhor].iteracoes, a->configuracoes[melhor].vizinhancas, a->configuracoes[melhor].construcao_aleatoria, a->configuracoes[melhor].desvio, a->configuracoes[melhor].tempo, ativas);
+    }
+    
+    free(classe);
+    free(processada);
+}
+
+/*
+ * Function: executar_rodada_ajuste
+ * -----------------------------------------------------------------------------
+ *   Executa com a semente da rodada todas as combinações de configuração
+ *   ativa e instância da classe, distribuindo-as entre as threads.
+ *
+ *   a: ajuste de parâmetros.
+ *   classe: índices das instâncias da classe.
+ *   quantidade: quantidade de instâncias da classe.
+ *   rodada: rodada (semente) executada.
+ */
+void executar_rodada_ajuste(struct ajuste* a, int* classe, int quantidade, int rodada) {
+    pthread_t* trabalhadores;
+    int threads;
+    
+    a->quantidade_tarefas = 0;
+    a->proxima = 0;
+    a->rodada = rodada;
+    
+    for(int c = 0; c < a->quantidade_configuracoes; c++) {
+        if(!a->configuracoes[c].ativa) {
+            continue;
+        }
+        
+        for(int k = 0; k < quantidade; k++) {
+            a->tarefas[a->quantidade_tarefas].configuracao = c;
+            a->tarefas[a->quantidade_tarefas].instancia = classe[k];
+            a->quantidade_tarefas++;
+        }
+    }
+    
+    threads = a->threads < a->quantidade_tarefas ? a->threads : a->quantidade_tarefas;
+    trabalhadores = malloc(threads * sizeof(pthread_t));
+    
+    for(int t = 0; t < threads; t++) {
+        pthread_create(&trabalhadores[t], NULL, executar_tarefas_ajuste, a);
+    }
+    
+    for(int t = 0; t < threads; t++) {
+        pthread_join(trabalhadores[t], NULL);
+    }
+    
+    free(trabalhadores);
+}
+
+/*
+ * Function: executar_tarefas_ajuste
+ * -----------------------------------------------------------------------------
+ *   Função executada por cada thread do ajuste: retira a próxima tarefa da
+ *   rodada e realiza uma execução do GVNS com a configuração da tarefa.
+ *
+ *   argumento: ajuste em andamento (struct ajuste).
+ */
+void* executar_tarefas_ajuste(void* argumento) {
+    struct ajuste* a = argumento;
+    struct opcoes opcoes = a->opcoes;
+    struct configuracao_ajuste* c;
+    struct solucionador* s;
+    int* solucao;
+    size_t indice;
+    double inicio;
+    int t;
+    
+    while(TRUE) {
+        pthread_mutex_lock(&a->mutex);
+        t = a->proxima++;
+        pthread_mutex_unlock(&a->mutex);
+        
+        if(t >= a->quantidade_tarefas) {
+            break;
+        }
+        
+        c = &a->configuracoes[a->tarefas[t].configuracao];
+        opcoes.iteracoes = c->iteracoes;
+        opcoes.vizinhancas = c->vizinhancas;
+        opcoes.construcao_aleatoria = c->construcao_aleatoria;
+        
+        s = criar_solucionador(&a->instancias[a->tarefas[t].instancia], &opcoes);
+        solucao = inicializar_solucao(s->problema.tamanho, NULL);
+        indice = indice_ajuste(a, a->tarefas[t].configuracao, a->tarefas[t].instancia, a->rodada);
+        
+        inicio = relogio();
+        a->custos[indice] = executar_gvns(s, a->rodada, solucao);
+        a->tempos[indice] = relogio() - inicio;
+        
+        free(solucao);
+        liberar_solucionador(s);
+    }
+    
+    return NULL;
+}
+
+/*
+ * Function: avaliar_configuracoes
+ * -----------------------------------------------------------------------------
+ *   Calcula o desvio relativo médio e o tempo médio das configurações ativas
+ *   nas rodadas já realizadas. O desvio de uma execução é medido em relação
+ *   ao menor custo obtido pelas configurações ativas na mesma instância e
+ *   semente, de forma que todas as configurações sejam comparadas nas mesmas
+ *   execuções.
+ *
+ *   a: ajuste de parâmetros.
+ *   classe: índices das instâncias da classe.
+ *   quantidade: quantidade de instâncias da classe.
+ *   rodadas: quantidade de rodadas realizadas.
+ *
+ *   returns: índice da configuração ativa de menor desvio médio (o tempo
+ *   médio desempata).
+ */
+int avaliar_configuracoes(struct ajuste* a, int* classe, int quantidade, int rodadas) {
+    int melhor = -1;
+    
+    for(int c = 0; c < a->quantidade_configuracoes; c++) {
+        a->configuracoes[c].desvio = 0;
+        a->configuracoes[c].tempo = 0;
+    }
+    
+    for(int k = 0; k < quantidade; k++) {
+        for(int r = 0; r < rodadas; r++) {
+            long long referencia = menor_custo_ajuste(a, classe[k], r);
+            
+            for(int c = 0; c < a->quantidade_configuracoes; c++) {
+                if(!a->configuracoes[c].ativa) {
+                    continue;
+                }
+                
+                size_t indice = indice_ajuste(a, c, classe[k], r);
+                a->configuracoes[c].desvio += (double) (a->custos[indice] - referencia) / referencia;
+                a->configuracoes[c].tempo += a->tempos[indice];
+            }
+        }
+    }
+    
+    for(int c = 0; c < a->quantidade_configuracoes; c++) {
+        if(!a->configuracoes[c].ativa) {
+            continue;
+        }
+        
+        a->configuracoes[c].desvio /= quantidade * rodadas;
+        a->configuracoes[c].tempo /= quantidade * rodadas;
+        
+        if(melhor < 0 || a->configuracoes[c].desvio < a->configuracoes[melhor].desvio ||
+           (a->configuracoes[c].desvio == a->configuracoes[melhor].desvio && a->configuracoes[c].tempo < a->configuracoes[melhor].tempo)) {
+            melhor = c;
+        }
+    }
+    
+    return melhor;
+}
+
+/*
+ * Function: eliminar_configuracoes
+ * -----------------------------------------------------------------------------
+ *   Etapa de eliminação da corrida. Cada configuração ativa é comparada com a
+ *   melhor configuração através das diferenças pareadas de custo relativo
+ *   (mesma instância e semente); a configuração é eliminada quando a
+ *   diferença média é positiva e maior que AJUSTE_LIMIAR_ELIMINACAO erros
+ *   padrão, ou seja, quando é claramente pior que a melhor.
+ *
+ *   a: ajuste de parâmetros.
+ *   classe: índices das instâncias da classe.
+ *   quantidade: quantidade de instâncias da classe.
+ *   rodadas: quantidade de rodadas realizadas.
+ */
+void eliminar_configuracoes(struct ajuste* a, int* classe, int quantidade, int rodadas) {
+    int melhor = avaliar_configuracoes(a, classe, quantidade, rodadas);
+    int amostras = quantidade * rodadas;
+    
+    for(int c = 0; c < a->quantidade_configuracoes; c++) {
+        double soma = 0;
+        double soma_quadrados = 0;
+        
+        if(c == melhor || !a->configuracoes[c].ativa) {
+            continue;
+        }
+        
+        for(int k = 0; k < quantidade; k++) {
+            for(int r = 0; r < rodadas; r++) {
+                long long custo_melhor = a->custos[indice_ajuste(a, melhor, classe[k], r)];
+                long long custo = a->custos[indice_ajuste(a, c, classe[k], r)];
+                double diferenca = (double) (custo - custo_melhor) / custo_melhor;
+                
+                soma += diferenca;
+                soma_quadrados += diferenca * diferenca;
+            }
+        }
+        
+        double media = soma / amostras;
+        double variancia = (soma_quadrados - amostras * media * media) / (amostras - 1);
+        double erro = sqrt(variancia > 0 ? variancia : 0) / sqrt(amostras);
+        
+        if(media > 0 && media > AJUSTE_LIMIAR_ELIMINACAO * erro) {
+            a->configuracoes[c].ativa = FALSE;
+        }
+    }
+}
+
+/*
+ * Function: menor_custo_ajuste
+ * -----------------------------------------------------------------------------
+ *   Retorna o menor custo obtido pelas configurações ativas em uma instância
+ *   e semente.
+ */
+long long menor_custo_ajuste(struct ajuste* a, int instancia, int rodada) {
+    long long menor = -1;
+    
+    for(int c = 0; c < a->quantidade_configuracoes; c++) {
+        if(!a->configuracoes[c].ativa) {
+            continue;
+        }
+        
+        long long custo = a->custos[indice_ajuste(a, c, instancia, rodada)];
+        
+        if(menor < 0 || custo < menor) {
+            menor = custo;
+        }
+    }
+    
+    return menor;
+}
+
+/*
+ * Function: indice_ajuste
+ * -----------------------------------------------------------------------------
+ *   Posição do resultado de uma execução nos vetores de custos e tempos.
+ */
+size_t indice_ajuste(struct ajuste* a, int configuracao, int instancia, int rodada) {
+    return ((size_t) configuracao * a->quantidade_instancias + instancia) * a->execucoes + rodada;
+}
+
+/*
+ * Function: ler_valores
+ * -----------------------------------------------------------------------------
+ *   Lê uma lista de inteiros separados por vírgula (por exemplo 100,200,500).
+ *
+ *   texto: lista informada na linha de comando.
+ *   valores: recebe o vetor alocado com os valores.
+ *
+ *   returns: quantidade de valores lidos.
+ */
+int ler_valores(char* texto, int** valores) {
+    int quantidade = 1;
+    char* p = texto;
+    
+    for(; *p; p++) {
+        quantidade += *p == ',';
+    }
+    
+    *valores = malloc(quantidade * sizeof(int));
+    
+    p = texto;
+    for(int i = 0; i < quantidade; i++) {
+        (*valores)[i] = (int) strtol(p, &p, 10);
+        
+        if(*p == ',') {
+            p++;
+        }
+    }
+    
+    return quantidade;
+}
+
+/*
+ * Function: liberar_ajuste
+ * -----------------------------------------------------------------------------
+ *   Libera a memória alocada para o ajuste e para as instâncias.
+ *
+ *   a: ajuste que será liberado.
+ */
+void liberar_ajuste(struct ajuste* a) {
+    for(int i = 0; i < a->quantidade_instancias; i++) {
+        liberar_problema(&a->instancias[i]);
+        free(a->arquivos[i]);
+    }
+    
+    pthread_mutex_destroy(&a->mutex);
+    free(a->instancias);
+    free(a->arquivos);
+    free(a->configuracoes);
+    free(a->custos);
+    free(a->tempos);
+    free(a->tarefas);
+    free(a);
+}
@@ -0,0 +1,332 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "interno.h"
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções de checkpoint e retomada da busca.
+// * -----------------------------------------------------------------------------
+
+/*
+ * Function: iniciar_checkpoint
+ * -----------------------------------------------------------------------------
+ *   Cria a estrutura de checkpoint e inicia a thread responsável por gravar
+ *   os checkpoints, de forma que a busca não fique bloqueada durante a escrita
+ *   do arquivo.
+ *
+ *   Para validar a retomada são gravados a assinatura da instância (a mesma
+ *   do contexto, calculada após a renumeração e as alterações, seguida da
+ *   solução inicial informada) e as opções que alteram a trajetória da
+ *   busca. As opções que apenas aceleram a busca com os mesmos resultados
+ *   (tabela de ganhos, avaliação vetorial, threads da construção e cache
+ *   de linhas) podem mudar entre a interrupção e a retomada.
+ *
+ *   arquivo: caminho do arquivo de checkpoint.
+ *   intervalo: intervalo mínimo em segundos entre as gravações.
+ *   p: problema das execuções, com o contexto já preparado.
+ *   opcoes: opções de execução do método.
+ *   execucoes: quantidade de execuções.
+ *   renumerar: TRUE caso os elementos tenham sido renumerados.
+ *   informacoes: informações das execuções concluídas.
+ *
+ *   returns: a estrutura de checkpoint alocada.
+ */
+struct checkpoint* iniciar_checkpoint(char* arquivo, int intervalo, struct problema* p, struct opcoes* opcoes, int execucoes, int renumerar, struct informacao_execucao* informacoes) {
+    struct checkpoint* c = malloc(sizeof(struct checkpoint));
+    unsigned long long h = p->contexto ? p->contexto->assinatura : calcular_assinatura(p);
+    
+    memset(c, 0, sizeof(struct checkpoint));
+    
+    //a solução inicial e as posições afetadas determinam o início da busca
+    if(opcoes->solucao_inicial) {
+        for(int i = 0; i <= p->tamanho; i++) {
+            h = (h ^ (unsigned int) opcoes->solucao_inicial[i]) * 0x100000001b3ULL;
+        }
+        
+        for(int i = 0; i < opcoes->quantidade_afetadas; i++) {
+            h = (h ^ (unsigned int) opcoes->posicoes_afetadas[i]) * 0x100000001b3ULL;
+        }
+    }
+    
+    c->arquivo = arquivo;
+    c->intervalo = intervalo;
+    c->ultima_gravacao = time(NULL);
+    c->tamanho = p->tamanho;
+    c->assinatura = h;
+    c->parametros[0] = opcoes->iteracoes;
+    c->parametros[1] = opcoes->vizinhancas;
+    c->parametros[2] = opcoes->construcao_aleatoria;
+    c->parametros[3] = execucoes;
+    c->parametros[4] = opcoes->busca_localizada;
+    c->parametros[5] = opcoes->varredura_unificada;
+    c->parametros[6] = opcoes->construcoes;
+    c->parametros[7] = opcoes->elite;
+    c->parametros[8] = renumerar;
+    c->parametros[9] = opcoes->solucao_inicial != NULL;
+    c->alvo = opcoes->alvo;
+    c->informacoes = informacoes;
+    c->estado.solucao = inicializar_solucao(p->tamanho, NULL);
+    c->gravacao.solucao = inicializar_solucao(p->tamanho, NULL);
+    
+    pthread_mutex_init(&c->mutex, NULL);
+    pthread_cond_init(&c->condicao, NULL);
+    pthread_create(&c->thread, NULL, gravar_checkpoints, c);
+    
+    return c;
+}
+
+/*
+ * Function: carregar_checkpoint
+ * -----------------------------------------------------------------------------
+ *   Lê o arquivo de checkpoint, restaurando as execuções concluídas e o estado
+ *   da execução que estava em andamento. Um checkpoint incompleto ou gerado
+ *   para outra instância ou com parâmetros diferentes não é carregado; cabe
+ *   ao chamador informar o erro (ERRO_CHECKPOINT).
+ *
+ *   c: estrutura de checkpoint.
+ *
+ *   returns: TRUE caso o checkpoint tenha sido carregado, FALSE caso o
+ *   arquivo não exista e -1 caso o checkpoint seja inválido.
+ */
+int carregar_checkpoint(struct checkpoint* c) {
+    FILE* fp;
+    char assinatura[sizeof(CHECKPOINT_ASSINATURA)];
+    int tamanho;
+    unsigned long long assinatura_gravada;
+    int parametros[CHECKPOINT_PARAMETROS];
+    long long alvo_gravado;
+    struct estado_busca* e = &c->estado;
+    int lidas = 0;
+    int valido;
+    
+    fp = fopen(c->arquivo, "rb");
+    if(!fp) {
+        return FALSE;
+    }
+    
+    valido = fread(assinatura, sizeof(assinatura), 1, fp) == 1
+        && memcmp(assinatura, CHECKPOINT_ASSINATURA, sizeof(assinatura)) == 0
+        && fread(&tamanho, sizeof(int), 1, fp) == 1
+        && fread(&assinatura_gravada, sizeof(unsigned long long), 1, fp) == 1
+        && fread(parametros, sizeof(parametros), 1, fp) == 1
+        && fread(&alvo_gravado, sizeof(alvo_gravado), 1, fp) == 1
+        && tamanho == c->tamanho && assinatura_gravada == c->assinatura
+        && memcmp(parametros, c->parametros, sizeof(parametros)) == 0 && alvo_gravado == c->alvo;
+    
+    valido = valido
+        && fread(&e->concluidas, sizeof(int), 1, fp) == 1
+        && fread(&e->em_andamento, sizeof(int), 1, fp) == 1
+        && fread(&e->iteracao, sizeof(int), 1, fp) == 1
+        && fread(&e->vizinhanca, sizeof(int), 1, fp) == 1
+        && fread(&e->custo, sizeof(long long), 1, fp) == 1
+        && fread(&e->estado_aleatorio, sizeof(unsigned long long), 1, fp) == 1
+        && fread(&e->tempo, sizeof(double), 1, fp) == 1
+        && fread(e->solucao, sizeof(int), c->tamanho + 1, fp) == (size_t) c->tamanho + 1
+        && e->concluidas >= 0 && e->concluidas <= c->parametros[3];
+    
+    //lidas: execuções concluídas cujas soluções já foram alocadas
+    for(; valido && lidas < e->concluidas; lidas++) {
+        c->informacoes[lidas].solucao = inicializar_solucao(c->tamanho, NULL);
+        
+        valido = fread(&c->informacoes[lidas].valor_encontrado, sizeof(long long), 1, fp) == 1
+            && fread(&c->informacoes[lidas].tempo, sizeof(double), 1, fp) == 1
+            && fread(c->informacoes[lidas].solucao, sizeof(int), c->tamanho + 1, fp) == (size_t) c->tamanho + 1;
+    }
+    
+    fclose(fp);
+    
+    if(!valido) {
+        for(int i = 0; i < lidas; i++) {
+            free(c->informacoes[i].solucao);
+            c->informacoes[i].solucao = NULL;
+        }
+        
+        e->concluidas = 0;
+        e->em_andamento = FALSE;
+        
+        return -1;
+    }
+    
+    c->retomar = e->em_andamento;
+    
+    return TRUE;
+}
+
+/*
+ * Function: registrar_checkpoint
+ * -----------------------------------------------------------------------------
+ *   Registra o estado atual do GVNS para gravação caso o intervalo entre os
+ *   checkpoints tenha sido atingido. O estado é apenas copiado e a gravação é
+ *   feita pela thread de gravação.
+ *
+ *   c: estrutura de checkpoint.
+ *   iteracao: iteração atual do GVNS.
+ *   vizinhanca: vizinhança que será explorada.
+ *   custo: custo da melhor solução.
+ *   estado_aleatorio: estado do gerador de números aleatórios.
+ *   solucao: melhor solução encontrada.
+ */
+void registrar_checkpoint(struct checkpoint* c, int iteracao, int vizinhanca, long long custo, unsigned long long estado_aleatorio, int* solucao) {
+    time_t agora = time(NULL);
+    
+    if(agora - c->ultima_gravacao < c->intervalo) {
+        return;
+    }
+    
+    c->ultima_gravacao = agora;
+    
+    pthread_mutex_lock(&c->mutex);
+    c->estado.em_andamento = TRUE;
+    c->estado.iteracao = iteracao;
+    c->estado.vizinhanca = vizinhanca;
+    c->estado.custo = custo;
+    c->estado.estado_aleatorio = estado_aleatorio;
+    c->estado.tempo = c->tempo_anterior + relogio() - c->inicio;
+    copiar_solucao(c->tamanho, solucao, c->estado.solucao);
+    c->pendente = TRUE;
+    pthread_cond_signal(&c->condicao);
+    pthread_mutex_unlock(&c->mutex);
+}
+
+/*
+ * Function: concluir_execucao_checkpoint
+ * -----------------------------------------------------------------------------
+ *   Registra a conclusão de uma execução, solicitando a gravação imediata do
+ *   checkpoint.
+ *
+ *   c: estrutura de checkpoint.
+ *   concluidas: quantidade de execuções concluídas.
+ */
+void concluir_execucao_checkpoint(struct checkpoint* c, int concluidas) {
+    pthread_mutex_lock(&c->mutex);
+    c->estado.concluidas = concluidas;
+    c->estado.em_andamento = FALSE;
+    c->pendente = TRUE;
+    pthread_cond_signal(&c->condicao);
+    pthread_mutex_unlock(&c->mutex);
+    
+    c->ultima_gravacao = time(NULL);
+}
+
+/*
+ * Function: finalizar_checkpoint
+ * -----------------------------------------------------------------------------
+ *   Encerra a thread de gravação e remove o arquivo de checkpoint, visto que
+ *   todas as execuções foram concluídas.
+ *
+ *   c: estrutura de checkpoint.
+ */
+void finalizar_checkpoint(struct checkpoint* c) {
+    pthread_mutex_lock(&c->mutex);
+    c->encerrar = TRUE;
+    c->pendente = FALSE;
+    pthread_cond_signal(&c->condicao);
+    pthread_mutex_unlock(&c->mutex);
+    
+    pthread_join(c->thread, NULL);
+    
+    remove(c->arquivo);
+    
+    pthread_mutex_destroy(&c->mutex);
+    pthread_cond_destroy(&c->condicao);
+    free(c->estado.solucao);
+    free(c->gravacao.solucao);
+    free(c);
+}
+
+/*
+ * Function: gravar_checkpoints
+ * -----------------------------------------------------------------------------
+ *   Rotina da thread de gravação. Aguarda um estado pendente, troca-o com o
+ *   buffer de gravação (liberando imediatamente o estado para a busca) e
+ *   grava o arquivo fora da região crítica.
+ *
+ *   argumento: estrutura de checkpoint.
+ */
+void* gravar_checkpoints(void* argumento) {
+    struct checkpoint* c = argumento;
+    struct estado_busca tmp;
+    
+    pthread_mutex_lock(&c->mutex);
+    
+    while(!c->encerrar) {
+        if(!c->pendente) {
+            pthread_cond_wait(&c->condicao, &c->mutex);
+            continue;
+        }
+        
+        tmp = c->gravacao;
+        c->gravacao = c->estado;
+        c->estado = tmp;
+        c->estado.concluidas = c->gravacao.concluidas;
+        c->pendente = FALSE;
+        
+        pthread_mutex_unlock(&c->mutex);
+        gravar_checkpoint(c, &c->gravacao);
+        pthread_mutex_lock(&c->mutex);
+    }
+    
+    pthread_mutex_unlock(&c->mutex);
+    
+    return NULL;
+}
+
+/*
+ * Function: gravar_checkpoint
+ * -----------------------------------------------------------------------------
+ *   Grava o checkpoint de forma atômica: o conteúdo é escrito em um arquivo
+ *   temporário, sincronizado com o disco e então renomeado para o arquivo de
+ *   checkpoint.
+ *
+ *   c: estrutura de checkpoint.
+ *   e: estado que será gravado.
+ *
+ *   returns: TRUE caso o checkpoint tenha sido gravado.
+ */
+int gravar_checkpoint(struct checkpoint* c, struct estado_busca* e) {
+    FILE* fp;
+    char* temporario;
+    int sucesso;
+    
+    temporario = malloc(strlen(c->arquivo) + strlen(".tmp") + 1);
+    sprintf(temporario, "%s.tmp", c->arquivo);
+    
+    fp = fopen(temporario, "wb");
+    if(!fp) {
+        free(temporario);
+        return FALSE;
+    }
+    
+    fwrite(CHECKPOINT_ASSINATURA, sizeof(CHECKPOINT_ASSINATURA), 1, fp);
+    fwrite(&c->tamanho, sizeof(int), 1, fp);
+    fwrite(&c->assinatura, sizeof(unsigned long long), 1, fp);
+    fwrite(c->parametros, sizeof(c->parametros), 1, fp);
+    fwrite(&c->alvo, sizeof(long long), 1, fp);
+    fwrite(&e->concluidas, sizeof(int), 1, fp);
+    fwrite(&e->em_andamento, sizeof(int), 1, fp);
+    fwrite(&e->iteracao, sizeof(int), 1, fp);
+    fwrite(&e->vizinhanca, sizeof(int), 1, fp);
+    fwrite(&e->custo, sizeof(long long), 1, fp);
+    fwrite(&e->estado_aleatorio, sizeof(unsigned long long), 1, fp);
+    fwrite(&e->tempo, sizeof(double), 1, fp);
+    fwrite(e->solucao, sizeof(int), c->tamanho + 1, fp);
+    
+    //as execuções concluídas não são mais alteradas pela busca
+    for(int i = 0; i < e->concluidas; i++) {
+        fwrite(&c->informacoes[i].valor_encontrado, sizeof(long long), 1, fp);
+        fwrite(&c->informacoes[i].tempo, sizeof(double), 1, fp);
+        fwrite(c->informacoes[i].solucao, sizeof(int), c->tamanho + 1, fp);
+    }
+    
+    sucesso = fflush(fp) == 0 && fsync(fileno(fp)) == 0;
+    sucesso = fclose(fp) == 0 && sucesso;
+    sucesso = sucesso && rename(temporario, c->arquivo) == 0;
+    
+    free(temporario);
+    
+    return sucesso;
+}
@@ -0,0 +1,314 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <pthread.h>
+
+#include "interno.h"
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções da construção em lote (várias soluções iniciais por
+// * execução).
+// *
+// * O passo i da construção lê, para todas as soluções, a mesma linha i das
+// * distâncias (e das listas de vizinhos do contexto). As soluções do lote
+// * são construídas em conjunto, passo a passo, de forma que cada linha seja
+// * lida uma vez da memória e reaproveitada por todas elas. Cada solução
+// * possui o seu próprio gerador de números aleatórios, de forma que o
+// * resultado não depende da quantidade de threads.
+// * -----------------------------------------------------------------------------
+
+/*
+ * Function: preparar_lote
+ * -----------------------------------------------------------------------------
+ *   Retorna a área de trabalho da construção em lote do solucionador,
+ *   alocando-a na primeira chamada. As execuções seguintes reaproveitam a
+ *   mesma área, sem novas alocações.
+ *
+ *   s: solucionador com o problema e as opções de execução.
+ *
+ *   returns: a área de trabalho do lote.
+ */
+struct lote_construcao* preparar_lote(struct solucionador* s) {
+    struct lote_construcao* lote = s->lote;
+    int n = s->problema.tamanho;
+    
+    if(lote) {
+        return lote;
+    }
+    
+    lote = malloc(sizeof(struct lote_construcao));
+    lote->capacidade = s->opcoes.construcoes;
+    lote->threads = s->opcoes.threads_construcao > 1 ? s->opcoes.threads_construcao : 1;
+    
+    if(lote->threads > lote->capacidade) {
+        lote->threads = lote->capacidade;
+    }
+    
+    if(lote->threads > MAXIMO_THREADS_CONSTRUCAO) {
+        lote->threads = MAXIMO_THREADS_CONSTRUCAO;
+    }
+    
+    //o cache de distâncias é alterado a cada acesso e não pode ser dividido
+    if(s->problema.cache) {
+        lote->threads = 1;
+    }
+    
+    lote->solucoes = malloc((size_t) lote->capacidade * (n + 1) * sizeof(int));
+    lote->inseridos = malloc((size_t) lote->capacidade * n * sizeof(char));
+    lote->estados = malloc(lote->capacidade * sizeof(unsigned long long));
+    lote->custos = malloc(lote->capacidade * sizeof(long long));
+    lote->ordem = malloc(lote->capacidade * sizeof(int));
+    lote->vizinhos = malloc((size_t) lote->threads * n * sizeof(struct nodo));
+    lote->linhas = malloc((size_t) lote->threads * n * sizeof(int));
+    
+    s->lote = lote;
+    
+    return lote;
+}
+
+/*
+ * Function: construir_lote
+ * -----------------------------------------------------------------------------
+ *   Constrói as soluções primeira a primeira + quantidade - 1 do lote com o
+ *   mesmo critério de construir_solucao, avançando todas elas um passo por
+ *   vez. Sem o contexto pré-processado, as distâncias da linha do passo são
+ *   calculadas uma única vez para todas as soluções.
+ *
+ *   s: solucionador com o problema e as opções de execução.
+ *   lote: área de trabalho do lote (ver preparar_lote).
+ *   primeira: primeira solução construída.
+ *   quantidade: quantidade de soluções construídas.
+ *   trabalhador: índice da thread, que seleciona a sua área de trabalho.
+ */
+void construir_lote(struct solucionador* s, struct lote_construcao* lote, int primeira, int quantidade, int trabalhador) {
+    struct problema* p = &s->problema;
+    struct nodo* vizinhos = lote->vizinhos + (size_t) trabalhador * p->tamanho;
+    int* linha = lote->linhas + (size_t) trabalhador * p->tamanho;
+    int iv = 0;
+    int indice_selecionado, indice_selecionado2;
+    int numero_candidatos;
+    float taxa_crescimento, percentual_atual;
+    int* ordem = NULL;
+    int* solucao;
+    char* inserido;
+    
+    numero_candidatos = ceil(lote->percentual_inicial * p->tamanho);
+    taxa_crescimento = (lote->percentual_final - lote->percentual_inicial) / p->tamanho;
+    percentual_atual = lote->percentual_inicial + taxa_crescimento;
+    
+    for(int t = primeira; t < primeira + quantidade; t++) {
+        inserido = lote->inseridos + (size_t) t * p->tamanho;
+        memset(inserido, FALSE, p->tamanho * sizeof(char));
+        inserido[0] = TRUE;
+        lote->solucoes[(size_t) t * (p->tamanho + 1)] = 0;
+    }
+    
+    for(int i = 0; i < p->tamanho; i++) {
+        if(p->contexto) {
+            ordem = p->contexto->vizinhos + (size_t) i * p->tamanho;
+        } else {
+            for(int j = 0; j < p->tamanho; j++) {
+                linha[j] = distancia(p, i, j);
+            }
+        }
+        
+        for(int t = primeira; t < primeira + quantidade; t++) {
+            solucao = lote->solucoes + (size_t) t * (p->tamanho + 1);
+            inserido = lote->inseridos + (size_t) t * p->tamanho;
+            iv = 0;
+            
+            if(ordem) {
+                for(int k = 0; k < p->tamanho && iv < numero_candidatos; k++) {
+                    if(!inserido[ordem[k]]) {
+                        vizinhos[iv].indice = ordem[k];
+                        vizinhos[iv].valor = distancia(p, i, ordem[k]);
+                        
+                        iv++;
+                    }
+                }
+            } else {
+                for(int j = 0; j < p->tamanho; j++) {
+                    if(!inserido[j]) {
+                        vizinhos[iv].indice = j;
+                        vizinhos[iv].valor = linha[j];
+                        
+                        iv++;
+                    }
+                }
+                
+                selection_sort(vizinhos, iv);
+            }
+            
+            if(iv == 0) {
+                solucao[i + 1] = 0;
+                continue;
+            }
+            
+            do {
+                if(numero_candidatos > iv) {
+                    indice_selecionado = sortear(&lote->estados[t]) % iv;
+                    indice_selecionado2 = sortear(&lote->estados[t]) % iv;
+                } else {
+                    indice_selecionado = sortear(&lote->estados[t]) % numero_candidatos;
+                    indice_selecionado2 = sortear(&lote->estados[t]) % numero_candidatos;
+                }
+                
+                if(!inserido[vizinhos[indice_selecionado2].indice] && vizinhos[indice_selecionado].valor > vizinhos[indice_selecionado2].valor) {
+                    indice_selecionado = indice_selecionado2;
+                }
+            } while(inserido[vizinhos[indice_selecionado].indice]);
+            
+            solucao[i + 1] = vizinhos[indice_selecionado].indice;
+            inserido[vizinhos[indice_selecionado].indice] = TRUE;
+        }
+        
+        //a quantidade de candidatos evolui igualmente em todas as soluções
+        if(iv > 0) {
+            numero_candidatos = ceil(percentual_atual * p->tamanho);
+            percentual_atual += taxa_crescimento;
+        }
+    }
+}
+
+/*
+ * Function: executar_tarefa_construcao
+ * -----------------------------------------------------------------------------
+ *   Função executada pelas threads da construção em lote.
+ *
+ *   argumento: tarefa da thread (struct tarefa_construcao).
+ *
+ *   returns: NULL.
+ */
+void* executar_tarefa_construcao(void* argumento) {
+    struct tarefa_construcao* t = argumento;
+    
+    construir_lote(t->solucionador, t->solucionador->lote, t->primeira, t->quantidade, t->trabalhador);
+    
+    return NULL;
+}
+
+/*
+ * Function: construir_melhor_solucao
+ * -----------------------------------------------------------------------------
+ *   Constrói opcoes.construcoes soluções em lote, distribuídas entre
+ *   opcoes.threads_construcao threads, e retorna a de menor custo. Com
+ *   opcoes.elite > 1, as opcoes.elite melhores construções recebem o VND e a
+ *   melhor solução resultante é retornada.
+ *
+ *   O gerador de cada solução é derivado do estado do solucionador, que
+ *   avança uma única vez, de forma que o resultado depende apenas da
+ *   semente da execução.
+ *
+ *   s: solucionador com o problema e as opções de execução.
+ *   percentual_inicial: ver construir_solucao.
+ *   percentual_final: ver construir_solucao.
+ *   solucao: solução construída.
+ *
+ *   returns: custo da solução construída.
+ */
+long long construir_melhor_solucao(struct solucionador* s, float percentual_inicial, float percentual_final, int* solucao) {
+    struct problema* p = &s->problema;
+    struct lote_construcao* lote = preparar_lote(s);
+    struct tarefa_construcao tarefas[MAXIMO_THREADS_CONSTRUCAO];
+    pthread_t threads[MAXIMO_THREADS_CONSTRUCAO];
+    struct solucao* candidata;
+    int quantidade = lote->capacidade;
+    int elite = s->opcoes.elite > 1 ? s->opcoes.elite : 1;
+    long long melhor = LLONG_MAX;
+    long long custo;
+    int tmp;
+    
+    lote->percentual_inicial = percentual_inicial;
+    lote->percentual_final = percentual_final;
+    
+    for(int t = 0; t < quantidade; t++) {
+        lote->estados[t] = s->estado_aleatorio ^ ((t + 1) * 0x9E3779B97F4A7C15ULL);
+        
+        if(!lote->estados[t]) {
+            lote->estados[t] = 1;
+        }
+    }
+    aleatorio(s);
+    
+    if(lote->threads <= 1) {
+        construir_lote(s, lote, 0, quantidade, 0);
+    } else {
+        for(int t = 0; t < lote->threads; t++) {
+            tarefas[t].solucionador = s;
+            tarefas[t].trabalhador = t;
+            tarefas[t].primeira = (int) ((long long) quantidade * t / lote->threads);
+            tarefas[t].quantidade = (int) ((long long) quantidade * (t + 1) / lote->threads) - tarefas[t].primeira;
+            pthread_create(&threads[t], NULL, executar_tarefa_construcao, &tarefas[t]);
+        }
+        
+        for(int t = 0; t < lote->threads; t++) {
+            pthread_join(threads[t], NULL);
+        }
+    }
+    
+    //ordenando parcialmente as construções pelo custo (empates pela ordem de construção)
+    for(int t = 0; t < quantidade; t++) {
+        lote->custos[t] = calcular_custo(p, lote->solucoes + (size_t) t * (p->tamanho + 1));
+        lote->ordem[t] = t;
+    }
+    
+    if(elite > quantidade) {
+        elite = quantidade;
+    }
+    
+    for(int e = 0; e < elite; e++) {
+        for(int t = e + 1; t < quantidade; t++) {
+            if(lote->custos[lote->ordem[t]] < lote->custos[lote->ordem[e]] || (lote->custos[lote->ordem[t]] == lote->custos[lote->ordem[e]] && lote->ordem[t] < lote->ordem[e])) {
+                tmp = lote->ordem[e];
+                lote->ordem[e] = lote->ordem[t];
+                lote->ordem[t] = tmp;
+            }
+        }
+    }
+    
+    if(s->opcoes.debug) {
+        printf("Construções: %d, melhor custo %lld, pior custo %lld\n", quantidade, lote->custos[lote->ordem[0]], lote->custos[lote->ordem[quantidade - 1]]);
+    }
+    
+    if(elite == 1) {
+        copiar_solucao(p->tamanho, lote->solucoes + (size_t) lote->ordem[0] * (p->tamanho + 1), solucao);
+        
+        return lote->custos[lote->ordem[0]];
+    }
+    
+    candidata = criar_solucao(p, NULL);
+    
+    for(int e = 0; e < elite; e++) {
+        definir_solucao(p, candidata, lote->solucoes + (size_t) lote->ordem[e] * (p->tamanho + 1), lote->custos[lote->ordem[e]]);
+        custo = vnd(s, s->opcoes.vizinhancas, candidata, candidata);
+        
+        if(custo < melhor) {
+            melhor = custo;
+            copiar_solucao(p->tamanho, candidata->elementos, solucao);
+        }
+    }
+    
+    liberar_solucao(candidata);
+    
+    return melhor;
+}
+
+/*
+ * Function: liberar_lote
+ * -----------------------------------------------------------------------------
+ *   Libera a área de trabalho da construção em lote.
+ *
+ *   lote: área de trabalho que será liberada.
+ */
+void liberar_lote(struct lote_construcao* lote) {
+    free(lote->solucoes);
+    free(lote->inseridos);
+    free(lote->estados);
+    free(lote->custos);
+    free(lote->ordem);
+    free(lote->vizinhos);
+    free(lote->linhas);
+    free(lote);
+}
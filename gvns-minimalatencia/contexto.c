@@ -0,0 +1,263 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "interno.h"
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções do contexto pré-processado da instância.
+// * -----------------------------------------------------------------------------
+
+/*
+ * Function: preparar_contexto
+ * -----------------------------------------------------------------------------
+ *   Constrói o contexto pré-processado da instância: para cada linha i da
+ *   matriz, os elementos ordenados pela distância a partir de i (a lista de
+ *   candidatos utilizada pela construção) e um limite inferior para o custo
+ *   da solução. O contexto depende apenas da instância, é construído uma
+ *   única vez e compartilhado, somente leitura, por todos os solucionadores e
+ *   threads.
+ *
+ *   Quando um arquivo é informado, o contexto gravado nele é reaproveitado se
+ *   a assinatura do conteúdo da instância coincidir; caso contrário o
+ *   contexto é construído e gravado no arquivo.
+ *
+ *   Instâncias sem matriz de adjacência (mais de TAMANHO_MAXIMO_MATRIZ
+ *   elementos) não recebem contexto, pois as listas ocupariam n^2 posições.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   arquivo: arquivo de persistência do contexto (NULL para não persistir).
+ *
+ *   returns: 0 em caso de sucesso ou ERRO_MEMORIA, com p->contexto nulo.
+ */
+int preparar_contexto(struct problema* p, char* arquivo) {
+    struct contexto* c;
+    
+    if(p->contexto || !p->elementos) {
+        return 0;
+    }
+    
+    c = malloc(sizeof(struct contexto));
+    
+    if(!c) {
+        return ERRO_MEMORIA;
+    }
+    
+    c->tamanho = p->tamanho;
+    c->assinatura = calcular_assinatura(p);
+    c->vizinhos = alocar_memoria((size_t) p->tamanho * p->tamanho * sizeof(int), p->paginas_grandes);
+    
+    if(!c->vizinhos) {
+        free(c);
+        return ERRO_MEMORIA;
+    }
+    
+    if(!arquivo || !carregar_contexto(c, arquivo)) {
+        if(construir_contexto(p, c)) {
+            liberar_contexto(c);
+            return ERRO_MEMORIA;
+        }
+        
+        if(arquivo && !gravar_contexto(c, arquivo)) {
+            printf("Não foi possível gravar o contexto em %s\n", arquivo);
+        }
+    }
+    
+    p->contexto = c;
+    
+    return 0;
+}
+
+/*
+ * Function: comparar_vizinhos
+ * -----------------------------------------------------------------------------
+ *   Ordena os vizinhos pela distância e, em caso de empate, pelo índice.
+ */
+static int comparar_vizinhos(const void* a, const void* b) {
+    const struct nodo* x = a;
+    const struct nodo* y = b;
+    
+    if(x->valor != y->valor) {
+        return x->valor < y->valor ? -1 : 1;
+    }
+    
+    return x->indice - y->indice;
+}
+
+/*
+ * Function: construir_contexto
+ * -----------------------------------------------------------------------------
+ *   Calcula as listas de vizinhos ordenados e o limite inferior do contexto.
+ *
+ *   O limite inferior parte de que cada elemento é a origem de exatamente um
+ *   arco da solução e esse arco custa no mínimo a menor distância a partir do
+ *   elemento. Pela desigualdade do rearranjo, a menor soma ponderada possível
+ *   atribui os maiores pesos (p->tamanho - posição) às menores distâncias
+ *   mínimas.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   c: contexto que será preenchido.
+ *
+ *   returns: 0 em caso de sucesso ou ERRO_MEMORIA.
+ */
+int construir_contexto(struct problema* p, struct contexto* c) {
+    struct nodo* linha = malloc(p->tamanho * sizeof(struct nodo));
+    struct nodo* minimos = malloc(p->tamanho * sizeof(struct nodo));
+    
+    if(!linha || !minimos) {
+        free(linha);
+        free(minimos);
+        return ERRO_MEMORIA;
+    }
+    
+    for(int i = 0; i < p->tamanho; i++) {
+        for(int j = 0; j < p->tamanho; j++) {
+            linha[j].indice = j;
+            linha[j].valor = distancia(p, i, j);
+        }
+        
+        qsort(linha, p->tamanho, sizeof(struct nodo), comparar_vizinhos);
+        
+        //o primeiro vizinho diferente do próprio elemento é o mais próximo
+        minimos[i].indice = i;
+        minimos[i].valor = linha[linha[0].indice == i && p->tamanho > 1 ? 1 : 0].valor;
+        
+        for(int j = 0; j < p->tamanho; j++) {
+            c->vizinhos[(size_t) i * p->tamanho + j] = linha[j].indice;
+        }
+    }
+    
+    qsort(minimos, p->tamanho, sizeof(struct nodo), comparar_vizinhos);
+    
+    c->limite_inferior = 0;
+    for(int i = 0; i < p->tamanho; i++) {
+        c->limite_inferior += (long long) minimos[i].valor * (p->tamanho - i);
+    }
+    
+    free(linha);
+    free(minimos);
+    
+    return 0;
+}
+
+/*
+ * Function: calcular_assinatura
+ * -----------------------------------------------------------------------------
+ *   Calcula a assinatura (FNV-1a de 64 bits) do conteúdo da instância: o
+ *   tamanho e todas as distâncias. Utilizada para validar o contexto
+ *   persistido, de forma que um contexto gravado para outra versão do
+ *   arquivo nunca seja reaproveitado.
+ *
+ *   p: estrutura de dados representando o problema.
+ *
+ *   returns: a assinatura calculada.
+ */
+unsigned long long calcular_assinatura(struct problema* p) {
+    unsigned long long h = 0xcbf29ce484222325ULL;
+    int d;
+    
+    h = (h ^ (unsigned int) p->tamanho) * 0x100000001b3ULL;
+    
+    for(int i = 0; i < p->tamanho; i++) {
+        for(int j = 0; j < p->tamanho; j++) {
+            d = distancia(p, i, j);
+            h = (h ^ (unsigned int) d) * 0x100000001b3ULL;
+        }
+    }
+    
+    return h;
+}
+
+/*
+ * Function: carregar_contexto
+ * -----------------------------------------------------------------------------
+ *   Lê o contexto persistido, caso o arquivo exista e tenha sido gravado para
+ *   uma instância com o mesmo tamanho e a mesma assinatura.
+ *
+ *   c: contexto com o tamanho e a assinatura da instância atual.
+ *   arquivo: arquivo de persistência.
+ *
+ *   returns: TRUE caso o contexto tenha sido lido.
+ */
+int carregar_contexto(struct contexto* c, char* arquivo) {
+    FILE* fp;
+    char assinatura[sizeof(CONTEXTO_ASSINATURA)];
+    int tamanho;
+    unsigned long long assinatura_instancia;
+    size_t elementos = (size_t) c->tamanho * c->tamanho;
+    int valido;
+    
+    fp = fopen(arquivo, "rb");
+    if(!fp) {
+        return FALSE;
+    }
+    
+    valido = fread(assinatura, sizeof(assinatura), 1, fp) == 1
+        && memcmp(assinatura, CONTEXTO_ASSINATURA, sizeof(assinatura)) == 0
+        && fread(&tamanho, sizeof(int), 1, fp) == 1
+        && fread(&assinatura_instancia, sizeof(unsigned long long), 1, fp) == 1
+        && tamanho == c->tamanho && assinatura_instancia == c->assinatura
+        && fread(&c->limite_inferior, sizeof(long long), 1, fp) == 1
+        && fread(c->vizinhos, sizeof(int), elementos, fp) == elementos;
+    
+    fclose(fp);
+    
+    return valido;
+}
+
+/*
+ * Function: gravar_contexto
+ * -----------------------------------------------------------------------------
+ *   Grava o contexto em um arquivo temporário que substitui o arquivo de
+ *   persistência apenas ao término da escrita.
+ *
+ *   c: contexto que será gravado.
+ *   arquivo: arquivo de persistência.
+ *
+ *   returns: TRUE caso o contexto tenha sido gravado.
+ */
+int gravar_contexto(struct contexto* c, char* arquivo) {
+    FILE* fp;
+    char* temporario;
+    size_t elementos = (size_t) c->tamanho * c->tamanho;
+    int sucesso;
+    
+    temporario = malloc(strlen(arquivo) + strlen(".tmp") + 1);
+    sprintf(temporario, "%s.tmp", arquivo);
+    
+    fp = fopen(temporario, "wb");
+    if(!fp) {
+        free(temporario);
+        return FALSE;
+    }
+    
+    fwrite(CONTEXTO_ASSINATURA, sizeof(CONTEXTO_ASSINATURA), 1, fp);
+    fwrite(&c->tamanho, sizeof(int), 1, fp);
+    fwrite(&c->assinatura, sizeof(unsigned long long), 1, fp);
+    fwrite(&c->limite_inferior, sizeof(long long), 1, fp);
+    
+    sucesso = fwrite(c->vizinhos, sizeof(int), elementos, fp) == elementos;
+    sucesso = fclose(fp) == 0 && sucesso;
+    sucesso = sucesso && rename(temporario, arquivo) == 0;
+    
+    if(!sucesso) {
+        unlink(temporario);
+    }
+    
+    free(temporario);
+    
+    return sucesso;
+}
+
+/*
+ * Function: liberar_contexto
+ * -----------------------------------------------------------------------------
+ *   Libera a memória alocada para o contexto.
+ *
+ *   c: contexto que será liberado.
+ */
+void liberar_contexto(struct contexto* c) {
+    liberar_memoria(c->vizinhos);
+    free(c);
+}
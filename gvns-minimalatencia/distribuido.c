@@ -0,0 +1,707 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include <errno.h>
+#include <signal.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+#include "modos.h"
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções do modo distribuído (coordenador e trabalhadores).
+// *
+// * O coordenador distribui as execuções entre os trabalhadores conectados ao
+// * seu socket e repassa a melhor solução conhecida. O protocolo é composto
+// * por linhas de texto, com as soluções representadas pelos p->tamanho + 1
+// * elementos separados por espaço:
+// *
+// *   coordenador -> trabalhador:
+// *   EXECUCAO <i>                      realizar a execução i (semente i)
+// *   INCUMBENTE <custo> <solucao>      melhor solução conhecida
+// *   RECUSADO                          instância ou parâmetros diferentes
+// *   FIM                               não há mais execuções
+// *
+// *   trabalhador -> coordenador:
+// *   OLA <assinatura> <parametros>     identificação (ver descrever_configuracao)
+// *   INCUMBENTE <custo> <solucao>      melhora encontrada durante a execução
+// *   RESULTADO <i> <custo> <tempo> <solucao>
+// *
+// * O coordenador só atribui execuções a um trabalhador após receber uma
+// * identificação igual à sua, e descarta as linhas cuja solução não é uma
+// * rota válida.
+// * -----------------------------------------------------------------------------
+
+/*
+ * Function: conectar_socket
+ * -----------------------------------------------------------------------------
+ *   Cria um socket de domínio Unix e o associa ao caminho informado: como
+ *   servidor (ouvindo conexões) ou como cliente (conectado ao servidor).
+ *
+ *   caminho: caminho do socket no sistema de arquivos.
+ *   servidor: TRUE para ouvir conexões no caminho.
+ *
+ *   returns: o descritor do socket ou -1 em caso de erro.
+ */
+int conectar_socket(char* caminho, int servidor) {
+    struct sockaddr_un endereco;
+    int fd;
+    
+    if(strlen(caminho) >= sizeof(endereco.sun_path)) {
+        return -1;
+    }
+    
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(fd < 0) {
+        return -1;
+    }
+    
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    strcpy(endereco.sun_path, caminho);
+    
+    if(servidor) {
+        unlink(caminho);
+        
+        if(bind(fd, (struct sockaddr*) &endereco, sizeof(endereco)) < 0 || listen(fd, 64) < 0) {
+            close(fd);
+            return -1;
+        }
+    } else if(connect(fd, (struct sockaddr*) &endereco, sizeof(endereco)) < 0) {
+        close(fd);
+        return -1;
+    }
+    
+    return fd;
+}
+
+/*
+ * Function: iniciar_conexao
+ * -----------------------------------------------------------------------------
+ *   Inicializa o buffer de leitura de uma conexão.
+ *
+ *   c: conexão que será inicializada.
+ *   fd: descritor do socket.
+ */
+void iniciar_conexao(struct conexao* c, int fd) {
+    c->fd = fd;
+    c->tamanho = 0;
+    c->capacidade = 4096;
+    c->buffer = malloc(c->capacidade);
+    c->execucao = -1;
+    c->identificada = FALSE;
+}
+
+/*
+ * Function: encerrar_conexao
+ * -----------------------------------------------------------------------------
+ *   Fecha o socket e libera o buffer de uma conexão.
+ *
+ *   c: conexão que será encerrada.
+ */
+void encerrar_conexao(struct conexao* c) {
+    if(c->fd >= 0) {
+        close(c->fd);
+    }
+    
+    free(c->buffer);
+    c->buffer = NULL;
+    c->fd = -1;
+}
+
+/*
+ * Function: receber_linha
+ * -----------------------------------------------------------------------------
+ *   Retorna a próxima linha recebida pela conexão, sem o caractere de fim de
+ *   linha. A linha permanece válida até a próxima chamada.
+ *
+ *   c: conexão.
+ *   bloquear: TRUE aguarda a chegada de uma linha completa; FALSE retorna
+ *   imediatamente quando não há uma linha completa disponível.
+ *   linha: recebe o início da linha.
+ *
+ *   returns: 1 quando uma linha foi recebida, 0 quando não há linha
+ *   disponível (apenas sem bloquear) e -1 quando a conexão foi encerrada.
+ */
+int receber_linha(struct conexao* c, int bloquear, char** linha) {
+    char* fim;
+    ssize_t lidos;
+    
+    //descartando a linha retornada na chamada anterior
+    if(c->tamanho > 0 && (fim = memchr(c->buffer, '\0', c->tamanho))) {
+        size_t consumidos = fim - c->buffer + 1;
+        
+        memmove(c->buffer, c->buffer + consumidos, c->tamanho - consumidos);
+        c->tamanho -= consumidos;
+    }
+    
+    while(TRUE) {
+        fim = memchr(c->buffer, '\n', c->tamanho);
+        
+        if(fim) {
+            *fim = '\0';
+            *linha = c->buffer;
+            return 1;
+        }
+        
+        if(c->tamanho == c->capacidade) {
+            c->capacidade *= 2;
+            c->buffer = realloc(c->buffer, c->capacidade);
+        }
+        
+        //a leitura bloqueante também atende conexões que não são sockets (entrada padrão)
+        if(bloquear) {
+            lidos = read(c->fd, c->buffer + c->tamanho, c->capacidade - c->tamanho);
+        } else {
+            lidos = recv(c->fd, c->buffer + c->tamanho, c->capacidade - c->tamanho, MSG_DONTWAIT);
+        }
+        
+        if(lidos > 0) {
+            c->tamanho += lidos;
+        } else if(lidos < 0 && errno == EINTR) {
+            continue;
+        } else if(lidos < 0 && !bloquear && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return 0;
+        } else {
+            return -1;
+        }
+    }
+}
+
+/*
+ * Function: enviar_mensagem
+ * -----------------------------------------------------------------------------
+ *   Envia uma linha do protocolo composta pelo cabeçalho informado seguido,
+ *   opcionalmente, de uma solução.
+ *
+ *   fd: descritor do socket.
+ *   cabecalho: início da linha (por exemplo "INCUMBENTE 1234").
+ *   tamanho: tamanho do problema.
+ *   solucao: solução enviada após o cabeçalho (NULL para nenhuma).
+ *
+ *   returns: TRUE caso a linha tenha sido enviada por completo.
+ */
+int enviar_mensagem(int fd, char* cabecalho, int tamanho, int* solucao) {
+    size_t capacidade = strlen(cabecalho) + (solucao ? (size_t) (tamanho + 1) * 12 : 0) + 2;
+    char* linha = malloc(capacidade);
+    size_t usados = strlen(cabecalho);
+    size_t enviados = 0;
+    ssize_t escritos;
+    
+    memcpy(linha, cabecalho, usados);
+    
+    for(int i = 0; solucao && i <= tamanho; i++) {
+        usados += sprintf(linha + usados, " %d", solucao[i]);
+    }
+    
+    linha[usados++] = '\n';
+    
+    while(enviados < usados) {
+        escritos = send(fd, linha + enviados, usados - enviados, 0);
+        
+        if(escritos < 0 && errno == EINTR) {
+            continue;
+        }
+        
+        if(escritos <= 0) {
+            break;
+        }
+        
+        enviados += escritos;
+    }
+    
+    free(linha);
+    
+    return enviados == usados;
+}
+
+/*
+ * Function: ler_solucao_mensagem
+ * -----------------------------------------------------------------------------
+ *   Lê os p->tamanho + 1 elementos de uma solução a partir da posição
+ *   informada de uma linha do protocolo e verifica se eles formam uma rota:
+ *   a origem no início e no fim e cada um dos demais elementos exatamente
+ *   uma vez.
+ *
+ *   texto: posição da linha onde a solução começa.
+ *   tamanho: tamanho do problema.
+ *   solucao: solução lida.
+ *
+ *   returns: TRUE caso a linha contenha exatamente uma rota válida.
+ */
+int ler_solucao_mensagem(char* texto, int tamanho, int* solucao) {
+    char* visitados = calloc(tamanho, sizeof(char));
+    char* fim;
+    long valor;
+    int valida = visitados != NULL;
+    
+    for(int i = 0; i <= tamanho && valida; i++) {
+        valor = strtol(texto, &fim, 10);
+        valida = fim != texto && valor >= 0 && valor < tamanho;
+        
+        if(valida && i > 0 && i < tamanho) {
+            valida = valor != 0 && !visitados[valor];
+            visitados[valor] = TRUE;
+        }
+        
+        solucao[i] = (int) valor;
+        texto = fim;
+    }
+    
+    while(valida && *texto == ' ') {
+        texto++;
+    }
+    
+    valida = valida && *texto == '\0' && solucao[0] == 0 && solucao[tamanho] == 0;
+    
+    free(visitados);
+    
+    return valida;
+}
+
+/*
+ * Function: descrever_configuracao
+ * -----------------------------------------------------------------------------
+ *   Monta a mensagem de identificação do trabalhador: a assinatura da
+ *   instância (ver calcular_assinatura) e os parâmetros que alteram o
+ *   resultado das execuções. O coordenador a compara com a sua própria, de
+ *   forma que um trabalhador iniciado com outra instância ou outros
+ *   parâmetros seja recusado.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   opcoes: opções de execução do método.
+ *   destino: recebe a mensagem (DISTRIBUIDO_CONFIGURACAO posições).
+ */
+void descrever_configuracao(struct problema* p, struct opcoes* opcoes, char* destino) {
+    unsigned long long assinatura = p->contexto ? p->contexto->assinatura : calcular_assinatura(p);
+    
+    snprintf(destino, DISTRIBUIDO_CONFIGURACAO, "OLA %016llx %d %d %d %d %d %d %d %d %lld %.3f", assinatura,
+             opcoes->iteracoes, opcoes->vizinhancas, opcoes->construcao_aleatoria, opcoes->busca_localizada,
+             opcoes->varredura_unificada, opcoes->construcoes, opcoes->elite, opcoes->solucao_inicial != NULL,
+             opcoes->alvo, opcoes->tempo_maximo);
+}
+
+/*
+ * Function: aguardar_trabalhadores
+ * -----------------------------------------------------------------------------
+ *   Recolhe, sem bloquear, os trabalhadores locais já encerrados.
+ *
+ *   processos: identificadores dos trabalhadores locais; os encerrados são
+ *   marcados com 0.
+ *   quantidade: quantidade de trabalhadores locais.
+ *
+ *   returns: a quantidade de trabalhadores locais ainda em execução.
+ */
+int aguardar_trabalhadores(pid_t* processos, int quantidade) {
+    int ativos = 0;
+    
+    for(int k = 0; k < quantidade; k++) {
+        if(processos[k] > 0 && waitpid(processos[k], NULL, WNOHANG) == processos[k]) {
+            processos[k] = 0;
+        }
+        
+        ativos += processos[k] > 0;
+    }
+    
+    return ativos;
+}
+
+/*
+ * Function: atribuir_execucao
+ * -----------------------------------------------------------------------------
+ *   Envia ao trabalhador a próxima execução pendente, acompanhada da melhor
+ *   solução conhecida, ou FIM quando todas as execuções foram atribuídas.
+ *
+ *   d: estado do coordenador.
+ *   c: conexão do trabalhador.
+ */
+void atribuir_execucao(struct coordenador* d, struct conexao* c) {
+    char cabecalho[64];
+    
+    if(d->quantidade_pendentes > 0) {
+        c->execucao = d->pendentes[--d->quantidade_pendentes];
+    } else if(d->proxima < d->execucoes) {
+        c->execucao = d->proxima++;
+    } else {
+        c->execucao = -1;
+        enviar_mensagem(c->fd, "FIM", d->tamanho, NULL);
+        return;
+    }
+    
+    sprintf(cabecalho, "EXECUCAO %d", c->execucao);
+    enviar_mensagem(c->fd, cabecalho, d->tamanho, NULL);
+    
+    if(d->compartilhar && d->custo_melhor < LLONG_MAX) {
+        sprintf(cabecalho, "INCUMBENTE %lld", d->custo_melhor);
+        enviar_mensagem(c->fd, cabecalho, d->tamanho, d->melhor);
+    }
+}
+
+/*
+ * Function: tratar_mensagem_coordenador
+ * -----------------------------------------------------------------------------
+ *   Trata uma linha recebida de um trabalhador. A identificação é comparada
+ *   com a do coordenador: o trabalhador recebe a primeira execução ou é
+ *   recusado. Uma melhora da solução incumbente global é repassada aos
+ *   demais trabalhadores em execução; um resultado é registrado e o
+ *   trabalhador recebe a próxima execução. Um resultado inválido encerra a
+ *   conexão e a execução volta para a fila.
+ *
+ *   d: estado do coordenador.
+ *   c: conexão do trabalhador.
+ *   linha: linha recebida.
+ */
+void tratar_mensagem_coordenador(struct coordenador* d, struct conexao* c, char* linha) {
+    char cabecalho[64];
+    long long custo;
+    double tempo;
+    int execucao;
+    int lidos;
+    
+    if(!c->identificada) {
+        if(strcmp(linha, d->configuracao) == 0) {
+            c->identificada = TRUE;
+            atribuir_execucao(d, c);
+        } else {
+            enviar_mensagem(c->fd, "RECUSADO", d->tamanho, NULL);
+            encerrar_conexao(c);
+        }
+    } else if(sscanf(linha, "INCUMBENTE %lld%n", &custo, &lidos) == 1) {
+        if(custo < d->custo_melhor && ler_solucao_mensagem(linha + lidos, d->tamanho, d->solucao_tmp)) {
+            d->custo_melhor = custo;
+            copiar_solucao(d->tamanho, d->solucao_tmp, d->melhor);
+            
+            for(int k = 0; d->compartilhar && k < d->quantidade_conexoes; k++) {
+                if(&d->conexoes[k] != c && d->conexoes[k].fd >= 0 && d->conexoes[k].execucao >= 0) {
+                    sprintf(cabecalho, "INCUMBENTE %lld", custo);
+                    enviar_mensagem(d->conexoes[k].fd, cabecalho, d->tamanho, d->melhor);
+                }
+            }
+        }
+    } else if(sscanf(linha, "RESULTADO %d %lld %lf%n", &execucao, &custo, &tempo, &lidos) == 3) {
+        if(execucao != c->execucao || !ler_solucao_mensagem(linha + lidos, d->tamanho, d->solucao_tmp)) {
+            if(c->execucao >= 0 && !d->informacoes[c->execucao].solucao) {
+                d->pendentes[d->quantidade_pendentes++] = c->execucao;
+            }
+            
+            c->execucao = -1;
+            encerrar_conexao(c);
+            return;
+        }
+        
+        if(!d->informacoes[execucao].solucao) {
+            d->informacoes[execucao].valor_encontrado = custo;
+            d->informacoes[execucao].tempo = tempo;
+            d->informacoes[execucao].solucao = inicializar_solucao(d->tamanho, NULL);
+            copiar_solucao(d->tamanho, d->solucao_tmp, d->informacoes[execucao].solucao);
+            d->concluidas++;
+            
+            if(custo < d->custo_melhor) {
+                d->custo_melhor = custo;
+                copiar_solucao(d->tamanho, d->informacoes[execucao].solucao, d->melhor);
+            }
+        }
+        
+        atribuir_execucao(d, c);
+    }
+}
+
+/*
+ * Function: executar_coordenador
+ * -----------------------------------------------------------------------------
+ *   Coordena a realização das execuções por processos trabalhadores que se
+ *   conectam ao socket informado. Opcionalmente, inicia ele mesmo processos
+ *   trabalhadores locais. As execuções de trabalhadores que se desconectam
+ *   antes de concluí-las são atribuídas novamente. Quando todos os
+ *   trabalhadores locais foram encerrados e não há trabalhadores conectados,
+ *   as execuções pendentes não podem ser concluídas e o coordenador termina
+ *   com erro.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   opcoes: opções de execução utilizadas pelos trabalhadores locais.
+ *   caminho: caminho do socket de domínio Unix.
+ *   processos: quantidade de trabalhadores locais iniciados.
+ *   execucoes: quantidade de execuções.
+ *   compartilhar: TRUE repassa aos trabalhadores a melhor solução conhecida.
+ *   informacoes: recebe o resultado de cada execução.
+ *
+ *   returns: TRUE caso todas as execuções tenham sido concluídas.
+ */
+int executar_coordenador(struct problema* p, struct opcoes* opcoes, char* caminho, int processos, int execucoes, int compartilhar, struct informacao_execucao* informacoes) {
+    struct coordenador d;
+    struct pollfd* eventos;
+    pid_t* trabalhadores;
+    int servidor;
+    int fd;
+    char* linha;
+    int estado;
+    
+    signal(SIGPIPE, SIG_IGN);
+    
+    servidor = conectar_socket(caminho, TRUE);
+    if(servidor < 0) {
+        printf("Não foi possível criar o socket %s\n", caminho);
+        return FALSE;
+    }
+    
+    memset(&d, 0, sizeof(d));
+    d.tamanho = p->tamanho;
+    d.execucoes = execucoes;
+    d.compartilhar = compartilhar;
+    d.informacoes = informacoes;
+    d.custo_melhor = LLONG_MAX;
+    d.melhor = inicializar_solucao(p->tamanho, NULL);
+    d.solucao_tmp = inicializar_solucao(p->tamanho, NULL);
+    d.pendentes = malloc(execucoes * sizeof(int));
+    d.capacidade_conexoes = 16;
+    d.conexoes = malloc(d.capacidade_conexoes * sizeof(struct conexao));
+    descrever_configuracao(p, opcoes, d.configuracao);
+    
+    for(int i = 0; i < execucoes; i++) {
+        informacoes[i].solucao = NULL;
+    }
+    
+    //sem esvaziar os buffers, cada processo filho imprimiria novamente a saída pendente
+    fflush(stdout);
+    fflush(stderr);
+    
+    //os trabalhadores locais herdam o problema já lido
+    trabalhadores = malloc((processos > 0 ? processos : 1) * sizeof(pid_t));
+    
+    for(int k = 0; k < processos; k++) {
+        trabalhadores[k] = fork();
+        
+        if(trabalhadores[k] == 0) {
+            close(servidor);
+            _exit(executar_trabalhador(p, opcoes, caminho) ? 0 : 1);
+        }
+    }
+    
+    eventos = malloc((d.capacidade_conexoes + 1) * sizeof(struct pollfd));
+    
+    while(d.concluidas < execucoes) {
+        if(processos > 0 && d.quantidade_conexoes == 0 && aguardar_trabalhadores(trabalhadores, processos) == 0) {
+            printf("Os trabalhadores foram encerrados com %d execuções pendentes\n", execucoes - d.concluidas);
+            break;
+        }
+        
+        eventos[0].fd = servidor;
+        eventos[0].events = POLLIN;
+        
+        for(int k = 0; k < d.quantidade_conexoes; k++) {
+            eventos[k + 1].fd = d.conexoes[k].fd;
+            eventos[k + 1].events = POLLIN;
+        }
+        
+        //o tempo limite permite detectar os trabalhadores locais encerrados antes de se conectar
+        if(poll(eventos, d.quantidade_conexoes + 1, processos > 0 ? DISTRIBUIDO_INTERVALO_VERIFICACAO : -1) < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        
+        for(int k = 0; k < d.quantidade_conexoes; k++) {
+            if(!eventos[k + 1].revents || d.conexoes[k].fd < 0) {
+                continue;
+            }
+            
+            //a conexão é encerrada ao tratar uma mensagem inválida
+            while(d.conexoes[k].fd >= 0 && (estado = receber_linha(&d.conexoes[k], FALSE, &linha)) == 1) {
+                tratar_mensagem_coordenador(&d, &d.conexoes[k], linha);
+            }
+            
+            if(d.conexoes[k].fd >= 0 && estado < 0) {
+                //a execução em andamento volta para a fila
+                if(d.conexoes[k].execucao >= 0 && !informacoes[d.conexoes[k].execucao].solucao) {
+                    d.pendentes[d.quantidade_pendentes++] = d.conexoes[k].execucao;
+                }
+                
+                encerrar_conexao(&d.conexoes[k]);
+            }
+        }
+        
+        if(eventos[0].revents & POLLIN) {
+            fd = accept(servidor, NULL, NULL);
+            
+            if(fd >= 0) {
+                if(d.quantidade_conexoes == d.capacidade_conexoes) {
+                    d.capacidade_conexoes *= 2;
+                    d.conexoes = realloc(d.conexoes, d.capacidade_conexoes * sizeof(struct conexao));
+                    eventos = realloc(eventos, (d.capacidade_conexoes + 1) * sizeof(struct pollfd));
+                }
+                
+                //a primeira execução é atribuída após a identificação do trabalhador
+                iniciar_conexao(&d.conexoes[d.quantidade_conexoes], fd);
+                d.quantidade_conexoes++;
+            }
+        }
+        
+        //removendo as conexões encerradas
+        for(int k = d.quantidade_conexoes - 1; k >= 0; k--) {
+            if(d.conexoes[k].fd < 0) {
+                d.conexoes[k] = d.conexoes[--d.quantidade_conexoes];
+            }
+        }
+    }
+    
+    for(int k = 0; k < d.quantidade_conexoes; k++) {
+        encerrar_conexao(&d.conexoes[k]);
+    }
+    
+
+    for(int k = 0; k < processos; k++) {
+        if(trabalhadores[k] > 0) {
+            waitpid(trabalhadores[k], NULL, 0);
+        }
+    }
+    
+    close(servidor);
+    unlink(caminho);
+    
+    free(eventos);
+    free(trabalhadores);
+    free(d.conexoes);
+    free(d.pendentes);
+    free(d.melhor);
+    free(d.solucao_tmp);
+    
+    return d.concluidas == execucoes;
+}
+
+/*
+ * Function: enviar_incumbente
+ * -----------------------------------------------------------------------------
+ *   Função ao_melhorar dos trabalhadores: envia ao coordenador cada melhora
+ *   da solução incumbente da execução.
+ */
+void enviar_incumbente(long long custo, int* solucao, int tamanho, void* dados) {
+    struct trabalhador* t = dados;
+    char cabecalho[64];
+    
+    sprintf(cabecalho, "INCUMBENTE %lld", custo);
+    enviar_mensagem(t->conexao.fd, cabecalho, tamanho, solucao);
+}
+
+/*
+ * Function: receber_incumbente
+ * -----------------------------------------------------------------------------
+ *   Função receber_incumbente dos trabalhadores: verifica, sem bloquear, se o
+ *   coordenador enviou uma solução melhor que a última repassada à busca.
+ *
+ *   solucao: recebe a solução enviada pelo coordenador.
+ *   custo: recebe o custo da solução.
+ *   dados: trabalhador (struct trabalhador).
+ *
+ *   returns: TRUE caso uma nova solução tenha sido recebida.
+ */
+int receber_incumbente(int* solucao, long long* custo, void* dados) {
+    struct trabalhador* t = dados;
+    char* linha;
+    int lidos;
+    
+    while(receber_linha(&t->conexao, FALSE, &linha) == 1) {
+        if(sscanf(linha, "INCUMBENTE %lld%n", &t->custo_recebido, &lidos) == 1) {
+            t->recebida = ler_solucao_mensagem(linha + lidos, t->tamanho, t->solucao_recebida);
+        }
+    }
+    
+    if(!t->recebida) {
+        return FALSE;
+    }
+    
+    t->recebida = FALSE;
+    copiar_solucao(t->tamanho, t->solucao_recebida, solucao);
+    *custo = t->custo_recebido;
+    
+    return TRUE;
+}
+
+/*
+ * Function: executar_trabalhador
+ * -----------------------------------------------------------------------------
+ *   Conecta-se ao coordenador, identifica-se (ver descrever_configuracao) e
+ *   realiza as execuções atribuídas por ele até receber FIM. Cada melhora é
+ *   enviada ao coordenador e as soluções recebidas dele são adotadas pela
+ *   busca quando melhores que a incumbente.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   opcoes: opções de execução do método.
+ *   caminho: caminho do socket do coordenador.
+ *
+ *   returns: TRUE caso o trabalhador tenha terminado ao receber FIM.
+ */
+int executar_trabalhador(struct problema* p, struct opcoes* opcoes, char* caminho) {
+    struct trabalhador t;
+    struct opcoes opcoes_trabalhador = *opcoes;
+    struct solucionador* s;
+    int* solucao;
+    char cabecalho[DISTRIBUIDO_CONFIGURACAO];
+    char* linha;
+    int execucao;
+    int lidos;
+    int fd;
+    long long custo;
+    clock_t inicio;
+    int concluido = FALSE;
+    
+    signal(SIGPIPE, SIG_IGN);
+    
+    fd = conectar_socket(caminho, FALSE);
+    if(fd < 0) {
+        printf("Não foi possível conectar ao coordenador em %s\n", caminho);
+        return FALSE;
+    }
+    
+    memset(&t, 0, sizeof(t));
+    iniciar_conexao(&t.conexao, fd);
+    
+    descrever_configuracao(p, opcoes, cabecalho);
+    enviar_mensagem(fd, cabecalho, p->tamanho, NULL);
+    t.tamanho = p->tamanho;
+    t.solucao_recebida = inicializar_solucao(p->tamanho, NULL);
+    
+    opcoes_trabalhador.checkpoint = NULL;
+    opcoes_trabalhador.ao_melhorar = enviar_incumbente;
+    opcoes_trabalhador.receber_incumbente = receber_incumbente;
+    opcoes_trabalhador.dados = &t;
+    
+    s = criar_solucionador(p, &opcoes_trabalhador);
+    solucao = inicializar_solucao(p->tamanho, NULL);
+    
+    while(receber_linha(&t.conexao, TRUE, &linha) == 1) {
+        if(strcmp(linha, "FIM") == 0) {
+            concluido = TRUE;
+            break;
+        }
+        
+        if(strcmp(linha, "RECUSADO") == 0) {
+            printf("O coordenador em %s utiliza outra instância ou outros parâmetros\n", caminho);
+            break;
+        }
+        
+        if(sscanf(linha, "INCUMBENTE %lld%n", &t.custo_recebido, &lidos) == 1) {
+            t.recebida = ler_solucao_mensagem(linha + lidos, t.tamanho, t.solucao_recebida);
+        } else if(sscanf(linha, "EXECUCAO %d", &execucao) == 1) {
+            inicio = clock();
+            custo = executar_gvns(s, execucao, solucao);
+            
+            sprintf(cabecalho, "RESULTADO %d %lld %f", execucao, custo, (double)(clock() - inicio) / CLOCKS_PER_SEC);
+            if(!enviar_mensagem(fd, cabecalho, p->tamanho, solucao)) {
+                break;
+            }
+        }
+    }
+    
+    liberar_solucionador(s);
+    encerrar_conexao(&t.conexao);
+    free(t.solucao_recebida);
+    free(solucao);
+    
+    return concluido;
+}
@@ -0,0 +1,2013 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <limits.h>
+
+#include "interno.h"
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções da interface do solucionador.
+// * -----------------------------------------------------------------------------
+
+/*
+ * Function: inicializar_opcoes
+ * -----------------------------------------------------------------------------
+ *   Preenche as opções de execução com os valores padrão do método.
+ *
+ *   opcoes: opções que serão inicializadas.
+ */
+void inicializar_opcoes(struct opcoes* opcoes) {
+    memset(opcoes, 0, sizeof(struct opcoes));
+    
+    opcoes->iteracoes = 1000;
+    opcoes->vizinhancas = 5;
+    opcoes->construcao_aleatoria = TRUE;
+    opcoes->busca_localizada = FALSE;
+    opcoes->tabela_ganhos = TRUE;
+    opcoes->avaliacao_vetorial = TRUE;
+    opcoes->paginas_grandes = TRUE;
+}
+
+/*
+ * Function: criar_solucionador
+ * -----------------------------------------------------------------------------
+ *   Cria um solucionador para o problema informado. O problema é apenas
+ *   referenciado (a matriz, as coordenadas e o contexto não são copiados) e deve
+ *   permanecer válido enquanto o solucionador existir. Cada solucionador
+ *   possui o seu próprio gerador de números aleatórios e cache de distâncias,
+ *   podendo ser utilizado em uma thread sem sincronização, desde que não seja
+ *   compartilhado.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   opcoes: opções de execução do método.
+ *
+ *   returns: o solucionador alocado.
+ */
+struct solucionador* criar_solucionador(struct problema* p, struct opcoes* opcoes) {
+    struct solucionador* s = malloc(sizeof(struct solucionador));
+    
+    s->problema = *p;
+    s->problema.cache = NULL;
+    s->opcoes = *opcoes;
+    s->estado_aleatorio = 1;
+    s->inicio = 0;
+    s->rastro = NULL;
+    s->perfil = NULL;
+    s->lote = NULL;
+    s->corrotina = NULL;
+    s->ganhos = NULL;
+    s->vetorial = NULL;
+    s->execucao = 0;
+    
+    //o limite inferior do contexto, quando alcançado, prova que a solução é ótima
+    if(p->contexto && s->opcoes.alvo < p->contexto->limite_inferior) {
+        s->opcoes.alvo = p->contexto->limite_inferior;
+    }
+    
+    if(opcoes->linhas_cache > 0 && !p->elementos) {
+        inicializar_cache_distancias(&s->problema, opcoes->linhas_cache);
+    }
+    
+    return s;
+}
+
+/*
+ * Function: executar_gvns
+ * -----------------------------------------------------------------------------
+ *   Realiza uma execução completa do método: construção da solução inicial
+ *   seguida do GVNS. Ao retomar um checkpoint, a solução gravada é utilizada
+ *   no lugar da construção. Com opcoes.construcoes > 1, a solução inicial é a
+ *   melhor de um lote de construções (ver construir_melhor_solucao).
+ *
+ *   Com opcoes.solucao_inicial, a busca parte da solução informada (ver
+ *   preparar_reotimizacao) e, antes do GVNS, o VND é aplicado apenas à região
+ *   das opcoes.posicoes_afetadas.
+ *
+ *   s: solucionador com o problema e as opções de execução.
+ *   semente: semente do gerador de números aleatórios da execução.
+ *   solucao: melhor solução encontrada (p.tamanho + 1 posições).
+ *
+ *   returns: custo da melhor solução encontrada.
+ */
+long long executar_gvns(struct solucionador* s, unsigned long long semente, int* solucao) {
+    struct checkpoint* c = s->opcoes.checkpoint;
+    struct solucao* inicial;
+    long long custo;
+    
+    semear(s, semente);
+    s->inicio = relogio();
+    s->execucao = (int) semente;
+    
+    if(s->rastro) {
+        s->rastro->execucao = (int) semente;
+    }
+    
+    if(s->perfil) {
+        iniciar_execucao_perfil(s->perfil);
+    }
+    
+    RASTRO_INICIO(s, inicio_construcao);
+    PERFIL_ENTRAR(s, PERFIL_CONSTRUCAO);
+    
+    if(c && c->retomar) {
+        //a construção já havia sido realizada antes da interrupção
+        copiar_solucao(s->problema.tamanho, c->estado.solucao, solucao);
+    } else if(s->opcoes.solucao_inicial) {
+        copiar_solucao(s->problema.tamanho, s->opcoes.solucao_inicial, solucao);
+    } else if(s->opcoes.construcoes > 1) {
+        construir_melhor_solucao(s, s->opcoes.construcao_aleatoria ? 1 : 0.0001, s->opcoes.construcao_aleatoria ? 1 : 0.0001, solucao);
+    } else if(s->opcoes.construcao_aleatoria) {
+        construir_solucao(s, 1, 1, solucao);
+    } else {
+        construir_solucao(s, 0.0001, 0.0001, solucao);
+    }
+    
+    inicial = criar_solucao(&s->problema, solucao);
+    
+    PERFIL_SAIR(s);
+    RASTRO_EVENTO(s, RASTRO_CONSTRUCAO, inicio_construcao, -1, custo_solucao(&s->problema, inicial));
+    
+    //reparando a solução informada apenas onde a instância foi alterada
+    if(!(c && c->retomar) && s->opcoes.solucao_inicial && s->opcoes.quantidade_afetadas > 0) {
+        vnd_localizado(s, s->opcoes.vizinhancas, s->opcoes.posicoes_afetadas, s->opcoes.quantidade_afetadas, inicial, inicial);
+    }
+    
+    custo = gvns(s, s->opcoes.iteracoes, s->opcoes.vizinhancas, inicial, inicial);
+    
+    copiar_solucao(s->problema.tamanho, inicial->elementos, solucao);
+    liberar_solucao(inicial);
+    
+    if(s->perfil) {
+        concluir_execucao_perfil(s->perfil, s->execucao);
+    }
+    
+    return custo;
+}
+
+/*
+ * Function: liberar_solucionador
+ * -----------------------------------------------------------------------------
+ *   Libera a memória alocada para o solucionador. O problema referenciado não
+ *   é liberado.
+ *
+ *   s: solucionador que será liberado.
+ */
+void liberar_solucionador(struct solucionador* s) {
+    if(s->problema.cache) {
+        liberar_cache_distancias(s->problema.cache);
+    }
+    
+    if(s->lote) {
+        liberar_lote(s->lote);
+    }
+    
+    if(s->ganhos) {
+        liberar_tabela_ganhos(s->ganhos);
+    }
+    
+    if(s->vetorial) {
+        liberar_percurso_vetorial(s->vetorial);
+    }
+    
+    free(s);
+}
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções básicas para a implementação do método GVNS
+// * -----------------------------------------------------------------------------
+
+/*
+ * Function: calcular_custo
+ * -----------------------------------------------------------------------------
+ *   Calcula o custo de uma solução. Quando o problema possui um kernel
+ *   especializado (ver selecionar_kernel) o cálculo é delegado a ele.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   solucao: solução que terá o custo avaliado.
+ */
+long long calcular_custo(struct problema* p, int* solucao) {
+    long long custo = 0;
+    int i;
+    if(!solucao) {
+        printf("!!!!!!");
+    }
+    if(p->kernel) {
+        return p->kernel->custo(p, solucao);
+    }
+    for(i = 0; i < p->tamanho; i++) {
+        //as distâncias dos próximos arcos são trazidas da memória com antecedência
+        if(p->elementos && p->tamanho >= TAMANHO_MINIMO_ANTECIPACAO && i + ANTECIPACAO_CUSTO < p->tamanho) {
+            __builtin_prefetch(&p->elementos[solucao[i + ANTECIPACAO_CUSTO]][solucao[i + ANTECIPACAO_CUSTO + 1]]);
+        }
+        
+        custo += (long long) distancia(p, solucao[i], solucao[i + 1]) * (p->tamanho - i);
+    }
+    
+    return custo;
+}
+
+/*
+ * Function: construir_solucao
+ * -----------------------------------------------------------------------------
+ *   Constroi um solução viável para o problema. A construção pode ser gulosa
+ *   ou aleatória, dependendo dos parâmetros informados como percentual_inicial
+ *   e percentual_final.
+ *
+ *   s: solucionador com o problema e as opções de execução.
+ *   percentual_inicial: indica o percentual inicial de elementos que serão
+ *   analisados para a construção do caminho.
+ *   percentual_final: indica o percentual final de elementos que serão
+ *   analisados para a construção do caminho.
+ *   solucao: solucao gerada.
+ *
+ *   Quando o problema possui contexto pré-processado, os candidatos são lidos
+ *   das listas de vizinhos já ordenadas, no lugar de ordenar os vizinhos a
+ *   cada passo.
+ */
+void construir_solucao(struct solucionador* s, float percentual_inicial, float percentual_final, int* solucao) {
+    struct problema* p = &s->problema;
+    int iv, indice_selecionado, indice_selecionado2;
+    int *inserido;
+    struct nodo *vizinhos;
+    int numero_candidatos;
+    float taxa_crescimento, percentual_atual;
+    int* ordem;
+    
+    //estabelecendo o numero de candidatos a entrar no solucao
+    numero_candidatos = ceil(percentual_inicial * p->tamanho);
+    
+    taxa_crescimento = (percentual_final - percentual_inicial) / p->tamanho;
+    
+    percentual_atual = percentual_inicial + taxa_crescimento;
+    
+    //alocando memoria para o array que ira informar se um elemento
+    //ja foi inserido no solucao ou nao e inicializando os valores
+    inserido = malloc(p->tamanho * sizeof(int));
+    for(int i = 0; i < p->tamanho; i++) {
+        inserido[i] = FALSE;
+    }
+    
+    //alocando memoria para o array que irá armazenar informações sobre a vizinhança
+    //do elemento atual
+    vizinhos = (struct nodo*) malloc((p->tamanho) * sizeof(struct nodo));
+    
+    solucao[0] = 0;
+    inserido[0] = TRUE;
+    
+    for(int i = 0; i < p->tamanho; i++) {
+        //indice do vizinho atual;
+        iv = 0;
+        
+        if(p->contexto) {
+            //a lista já ordenada do contexto fornece os candidatos diretamente
+            ordem = p->contexto->vizinhos + (size_t) i * p->tamanho;
+            
+            for(int k = 0; k < p->tamanho && iv < numero_candidatos; k++) {
+                if(!inserido[ordem[k]]) {
+                    vizinhos[iv].indice = ordem[k];
+                    vizinhos[iv].valor = distancia(p, i, ordem[k]);
+                    
+                    iv++;
+                }
+            }
+        } else {
+            //construindo a lista de vizinhos e seus respectivos valores
+            for(int j = 0; j < p->tamanho; j++) {
+                //nao pode ser selecionado um elemento que ja esteja no solucao
+                if(!inserido[j]) {
+                    vizinhos[iv].indice = j;
+                    vizinhos[iv].valor = distancia(p, i, j);
+                    
+                    iv++;
+                }
+            }
+            
+            //ordenando a lista de vizinhos por custo da aresta
+            selection_sort(vizinhos, iv);
+        }
+        
+        if(iv == 0) {
+            solucao[i + 1] = 0;
+            //printf("Vertice inserido no solucao: %d\n", solucao[i + 1]);
+        } else {
+            //selecionando um elemento aleatorio para entrar no solucao
+            do {
+                if(numero_candidatos > iv) {
+                    indice_selecionado = aleatorio(s) % iv;
+                    indice_selecionado2 = aleatorio(s) % iv;
+                } else {
+                    indice_selecionado = aleatorio(s) % numero_candidatos;
+                    indice_selecionado2 = aleatorio(s) % numero_candidatos;
+                }
+                
+                if(!inserido[vizinhos[indice_selecionado2].indice] && vizinhos[indice_selecionado].valor > vizinhos[indice_selecionado2].valor) {
+                    indice_selecionado = indice_selecionado2;
+                }
+            } while(inserido[vizinhos[indice_selecionado].indice] == TRUE);
+            solucao[i + 1] = vizinhos[indice_selecionado].indice;
+            inserido[vizinhos[indice_selecionado].indice] = TRUE;
+            
+            //printf("Vertice inserido no solucao: %d\n", solucao[i + 1]);
+            
+            numero_candidatos = ceil(percentual_atual * p->tamanho);
+            percentual_atual += taxa_crescimento;
+            
+        }
+    }
+    
+    //liberando memoria alocada para os arrays
+    free(inserido);
+    free(vizinhos);
+}
+
+/*
+ * Function: encontrar_melhor_vizinho
+ * -----------------------------------------------------------------------------
+ *   Constroi um solução viável para o problema. A construção pode ser gulosa
+ *   ou aleatória, dependendo dos parâmetros informados como percentual_inicial
+ *   e percentual_final.
+ *
+ *   s: solucionador com o problema e as opções de execução.
+ *   solucao_inicial: solução inicial que terá a vizinhaça explorada.
+ *   vizinhanca: número da vizinhança que será avaliada.
+ *   regiao: posições às quais a exploração é restrita (NULL para toda a
+ *   solução).
+ *   solucao_resultado: melhor vizinho encontrado ao explorar a vizinhança
+ *   informada.
+ *
+ *   returns: custo do melhor vizinho, escrito em solucao_resultado apenas
+ *   quando é menor que o custo de solucao_inicial.
+ */
+long long encontrar_melhor_vizinho(struct solucionador* s, struct solucao* solucao_inicial, int vizinhanca, const char* regiao, struct solucao* solucao_resultado) {
+    switch (vizinhanca) {
+        case 0:
+            return realizar_swap(s, solucao_inicial, regiao, solucao_resultado);
+        case 1:
+            return realizar_2opt(s, solucao_inicial, regiao, solucao_resultado);
+        case 2:
+            return realizar_insercao(s, solucao_inicial, regiao, solucao_resultado);
+        case 3:
+            return realizar_oropt2(s, solucao_inicial, regiao, solucao_resultado);
+        case 4:
+            return realizar_oropt3(s, solucao_inicial, regiao, solucao_resultado);
+        default:
+            return custo_solucao(&s->problema, solucao_inicial);
+    }
+}
+
+/*
+ * Function: vnd
+ * -----------------------------------------------------------------------------
+ *   O método VND faz uma busca local em todas as vizinhanças informadas.
+ *
+ *   Princípios básicos:
+ *   1) Um ótimo local com relação a uma vizinhança não necessariamente
+ *      corresponde a um ótimo com relação a outra vizinhança.
+ *   2) Um ótimo global corresponde a um ótimo local para todas as estruturas
+ *      de vizinhança
+ *   3) Para muitos problemas, ótimos locais com relação a uma vizinhança são
+ *      relativamente próximos.
+ *
+ *   Referência:
+ *   http://www.decom.ufop.br/marcone/Disciplinas/InteligenciaComputacional/VNS.ppt
+ *
+ *   s: solucionador com o problema e as opções de execução.
+ *   vizinhancas: número de vizinhanças que serão exploradas.
+ *   solucao_inicial: solução inicial que terá a vizinhaça explorada.
+ *   solucao_resultado: melhor vizinho encontrado ao explorar as vizinhanças
+ *   informadas.
+ *
+ *   returns: custo da solução resultado.
+ */
+long long vnd(struct solucionador* s, int vizinhancas, struct solucao* solucao_inicial, struct solucao* solucao_resultado) {
+    return vnd_localizado(s, vizinhancas, NULL, 0, solucao_inicial, solucao_resultado);
+}
+
+/*
+ * Function: vnd_localizado
+ * -----------------------------------------------------------------------------
+ *   VND restrito à região da solução alterada pelo abalo. Como o abalo troca
+ *   apenas algumas posições, os movimentos distantes delas já foram avaliados
+ *   antes do abalo e dificilmente passam a melhorar a solução. Apenas os
+ *   movimentos que envolvem posições próximas (RAIO_BUSCA_LOCALIZADA) às
+ *   posições alteradas são avaliados e, a cada melhora, as extremidades do
+ *   movimento aplicado são incluídas na região, de forma que a busca se
+ *   expanda somente quando as melhoras se propagam.
+ *
+ *   A solução corrente e a candidata ocupam dois buffers que são trocados a
+ *   cada melhora (ver trocar_solucoes). O custo da solução inicial só é
+ *   calculado quando ainda não é conhecido (ver custo_solucao), e cada
+ *   vizinhança recebe a solução corrente com o custo já calculado.
+ *
+ *   Com a opção varredura_unificada, as vizinhanças são avaliadas em uma
+ *   única varredura da solução a cada passo (ver varrer_vizinhancas). Sem
+ *   região, em instâncias com ao menos TAMANHO_MINIMO_TABELA_GANHOS
+ *   elementos, o melhor movimento de cada vizinhança é obtido da tabela
+ *   persistente de ganhos (ver explorar_tabela_ganhos) e, em instâncias com
+ *   até TAMANHO_MAXIMO_VETORIAL elementos, os movimentos de cada linha são
+ *   avaliados juntos (ver explorar_vizinhanca_vetorial), com o mesmo
+ *   resultado.
+ *
+ *   s: solucionador com o problema e as opções de execução.
+ *   vizinhancas: número de vizinhanças que serão exploradas.
+ *   posicoes: posições alteradas pelo abalo (NULL explora toda a solução).
+ *   quantidade: quantidade de posições alteradas.
+ *   solucao_inicial: solução inicial que terá a vizinhaça explorada.
+ *   solucao_resultado: melhor vizinho encontrado ao explorar as vizinhanças
+ *   informadas.
+ *
+ *   returns: custo da solução resultado.
+ */
+long long vnd_localizado(struct solucionador* s, int vizinhancas, int* posicoes, int quantidade, struct solucao* solucao_inicial, struct solucao* solucao_resultado) {
+    struct problema* p = &s->problema;
+    long long custo = LLONG_MAX;
+    long long custo_tmp = 0;
+    char* regiao = NULL;
+    long long* prefixos = NULL;
+    int primeira;
+    int ultima;
+    int tabela;
+    int vetorial;
+    struct solucao* atual;
+    struct solucao* candidata;
+    
+    duplicar_solucao(p, solucao_inicial, solucao_resultado);
+    atual = solucao_resultado;
+    candidata = criar_solucao(p, NULL);
+    
+    if(posicoes) {
+        regiao = calloc(p->tamanho + 1, sizeof(char));
+        
+        for(int k = 0; k < quantidade; k++) {
+            marcar_regiao(regiao, p->tamanho, posicoes[k]);
+        }
+    }
+    
+    if(s->opcoes.varredura_unificada) {
+        prefixos = malloc(4 * (size_t) (p->tamanho + 1) * sizeof(long long));
+    }
+    
+    //a tabela de ganhos e a avaliação vetorial não imprimem os caminhos avaliados
+    tabela = !regiao && s->opcoes.tabela_ganhos && p->tamanho >= TAMANHO_MINIMO_TABELA_GANHOS && !s->opcoes.debug_caminhos;
+    vetorial = s->opcoes.avaliacao_vetorial && p->tamanho <= TAMANHO_MAXIMO_VETORIAL && p->kernel && p->kernel->bits == 16 && !s->opcoes.debug_caminhos;
+    
+    custo = custo_solucao(p, atual);
+    
+    int vizinhanca = 0;
+    
+    while (vizinhanca < vizinhancas) {
+        if(custo <= s->opcoes.alvo) {
+            break;
+        }
+        
+        if(s->opcoes.debug) {
+            printf("Iniciando a exploração da vizinhança: %d\n", vizinhanca);
+        }
+        
+        CEDER(s, atual->elementos);
+        
+        RASTRO_INICIO(s, inicio_vizinhanca);
+        PERFIL_ENTRAR(s, prefixos ? PERFIL_VARREDURA : PERFIL_VIZINHANCA + vizinhanca);
+        
+        //a candidata só é escrita quando a vizinhança possui um vizinho melhor
+        if(prefixos) {
+            vizinhanca = varrer_vizinhancas(s, atual, vizinhancas, regiao, prefixos, candidata);
+            custo_tmp = vizinhanca < 0 ? custo : candidata->custo;
+        } else if(tabela) {
+            custo_tmp = explorar_tabela_ganhos(s, atual, vizinhanca, candidata);
+        } else if(vetorial) {
+            custo_tmp = explorar_vizinhanca_vetorial(s, atual, vizinhanca, regiao, candidata);
+        } else {
+            custo_tmp = encontrar_melhor_vizinho(s, atual, vizinhanca, regiao, candidata);
+        }
+        
+        PERFIL_SAIR(s);
+        RASTRO_EVENTO(s, RASTRO_VIZINHANCA, inicio_vizinhanca, vizinhanca, vizinhanca < 0 ? custo : custo_tmp);
+        
+        if(vizinhanca < 0) {
+            break;
+        }
+        
+        if(custo_tmp < custo) {
+            if(regiao) {
+                //expandindo a região a partir das extremidades do movimento aplicado
+                primeira = 1;
+                while(candidata->elementos[primeira] == atual->elementos[primeira]) {
+                    primeira++;
+                }
+                
+                ultima = p->tamanho - 1;
+                while(candidata->elementos[ultima] == atual->elementos[ultima]) {
+                    ultima--;
+                }
+                
+                marcar_regiao(regiao, p->tamanho, primeira);
+                marcar_regiao(regiao, p->tamanho, ultima);
+            }
+            
+            trocar_solucoes(&atual, &candidata);
+            custo = custo_tmp;
+            
+            if(s->opcoes.debug) {
+                printf("VND - Custo melhorado (v=%d): %lld\n", vizinhanca, custo);
+                imprimir_solucao(p->tamanho, atual->elementos);
+            }
+            
+            vizinhanca = 0;
+        } else {
+            vizinhanca++;
+        }
+    }
+    
+    if(atual != solucao_resultado) {
+        duplicar_solucao(p, atual, solucao_resultado);
+        candidata = atual;
+    }
+    
+    free(regiao);
+    free(prefixos);
+    liberar_solucao(candidata);
+    
+    return custo;
+}
+
+/*
+ * Function: marcar_regiao
+ * -----------------------------------------------------------------------------
+ *   Inclui na região explorada pelo VND localizado a posição informada e as
+ *   posições a até RAIO_BUSCA_LOCALIZADA posições de distância dela. A origem
+ *   (posições 0 e tamanho) nunca é marcada.
+ *
+ *   regiao: posições marcadas.
+ *   tamanho: tamanho do problema.
+ *   posicao: posição alterada.
+ */
+void marcar_regiao(char* regiao, int tamanho, int posicao) {
+    int inicio = posicao - RAIO_BUSCA_LOCALIZADA;
+    int fim = posicao + RAIO_BUSCA_LOCALIZADA;
+    
+    if(inicio < 1) {
+        inicio = 1;
+    }
+    
+    if(fim > tamanho - 1) {
+        fim = tamanho - 1;
+    }
+    
+    for(int k = inicio; k <= fim; k++) {
+        regiao[k] = TRUE;
+    }
+}
+
+/*
+ * Function: gerar_vizinho_aleatorio
+ * -----------------------------------------------------------------------------
+ *   Função que abala uma solução com o objetivo de explorar de forma melhor
+ *   o espaço de soluções.
+ *
+ *   s: solucionador com o problema e as opções de execução.
+ *   vizinhanca: vizinhança que será utilizada para gerar uma nova solução.
+ *   vizinhancas: número de vizinhanças exploradas pelo método.
+ *   original: solução que será abalada.
+ *   resultado: solução abalada, com o índice de posições atualizado e o
+ *   custo marcado como desconhecido.
+ *   posicoes: recebe as posições alteradas pelo abalo (no máximo
+ *   MAXIMO_POSICOES_ABALO). Nos movimentos que deslocam ou invertem um
+ *   trecho são informadas as extremidades do trecho.
+ *
+ *   As vizinhanças 0 a 4 realizam pequenos movimentos aleatórios. As
+ *   vizinhanças VIZINHANCA_DOUBLE_BRIDGE e VIZINHANCA_RUINA realizam os
+ *   abalos profundos, que permitem escapar de ótimos locais dos quais os
+ *   pequenos movimentos não conseguem sair. Eles são aplicados apenas
+ *   abaixo da última vizinhança (vizinhanca < vizinhancas), que continua
+ *   sem alterar a solução: com as 5 vizinhanças usuais nenhum abalo
+ *   profundo é realizado.
+ *
+ *   returns: quantidade de posições alteradas.
+ */
+int gerar_vizinho_aleatorio(struct solucionador* s, int vizinhanca, int vizinhancas, struct solucao* original, struct solucao* resultado, int* posicoes) {
+    struct problema* p = &s->problema;
+    int* solucao = original->elementos;
+    int* solucao_resultado = resultado->elementos;
+    int tmp1;
+    int tmp2;
+    int tmp3;
+    int i;
+    int j;
+    int quantidade = 0;
+    
+    duplicar_solucao(p, original, resultado);
+    
+    //a última vizinhança do método não altera a solução
+    if(vizinhanca >= VIZINHANCA_DOUBLE_BRIDGE && vizinhanca >= vizinhancas) {
+        return 0;
+    }
+    
+    switch (vizinhanca) {
+        case 0:
+            i = rnd(s, 1, p->tamanho - 1);
+            j = rnd(s, 1, p->tamanho - 1);
+            
+            if(s->opcoes.debug) {
+                printf("swap aleatorio entre %d e %d\n", i, j);
+            }
+            
+            tmp1 = solucao_resultado[i];
+            solucao_resultado[i] = solucao_resultado[j];
+            solucao_resultado[j] = tmp1;
+            
+            posicoes[quantidade++] = i;
+            posicoes[quantidade++] = j;
+            break;
+        case 1:
+            i = rnd(s, 1, p->tamanho / 2);
+            j = rnd(s, i + 2, p->tamanho - 1);
+            
+            if(s->opcoes.debug) {
+                printf("2opt aleatorio entre %d e %d\n", i, j);
+            }
+            
+            realizar_swap_2opt(p, solucao_resultado, i, j, solucao_resultado);
+            
+            posicoes[quantidade++] = i;
+            posicoes[quantidade++] = j;
+            break;
+        case 2:
+            i = rnd(s, 1, p->tamanho - 2);
+            do{
+                j = rnd(s, i, p->tamanho - 1);
+            }while(i == j);
+            
+            if(s->opcoes.debug) {
+                printf("insercao aleatoria entre %d e %d\n", i, j);
+            }
+            
+            tmp1 = solucao_resultado[i];
+            
+            for(int k = i; k <= j; k++) {
+                solucao_resultado[k] = solucao_resultado[k + 1];
+            }
+            solucao_resultado[j] = tmp1;
+            
+            posicoes[quantidade++] = i;
+            posicoes[quantidade++] = j;
+            break;
+        case 3:
+            i = rnd(s, 1, p->tamanho / 2);
+            j = rnd(s, i + 2, p->tamanho - 2);
+            
+            tmp1 = solucao_resultado[i];
+            tmp2 = solucao_resultado[i + 1];
+            
+            if(s->opcoes.debug) {
+                printf("or opt2 aleatoria entre %d e %d\n", i, j);
+            }
+            
+            solucao_resultado[i] = solucao_resultado[j];
+            solucao_resultado[i + 1] = solucao_resultado[j + 1];
+            solucao_resultado[j] = tmp1;
+            solucao_resultado[j + 1] = tmp2;
+            
+            for(int k = 0; k < 2; k++) {
+                posicoes[quantidade++] = i + k;
+                posicoes[quantidade++] = j + k;
+            }
+            break;
+        case 4:
+            i = rnd(s, 1, (p->tamanho-1) / 2);
+            j = rnd(s, i + 3, p->tamanho - 3);
+            
+            tmp1 = solucao_resultado[i];
+            tmp2 = solucao_resultado[i + 1];
+            tmp3 = solucao_resultado[i + 2];
+            
+            if(s->opcoes.debug) {
+                printf("or opt3 aleatoria entre %d e %d\n", i, j);
+            }
+            
+            solucao_resultado[i] = solucao_resultado[j];
+            solucao_resultado[i + 1] = solucao_resultado[j + 1];
+            solucao_resultado[i + 2] = solucao_resultado[j + 2];
+            solucao_resultado[j] = tmp1;
+            solucao_resultado[j + 1] = tmp2;
+            solucao_resultado[j + 2] = tmp3;
+            
+            for(int k = 0; k < 3; k++) {
+                posicoes[quantidade++] = i + k;
+                posicoes[quantidade++] = j + k;
+            }
+            break;
+        case VIZINHANCA_DOUBLE_BRIDGE:
+            if(s->opcoes.debug) {
+                printf("double-bridge aleatorio\n");
+            }
+            
+            quantidade = realizar_random_double_bridge(s, solucao, solucao_resultado, posicoes);
+            break;
+        case VIZINHANCA_RUINA:
+            if(s->opcoes.debug) {
+                printf("ruina e reconstrucao aleatoria\n");
+            }
+            
+            quantidade = realizar_ruina_reconstrucao(s, solucao, solucao_resultado, posicoes);
+            break;
+        default:
+            break;
+    }
+    
+    //abalos que não alteram a solução preservam o custo já conhecido
+    if(quantidade > 0) {
+        definir_solucao(p, resultado, solucao_resultado, -1);
+    }
+    
+    return quantidade;
+}
+
+/*
+ * Function: vns
+ * -----------------------------------------------------------------------------
+ *   O método General VNS (GVNS) realiza busca local do VNS feita pelo VND.
+ *
+ *   1) Proposto por Nenad Mladenovic & Pierre Hansen em 1997
+ *   2) Metaheurísticas de busca local que explora o espaço de soluções através
+ *   de trocas sistemáticas de estruturas de vizinhança.
+ *   3) Explora vizinhanças gradativamente mais “distantes”
+ *   4) Focaliza a busca em torno de uma nova solução somente se um movimento
+ *   de melhora é realizado.
+ *
+ *   Referência:
+ *   http://www.decom.ufop.br/marcone/Disciplinas/InteligenciaComputacional/VNS.ppt
+ *
+ *   s: solucionador com o problema e as opções de execução.
+ *   iteracoes: número de iterações para o método.
+ *   vizinhancas: número de vizinhanças que serão exploradas.
+ *   solucao_inicial: solução inicial que terá a vizinhaça explorada.
+ *   solucao_resultado: melhor vizinho encontrado ao explorar as vizinhanças
+ *   informadas.
+ *
+ *   Quando há um checkpoint ativo, o estado da busca é registrado no início de
+ *   cada exploração de vizinhança e, ao retomar, a busca continua exatamente
+ *   do ponto gravado. A cada melhora da solução incumbente a função
+ *   ao_melhorar das opções é chamada, quando informada, e a solução é
+ *   publicada em opcoes.incumbente (ver publicar_incumbente). A busca também é
+ *   interrompida ao esgotar o tempo máximo das opções, quando informado.
+ *
+ *   Quando a função receber_incumbente das opções é informada (modo
+ *   distribuído), ela é consultada antes de cada abalo e a solução recebida
+ *   substitui a incumbente se for melhor.
+ *
+ *   Com a opção busca_localizada, o VND aplicado após o abalo explora apenas
+ *   a região da solução alterada pelo abalo (ver vnd_localizado). A solução
+ *   incumbente e a solução abalada ocupam dois buffers, trocados a cada
+ *   melhora; a incumbente é copiada para solucao_resultado apenas ao término.
+ *
+ *   returns: custo da solução resultado.
+ */
+long long gvns(struct solucionador* s, int iteracoes, int vizinhancas, struct solucao* solucao_inicial, struct solucao* solucao_resultado) {
+    struct problema* p = &s->problema;
+    long long custo = LLONG_MAX;
+    long long custo_tmp = 0;
+    int vizinhanca = 0;
+    int posicoes[MAXIMO_POSICOES_ABALO];
+    int quantidade;
+    struct solucao* melhor;
+    
+    int iteracao_inicial = 0;
+    int vizinhanca_inicial = 0;
+    
+    struct solucao* solucao_tmp = criar_solucao(p, NULL);
+    duplicar_solucao(p, solucao_inicial, solucao_resultado);
+    melhor = solucao_resultado;
+    
+    //restaurando o estado gravado no checkpoint
+    if(s->opcoes.checkpoint && s->opcoes.checkpoint->retomar) {
+        //o custo gravado é LLONG_MAX quando a interrupção ocorreu antes da primeira melhora
+        definir_solucao(p, melhor, s->opcoes.checkpoint->estado.solucao, -1);
+        custo = s->opcoes.checkpoint->estado.custo;
+        iteracao_inicial = s->opcoes.checkpoint->estado.iteracao;
+        vizinhanca_inicial = s->opcoes.checkpoint->estado.vizinhanca;
+        s->estado_aleatorio = s->opcoes.checkpoint->estado.estado_aleatorio;
+        s->opcoes.checkpoint->retomar = FALSE;
+    }
+    
+    //a solução inicial fica disponível enquanto a primeira busca local é realizada
+    if(s->opcoes.incumbente) {
+        publicar_incumbente(s->opcoes.incumbente, custo_solucao(p, melhor), melhor->elementos, s->execucao);
+    }
+    
+    for(int i = iteracao_inicial; i < iteracoes && custo > s->opcoes.alvo && !tempo_esgotado(s); i++) {
+        if(s->opcoes.debug) {
+            printf("Iniciando o processo na iteração %d. Melhor custo %lld", i, custo);
+            linha();
+        }
+        
+        vizinhanca = i == iteracao_inicial ? vizinhanca_inicial : 0;
+        
+        while (vizinhanca <= vizinhancas) {
+            if(s->opcoes.checkpoint) {
+                registrar_checkpoint(s->opcoes.checkpoint, i, vizinhanca, custo, s->estado_aleatorio, melhor->elementos);
+            }
+            
+            if(custo <= s->opcoes.alvo || tempo_esgotado(s)) {
+                break;
+            }
+            
+            if(s->opcoes.receber_incumbente && s->opcoes.receber_incumbente(solucao_tmp->elementos, &custo_tmp, s->opcoes.dados) && custo_tmp < custo) {
+                definir_solucao(p, solucao_tmp, solucao_tmp->elementos, custo_tmp);
+                trocar_solucoes(&melhor, &solucao_tmp);
+                custo = custo_tmp;
+                vizinhanca = 0;
+                
+                RASTRO_PONTO(s, RASTRO_MELHORA, -1, custo);
+                
+                if(s->opcoes.incumbente) {
+                    publicar_incumbente(s->opcoes.incumbente, custo, melhor->elementos, s->execucao);
+                }
+                
+                if(s->opcoes.debug) {
+                    printf("Custo melhorado (RECEBIDO): %lld\n", custo);
+                }
+                
+                if(custo <= s->opcoes.alvo) {
+                    break;
+                }
+            }
+            
+            RASTRO_INICIO(s, inicio_abalo);
+            PERFIL_ENTRAR(s, PERFIL_ABALO);
+            
+            quantidade = gerar_vizinho_aleatorio(s, vizinhanca, vizinhancas, melhor, solucao_tmp, posicoes);
+            
+            PERFIL_SAIR(s);
+            RASTRO_EVENTO(s, RASTRO_ABALO, inicio_abalo, vizinhanca, 0);
+            
+            //o abalo da última vizinhança não altera a solução e recebe o VND completo, que
+            //ainda pode melhorar uma incumbente obtida pelo path relinking
+            if(s->opcoes.busca_localizada && quantidade > 0) {
+                custo_tmp = vnd_localizado(s, vizinhancas, posicoes, quantidade, solucao_tmp, solucao_tmp);
+            } else {
+                custo_tmp = vnd(s, vizinhancas, solucao_tmp, solucao_tmp);
+            }
+            
+            if(custo_tmp < custo) {
+                trocar_solucoes(&melhor, &solucao_tmp);
+                custo = custo_tmp;
+                
+                RASTRO_PONTO(s, RASTRO_MELHORA, vizinhanca, custo);
+                
+                if(s->opcoes.incumbente) {
+                    publicar_incumbente(s->opcoes.incumbente, custo, melhor->elementos, s->execucao);
+                }
+                
+                if(s->opcoes.ao_melhorar) {
+                    s->opcoes.ao_melhorar(custo, melhor->elementos, p->tamanho, s->opcoes.dados);
+                }
+                
+                if(s->opcoes.debug) {
+                    printf("Custo melhorado (GVNS v=%d): %lld\n", vizinhanca, custo);
+                }
+                
+                vizinhanca = 0;
+            } else {
+                if(custo_tmp > custo) {
+                    RASTRO_INICIO(s, inicio_path_relinking);
+                    PERFIL_ENTRAR(s, PERFIL_PATH_RELINKING);
+                    
+                    custo_tmp = realizar_path_relinking(s, solucao_tmp, melhor, solucao_tmp);
+                    
+                    PERFIL_SAIR(s);
+                    RASTRO_EVENTO(s, RASTRO_PATH_RELINKING, inicio_path_relinking, vizinhanca, custo_tmp);
+                
+                    if(custo_tmp < custo) {
+                        trocar_solucoes(&melhor, &solucao_tmp);
+                        custo = custo_tmp;
+                    
+                        RASTRO_PONTO(s, RASTRO_MELHORA, vizinhanca, custo);
+                    
+                        if(s->opcoes.incumbente) {
+                            publicar_incumbente(s->opcoes.incumbente, custo, melhor->elementos, s->execucao);
+                        }
+                    
+                        if(s->opcoes.ao_melhorar) {
+                            s->opcoes.ao_melhorar(custo, melhor->elementos, p->tamanho, s->opcoes.dados);
+                        }
+                    
+                        if(s->opcoes.debug) {
+                            printf("Custo melhorado (PATH): %lld\n", custo);
+                        }
+                    
+                        vizinhanca = 0;
+                    } else {
+                        vizinhanca++;
+                    }
+                } else {
+                    vizinhanca++;
+                }
+            }
+        }
+    }
+    
+    if(melhor != solucao_resultado) {
+        duplicar_solucao(p, melhor, solucao_resultado);
+        solucao_tmp = melhor;
+    }
+    
+    liberar_solucao(solucao_tmp);
+    
+    return custo_solucao(p, solucao_resultado);
+}
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções que implementam o método exato para instâncias pequenas.
+// * -----------------------------------------------------------------------------
+
+/*
+ * Function: resolver_exato
+ * -----------------------------------------------------------------------------
+ *   Resolve o problema de forma exata através de programação dinâmica sobre
+ *   subconjuntos (Held-Karp) adaptada para a função de latência. Como o peso
+ *   de cada arco depende apenas da posição em que ele aparece no caminho
+ *   (p->tamanho - posição), e a posição é dada pela quantidade de elementos já
+ *   visitados, o estado (subconjunto visitado, último elemento) é suficiente.
+ *
+ *   Os subconjuntos são representados por máscaras de bits sobre os elementos
+ *   1..p->tamanho-1 (o elemento 0 é sempre a origem). A tabela é armazenada
+ *   com o último elemento como índice mais interno, de forma que todas as
+ *   transições de um subconjunto leiam posições contíguas de memória. O
+ *   caminho é reconstruído percorrendo a tabela de trás para frente, sem a
+ *   necessidade de uma tabela de predecessores.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   solucao: solução ótima encontrada.
+ *
+ *   returns: custo da solução ótima ou -1 caso não seja possível alocar a
+ *   tabela.
+ */
+long long resolver_exato(struct problema* p, int* solucao) {
+    int m = p->tamanho - 1;
+    long long* tabela;
+    unsigned int completo;
+    long long melhor;
+    int ultimo;
+    
+    solucao[0] = 0;
+    solucao[p->tamanho] = 0;
+    
+    if(m <= 0) {
+        return calcular_custo(p, solucao);
+    }
+    
+    completo = (1u << m) - 1;
+    tabela = malloc(((size_t) completo + 1) * m * sizeof(long long));
+    
+    if(!tabela) {
+        return -1;
+    }
+    
+    for(unsigned int s = 1; s <= completo; s++) {
+        long long* linha_atual = tabela + (size_t) s * m;
+        int peso = p->tamanho - __builtin_popcount(s) + 1;
+        
+        for(unsigned int r = s; r; r &= r - 1) {
+            int k = __builtin_ctz(r);
+            unsigned int anterior = s & ~(1u << k);
+            
+            if(!anterior) {
+                linha_atual[k] = (long long) distancia(p, 0, k + 1) * p->tamanho;
+                continue;
+            }
+            
+            long long* linha_anterior = tabela + (size_t) anterior * m;
+            long long custo = LLONG_MAX;
+            
+            for(unsigned int q = anterior; q; q &= q - 1) {
+                int i = __builtin_ctz(q);
+                long long custo_tmp = linha_anterior[i] + (long long) distancia(p, i + 1, k + 1) * peso;
+                
+                if(custo_tmp < custo) {
+                    custo = custo_tmp;
+                }
+            }
+            
+            linha_atual[k] = custo;
+        }
+    }
+    
+    //fechando o caminho com o retorno para a origem
+    melhor = LLONG_MAX;
+    ultimo = 0;
+    for(int k = 0; k < m; k++) {
+        long long custo_tmp = tabela[(size_t) completo * m + k] + distancia(p, k + 1, 0);
+        
+        if(custo_tmp < melhor) {
+            melhor = custo_tmp;
+            ultimo = k;
+        }
+    }
+    
+    //reconstruindo o caminho a partir do final
+    unsigned int s = completo;
+    for(int posicao = m; posicao >= 1; posicao--) {
+        solucao[posicao] = ultimo + 1;
+        
+        unsigned int anterior = s & ~(1u << ultimo);
+        if(!anterior) {
+            break;
+        }
+        
+        int peso = p->tamanho - posicao + 1;
+        long long alvo_tabela = tabela[(size_t) s * m + ultimo];
+        
+        for(unsigned int q = anterior; q; q &= q - 1) {
+            int i = __builtin_ctz(q);
+            
+            if(tabela[(size_t) anterior * m + i] + (long long) distancia(p, i + 1, ultimo + 1) * peso == alvo_tabela) {
+                ultimo = i;
+                break;
+            }
+        }
+        
+        s = anterior;
+    }
+    
+    free(tabela);
+    
+    return melhor;
+}
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções que implementam os movimentos de exploração de vizinhança.
+// * -----------------------------------------------------------------------------
+
+/*
+ * Function: realizar_random_double_bridge
+ * -----------------------------------------------------------------------------
+ *   O movimento double-bridge consiste em remover 3 arcos e reconectar o
+ *   caminho gerando uma nova solução viável para o problema: a solução
+ *   A B C D passa a ser A C B D. Ao invés de selecionar arcos fixos
+ *   (geralmente quebrando a solução em 4 partes iguais), arcos aleatórios são
+ *   selecionados, visto que essa função é utilizada como shake do método GVNS.
+ *
+ *   s: solucionador com o problema e as opções de execução.
+ *   solucao: solucao que terá sua vizinhança explorada.
+ *   solucao_resultado: a melhor solução encontrada após a execução do método.
+ *   posicoes: recebe as extremidades dos trechos B e C na nova solução.
+ *
+ *   returns: quantidade de posições alteradas.
+ */
+int realizar_random_double_bridge(struct solucionador* s, int* solucao, int* solucao_resultado, int* posicoes) {
+    struct problema* p = &s->problema;
+    int a, b, c;
+    int k;
+    
+    copiar_solucao(p->tamanho, solucao, solucao_resultado);
+    
+    if(p->tamanho < 3) {
+        return 0;
+    }
+    
+    //B = [a, b - 1] e C = [b, c - 1]; D pode ser vazio
+    a = rnd(s, 1, p->tamanho - 2);
+    b = rnd(s, a + 1, p->tamanho - 1);
+    c = rnd(s, b + 1, p->tamanho);
+    
+    k = a;
+    for(int i = b; i < c; i++) {
+        solucao_resultado[k++] = solucao[i];
+    }
+    
+    for(int i = a; i < b; i++) {
+        solucao_resultado[k++] = solucao[i];
+    }
+    
+    posicoes[0] = a;
+    posicoes[1] = a + (c - b) - 1;
+    posicoes[2] = a + (c - b);
+    posicoes[3] = c - 1;
+    
+    return 4;
+}
+
+/*
+ * Function: realizar_ruina_reconstrucao
+ * -----------------------------------------------------------------------------
+ *   O movimento de ruína e reconstrução remove de 2 a RUINA_MAXIMO_ELEMENTOS
+ *   elementos da solução e os reinsere, em ordem aleatória, na posição de
+ *   menor latência (ver inserir_menor_latencia). Os elementos removidos são
+ *   um trecho aleatório da solução ou, quando o problema possui contexto, um
+ *   elemento aleatório e os seus vizinhos mais próximos.
+ *
+ *   s: solucionador com o problema e as opções de execução.
+ *   solucao: solucao que terá sua vizinhança explorada.
+ *   solucao_resultado: a melhor solução encontrada após a execução do método.
+ *   posicoes: recebe as posições dos elementos reinseridos e, no caso do
+ *   trecho, a posição do elemento que o precedia.
+ *
+ *   returns: quantidade de posições alteradas.
+ */
+int realizar_ruina_reconstrucao(struct solucionador* s, int* solucao, int* solucao_resultado, int* posicoes) {
+    struct problema* p = &s->problema;
+    int removidos[RUINA_MAXIMO_ELEMENTOS];
+    int quantidade;
+    int predecessor = -1;
+    int elementos = 0;
+    int inicio;
+    int tmp;
+    int k;
+    
+    if(p->tamanho < 3) {
+        copiar_solucao(p->tamanho, solucao, solucao_resultado);
+        return 0;
+    }
+    
+    quantidade = rnd(s, 2, RUINA_MAXIMO_ELEMENTOS);
+    if(quantidade > p->tamanho - 1) {
+        quantidade = p->tamanho - 1;
+    }
+    
+    if(p->contexto && aleatorio(s) % 2) {
+        const int* vizinhos = p->contexto->vizinhos + (size_t) solucao[rnd(s, 1, p->tamanho - 1)] * p->tamanho;
+        
+        //o próprio elemento é o primeiro da sua lista de vizinhos
+        k = 0;
+        for(int j = 0; k < quantidade; j++) {
+            if(vizinhos[j] != 0) {
+                removidos[k++] = vizinhos[j];
+            }
+        }
+    } else {
+        inicio = rnd(s, 1, p->tamanho - quantidade);
+        predecessor = solucao[inicio - 1];
+        
+        for(k = 0; k < quantidade; k++) {
+            removidos[k] = solucao[inicio + k];
+        }
+    }
+    
+    for(int i = 0; i <= p->tamanho; i++) {
+        if(localizar_elemento(removidos, quantidade, solucao[i], 0) < 0) {
+            solucao_resultado[elementos++] = solucao[i];
+        }
+    }
+    
+    for(k = quantidade - 1; k > 0; k--) {
+        inicio = rnd(s, 0, k);
+        tmp = removidos[k];
+        removidos[k] = removidos[inicio];
+        removidos[inicio] = tmp;
+    }
+    
+    for(k = 0; k < quantidade; k++) {
+        inserir_menor_latencia(p, solucao_resultado, elementos - 1, removidos[k]);
+        elementos++;
+    }
+    
+    k = 0;
+    for(int i = 1; i < p->tamanho; i++) {
+        if(solucao_resultado[i] == predecessor || localizar_elemento(removidos, quantidade, solucao_resultado[i], 0) >= 0) {
+            posicoes[k++] = i;
+        }
+    }
+    
+    return k;
+}
+
+/*
+ * Function: inserir_menor_latencia
+ * -----------------------------------------------------------------------------
+ *   Insere um elemento em uma solução parcial na posição que menos aumenta a
+ *   latência total. Inserir o elemento v entre os elementos das posições
+ *   q - 1 e q (arco de custo d) aumenta em 1 o peso de todos os arcos
+ *   anteriores a q - 1 e mantém o peso dos arcos posteriores, de forma que o
+ *   acréscimo é
+ *
+ *   prefixo(q - 1) + d(a, v) * (arcos - q + 2) + (d(v, b) - d) * (arcos - q + 1)
+ *
+ *   onde prefixo(q - 1) é a soma dos arcos anteriores a q - 1. Com o prefixo
+ *   acumulado durante a varredura, todas as posições são avaliadas em O(n).
+ *
+ *   p: estrutura de dados representando o problema.
+ *   solucao: solução parcial (arcos + 1 posições, iniciando e terminando no
+ *   elemento 0), que recebe o elemento e passa a ter arcos + 2 posições.
+ *   arcos: quantidade de arcos da solução parcial.
+ *   elemento: elemento que será inserido.
+ */
+void inserir_menor_latencia(struct problema* p, int* solucao, int arcos, int elemento) {
+    long long prefixo = 0;
+    long long acrescimo;
+    long long melhor_acrescimo = LLONG_MAX;
+    int melhor_q = 1;
+    int d;
+    
+    for(int q = 1; q <= arcos; q++) {
+        d = distancia(p, solucao[q - 1], solucao[q]);
+        acrescimo = prefixo
+            + (long long) distancia(p, solucao[q - 1], elemento) * (arcos - q + 2)
+            + (long long) (distancia(p, elemento, solucao[q]) - d) * (arcos - q + 1);
+        
+        if(acrescimo < melhor_acrescimo) {
+            melhor_acrescimo = acrescimo;
+            melhor_q = q;
+        }
+        
+        prefixo += d;
+    }
+    
+    memmove(solucao + melhor_q + 1, solucao + melhor_q, (arcos - melhor_q + 1) * sizeof(int));
+    solucao[melhor_q] = elemento;
+}
+
+/*
+ * Function: realizar_swap
+ * -----------------------------------------------------------------------------
+ *   O movimento swap consiste em selecionar 2 elementos da solução e realizar
+ *   a troca de posição. Os movimentos são aplicados e desfeitos na própria
+ *   solução explorada, que é restaurada ao término da função; apenas o melhor
+ *   movimento é aplicado na solução resultado.
+ *
+ *   s: solucionador com o problema e as opções de execução.
+ *   explorada: solução que terá sua vizinhança explorada (o custo é
+ *   calculado apenas quando ainda não é conhecido).
+ *   regiao: posições marcadas pelo VND localizado; apenas os movimentos que
+ *   envolvem alguma posição marcada são avaliados (NULL avalia todos).
+ *   resultado: a melhor solução encontrada após a execução do método.
+ *
+ *   returns: custo da melhor solução encontrada. A solução resultado só é
+ *   escrita quando esse custo é menor que o custo da solução explorada.
+ */
+long long realizar_swap(struct solucionador* s, struct solucao* explorada, const char* regiao, struct solucao* resultado) {
+    struct problema* p = &s->problema;
+    int* solucao = explorada->elementos;
+    int i,j;
+    int melhor_i = 0;
+    int melhor_j = 0;
+    long long custo, custo_tmp, custo_inicial;
+    int tmp;
+    
+    custo_inicial = custo = custo_solucao(p, explorada);
+    
+    if(s->opcoes.debug && s->opcoes.debug_caminhos) {
+        printf("\nTentando localizar melhor vizinho na vizinhanca swap\n");
+        imprimir_solucao(p->tamanho, solucao);
+        linha();
+    }
+    
+    for(i = 1; i < p->tamanho && custo > s->opcoes.alvo; i++) {
+        for(j = i + 1; j < p->tamanho && custo > s->opcoes.alvo; j++) {
+            if(!MOVIMENTO_NA_REGIAO(regiao, i, j)) {
+                continue;
+            }
+            
+            tmp = solucao[i];
+            solucao[i] = solucao[j];
+            solucao[j] = tmp;
+            
+            custo_tmp = calcular_custo(p, solucao);
+            
+            if(s->opcoes.debug && s->opcoes.debug_caminhos) {
+                imprimir_solucao(p->tamanho, solucao);
+                printf("de %lld para %lld\n", custo_inicial, custo_tmp);
+            }
+            
+            //desfazendo o movimento
+            solucao[j] = solucao[i];
+            solucao[i] = tmp;
+            
+            if(custo_tmp < custo) {
+                custo = custo_tmp;
+                melhor_i = i;
+                melhor_j = j;
+            }
+        }
+    }
+    
+    if(melhor_i) {
+        aplicar_movimento(p, explorada, 0, melhor_i, melhor_j, custo, resultado);
+    }
+    
+    return custo;
+}
+
+/*
+ * Function: realizar_insercao
+ * -----------------------------------------------------------------------------
+ *   Implementação da estratégia inserção que consiste basicamente em inserir
+ *   um nodo entre outros 2 nodos explorando a vizinhaça de uma solução.
+ *
+ *   s: solucionador com o problema e as opções de execução.
+ *   explorada: solução que terá sua vizinhança explorada (o custo é
+ *   calculado apenas quando ainda não é conhecido).
+ *   regiao: posições marcadas pelo VND localizado; apenas os movimentos que
+ *   envolvem alguma posição marcada são avaliados (NULL avalia todos).
+ *   resultado: a melhor solução encontrada após a execução do método.
+ *
+ *   returns: custo da melhor solução encontrada. A solução resultado só é
+ *   escrita quando esse custo é menor que o custo da solução explorada.
+ */
+long long realizar_insercao(struct solucionador* s, struct solucao* explorada, const char* regiao, struct solucao* resultado) {
+    struct problema* p = &s->problema;
+    int* solucao = explorada->elementos;
+    long long custo, custo_tmp, custo_inicial;
+    int melhor_i = 0;
+    int melhor_j = 0;
+    int elemento;
+    int j;
+    
+    custo_inicial = custo = custo_solucao(p, explorada);
+    
+    if(s->opcoes.debug && s->opcoes.debug_caminhos) {
+        printf("\nTentando localizar melhor vizinho na vizinhanca inserção\n");
+        imprimir_solucao(p->tamanho, solucao);
+        linha();
+    }
+    
+    for(int i = 1; i < p->tamanho && custo > s->opcoes.alvo; i++) {
+        elemento = solucao[i];
+        
+        //o elemento avança uma posição a cada passo
+        for(j = i; j < p->tamanho - 1 && custo > s->opcoes.alvo; j++) {
+            solucao[j] = solucao[j + 1];
+            solucao[j + 1] = elemento;
+            
+            if(!MOVIMENTO_NA_REGIAO(regiao, i, j + 1)) {
+                continue;
+            }
+            
+            custo_tmp = calcular_custo(p, solucao);
+            
+            if(s->opcoes.debug && s->opcoes.debug_caminhos) {
+                imprimir_solucao(p->tamanho, solucao);
+                printf("de %lld para %lld\n", custo_inicial, custo_tmp);
+            }
+            
+            if(custo_tmp < custo) {
+                custo = custo_tmp;
+                melhor_i = i;
+                melhor_j = j + 1;
+            }
+        }
+        
+        //desfazendo os deslocamentos (o elemento está na posição j)
+        for(int k = j; k > i; k--) {
+            solucao[k] = solucao[k - 1];
+        }
+        solucao[i] = elemento;
+    }
+    
+    if(melhor_i) {
+        aplicar_movimento(p, explorada, 2, melhor_i, melhor_j, custo, resultado);
+    }
+    
+    return custo;
+}
+
+/*
+ * Function: realizar_2opt
+ * -----------------------------------------------------------------------------
+ *   O método consiste em remover 2 arcos não adjacentes e outros 2 são
+ *   inseridos, visando gerar vizinhos de uma dada solução.
+ *
+ *   s: solucionador com o problema e as opções de execução.
+ *   explorada: solução que terá sua vizinhança explorada (o custo é
+ *   calculado apenas quando ainda não é conhecido).
+ *   regiao: posições marcadas pelo VND localizado; apenas os movimentos que
+ *   envolvem alguma posição marcada são avaliados (NULL avalia todos).
+ *   resultado: a melhor solução encontrada após a execução do método.
+ *
+ *   returns: custo da melhor solução encontrada. A solução resultado só é
+ *   escrita quando esse custo é menor que o custo da solução explorada.
+ */
+long long realizar_2opt(struct solucionador* s, struct solucao* explorada, const char* regiao, struct solucao* resultado) {
+    struct problema* p = &s->problema;
+    int* solucao = explorada->elementos;
+    int i,j;
+    int melhor_i = 0;
+    int melhor_j = 0;
+    long long custo, custo_tmp, custo_inicial;
+    
+    custo_inicial = custo = custo_solucao(p, explorada);
+    
+    if(s->opcoes.debug && s->opcoes.debug_caminhos) {
+        printf("\nTentando localizar melhor vizinho na vizinhanca 2-opt\n");
+        imprimir_solucao(p->tamanho, solucao);
+        linha();
+    }
+    
+    for(i = 1; i < p->tamanho - 1 && custo > s->opcoes.alvo; i++) {
+        for(j = i + 1; j < p->tamanho && custo > s->opcoes.alvo; j++) {
+            if(!MOVIMENTO_NA_REGIAO(regiao, i, j)) {
+                continue;
+            }
+            
+            realizar_swap_2opt(p, solucao, i, j, solucao);
+            
+            custo_tmp = calcular_custo(p, solucao);
+            
+            if(s->opcoes.debug && s->opcoes.debug_caminhos) {
+                imprimir_solucao(p->tamanho, solucao);
+                printf("de %lld para %lld\n", custo_inicial, custo_tmp);
+            }
+            
+            //desfazendo o movimento (a inversão é a sua própria inversa)
+            realizar_swap_2opt(p, solucao, i, j, solucao);
+            
+            if(custo_tmp < custo) {
+                custo = custo_tmp;
+                melhor_i = i;
+                melhor_j = j;
+            }
+        }
+    }
+    
+    if(melhor_i) {
+        aplicar_movimento(p, explorada, 1, melhor_i, melhor_j, custo, resultado);
+    }
+    
+    return custo;
+}
+
+/*
+ * Function: realizar_swap_2opt
+ * -----------------------------------------------------------------------------
+ *   Método auxiliar para a execução da exploração da vizinhança do movimento
+ *   2-opt: inverte o trecho entre as posições i e k. Quando solucao e
+ *   solucao_resultado são o mesmo vetor a inversão é feita no próprio vetor;
+ *   como a inversão é a sua própria inversa, aplicá-la novamente desfaz o
+ *   movimento.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   solucao: solucao que terá sua vizinhança explorada.
+ *   i: posição inicial do trecho.
+ *   k: posição final do trecho.
+ *   solucao_resultado: a melhor solução encontrada após a execução do método.
+ */
+void realizar_swap_2opt(struct problema* p, int* solucao, int i, int k, int* solucao_resultado) {
+    int tmp;
+    
+    if(solucao != solucao_resultado) {
+        copiar_solucao(p->tamanho, solucao, solucao_resultado);
+    }
+    
+    for(; i < k; i++, k--) {
+        tmp = solucao_resultado[i];
+        solucao_resultado[i] = solucao_resultado[k];
+        solucao_resultado[k] = tmp;
+    }
+}
+
+/*
+ * Function: realizar_oropt2
+ * -----------------------------------------------------------------------------
+ *   O movimento or opt2 consiste em selecionar 2 pares e trocar suas posições.
+ *
+ *   s: solucionador com o problema e as opções de execução.
+ *   explorada: solução que terá sua vizinhança explorada (o custo é
+ *   calculado apenas quando ainda não é conhecido).
+ *   regiao: posições marcadas pelo VND localizado; apenas os movimentos que
+ *   envolvem alguma posição marcada são avaliados (NULL avalia todos).
+ *   resultado: a melhor solução encontrada após a execução do método.
+ *
+ *   returns: custo da melhor solução encontrada. A solução resultado só é
+ *   escrita quando esse custo é menor que o custo da solução explorada.
+ */
+long long realizar_oropt2(struct solucionador* s, struct solucao* explorada, const char* regiao, struct solucao* resultado) {
+    struct problema* p = &s->problema;
+    int* solucao = explorada->elementos;
+    int i,j;
+    int melhor_i = 0;
+    int melhor_j = 0;
+    long long custo, custo_tmp, custo_inicial;
+    int tmp1, tmp2;
+    
+    custo_inicial = custo = custo_solucao(p, explorada);
+    
+    if(s->opcoes.debug && s->opcoes.debug_caminhos) {
+        printf("\nTentando localizar melhor vizinho na vizinhanca or2opt\n");
+        imprimir_solucao(p->tamanho, solucao);
+        linha();
+    }
+    
+    for(i = 1; i < p->tamanho - 1 && custo > s->opcoes.alvo; i++) {
+        tmp1 = solucao[i];
+        tmp2 = solucao[i + 1];
+        
+        //o par avança uma posição a cada passo
+        for(j = i + 2; j < p->tamanho - 1 && custo > s->opcoes.alvo; j++) {
+            solucao[j - 2] = solucao[j];
+            solucao[j] = tmp2;
+            solucao[j - 1] = tmp1;
+            
+            if(!MOVIMENTO_NA_REGIAO(regiao, i, j)) {
+                continue;
+            }
+            
+            custo_tmp = calcular_custo(p, solucao);
+            
+            if(s->opcoes.debug && s->opcoes.debug_caminhos) {
+                imprimir_solucao(p->tamanho, solucao);
+                printf("de %lld para %lld\n", custo_inicial, custo_tmp);
+            }
+            
+            if(custo_tmp < custo) {
+                custo = custo_tmp;
+                melhor_i = i;
+                melhor_j = j;
+            }
+        }
+        
+        //desfazendo os deslocamentos (o par termina na posição j - 1)
+        for(int k = j - 1; k >= i + 2; k--) {
+            solucao[k] = solucao[k - 2];
+        }
+        solucao[i] = tmp1;
+        solucao[i + 1] = tmp2;
+    }
+    
+    if(melhor_i) {
+        aplicar_movimento(p, explorada, 3, melhor_i, melhor_j, custo, resultado);
+    }
+    
+    return custo;
+}
+
+/*
+ * Function: realizar_oropt3
+ * -----------------------------------------------------------------------------
+ *   O movimento or opt3 consiste em selecionar 2 trios e trocar suas posições.
+ *
+ *   s: solucionador com o problema e as opções de execução.
+ *   explorada: solução que terá sua vizinhança explorada (o custo é
+ *   calculado apenas quando ainda não é conhecido).
+ *   regiao: posições marcadas pelo VND localizado; apenas os movimentos que
+ *   envolvem alguma posição marcada são avaliados (NULL avalia todos).
+ *   resultado: a melhor solução encontrada após a execução do método.
+ *
+ *   returns: custo da melhor solução encontrada. A solução resultado só é
+ *   escrita quando esse custo é menor que o custo da solução explorada.
+ */
+long long realizar_oropt3(struct solucionador* s, struct solucao* explorada, const char* regiao, struct solucao* resultado) {
+    struct problema* p = &s->problema;
+    int* solucao = explorada->elementos;
+    int i,j;
+    int melhor_i = 0;
+    int melhor_j = 0;
+    long long custo, custo_tmp, custo_inicial;
+    int tmp1, tmp2, tmp3;
+    
+    custo_inicial = custo = custo_solucao(p, explorada);
+    
+    if(s->opcoes.debug && s->opcoes.debug_caminhos) {
+        printf("\nTentando localizar melhor vizinho na vizinhanca or3opt\n");
+        imprimir_solucao(p->tamanho, solucao);
+        linha();
+    }
+    
+    for(i = 1; i < p->tamanho - 1 && custo > s->opcoes.alvo; i++) {
+        tmp1 = solucao[i];
+        tmp2 = solucao[i + 1];
+        tmp3 = solucao[i + 2];
+        
+        //o trio avança uma posição a cada passo
+        for(j = i + 3; j < p->tamanho - 2 && custo > s->opcoes.alvo; j++) {
+            solucao[j - 3] = solucao[j];
+            solucao[j] = tmp3;
+            solucao[j - 1] = tmp2;
+            solucao[j - 2] = tmp1;
+            
+            if(!MOVIMENTO_NA_REGIAO(regiao, i, j)) {
+                continue;
+            }
+        
+            custo_tmp = calcular_custo(p, solucao);
+            
+            if(s->opcoes.debug && s->opcoes.debug_caminhos) {
+                imprimir_solucao(p->tamanho, solucao);
+                printf("de %lld para %lld\n", custo_inicial, custo_tmp);
+            }
+            
+            if(custo_tmp < custo) {
+                custo = custo_tmp;
+                melhor_i = i;
+                melhor_j = j;
+            }
+        }
+        
+        //desfazendo os deslocamentos (o trio termina na posição j - 1)
+        for(int k = j - 1; k >= i + 3; k--) {
+            solucao[k] = solucao[k - 3];
+        }
+        solucao[i] = tmp1;
+        solucao[i + 1] = tmp2;
+        solucao[i + 2] = tmp3;
+    }
+    
+    if(melhor_i) {
+        aplicar_movimento(p, explorada, 4, melhor_i, melhor_j, custo, resultado);
+    }
+    
+    return custo;
+}
+
+/*
+ * Function: realizar_path_relinking
+ * -----------------------------------------------------------------------------
+ *   Implementação da estratégia Path Relinking que consiste basicamente em
+ *   gerar soluções intermediárias entre 2 caminhos, após cada solução
+ *   intermediária gerada contendo componentes da solução final uma busca local
+ *   é realizada, explorando a vizinhanção baseada em trocas simples entre 2
+ *   elementos, tentando melhorar a solução.
+ *
+ *   O elemento de destino de cada posição é localizado pelo índice de
+ *   posições da solução intermediária, sem percorrê-la.
+ *
+ *   s: solucionador com o problema e as opções de execução.
+ *   origem: caminho inicial.
+ *   destino: caminho de destino.
+ *   solucao_resultado: a melhor solução encontrada após a execução do path
+ *   relinking (pode ser a própria origem).
+ *
+ *   returns: custo da solução resultado.
+ */
+long long realizar_path_relinking(struct solucionador* s, struct solucao* origem, struct solucao* destino, struct solucao* solucao_resultado) {
+    struct problema* p = &s->problema;
+    long long custo;
+    long long custo_destino;
+    long long custo_tmp;
+    struct solucao* origem_tmp;
+    struct solucao* solucao_swap_tmp;
+    struct solucao* melhor;
+    int* lista_restrita;
+    int melhorou = FALSE;
+    
+    custo_destino = custo_solucao(p, destino);
+    custo = custo_solucao(p, origem);
+    
+    solucao_swap_tmp = criar_solucao(p, NULL);
+    origem_tmp = criar_solucao(p, NULL);
+    duplicar_solucao(p, origem, origem_tmp);
+    duplicar_solucao(p, destino, solucao_resultado);
+    melhor = solucao_resultado;
+    lista_restrita = inicializar_solucao(p->tamanho, NULL);
+    
+    for(int i = 0; i <= p->tamanho; i++) {
+        lista_restrita[i] = 0;
+    }
+    
+    for(int i = 1; i < p->tamanho && custo > s->opcoes.alvo; i++) {
+        if(destino->elementos[i] == origem_tmp->elementos[i]) {
+            lista_restrita[i] = 1;
+            continue;
+        }
+        
+        trocar_elementos(origem_tmp, i, origem_tmp->posicoes[destino->elementos[i]]);
+        
+        lista_restrita[i] = 1;
+        
+        do {
+            custo_tmp = realizar_swap_restrito(s, origem_tmp, solucao_swap_tmp, lista_restrita);
+            
+            if(custo_tmp < custo) {
+                custo = custo_tmp;
+                trocar_solucoes(&melhor, &solucao_swap_tmp);
+                melhorou = TRUE;
+            }
+        } while(custo_tmp < custo);
+    }
+    
+    if(melhor != solucao_resultado) {
+        duplicar_solucao(p, melhor, solucao_resultado);
+        solucao_swap_tmp = melhor;
+    }
+    
+    liberar_solucao(origem_tmp);
+    liberar_solucao(solucao_swap_tmp);
+    free(lista_restrita);
+    
+    return melhorou ? custo : custo_destino;
+}
+
+/*
+ * Function: localizar_elemento
+ * -----------------------------------------------------------------------------
+ *   Implementação da estratégia Path Relinking que consiste basicamente em
+ *   gerar soluções intermediárias entre 2 caminhos, após cada solução
+ *   intermediária gerada contendo componentes da solução final uma busca local
+ *   é realizada, explorando a vizinhanção baseada em trocas simples entre 2
+ *   elementos, tentando melhorar a solução.
+ *
+ *   solucao: solução que será analisada em busca do elemento.
+ *   tamanho: tamanho da solução.
+ *   valor: valor que será pesquisado na solução.
+ *   posicao_inicial: posição que a busca será iniciada.
+ *
+ *   returns: posição do valor informado e caso não seja encontrado o valor -1
+ *   é retornado.
+ */
+int localizar_elemento(int* solucao, int tamanho, int valor, int posicao_inicial) {
+    int i = posicao_inicial;
+    
+    for(; i < tamanho; i++) {
+        if(solucao[i] == valor) {
+            return i;
+        }
+    }
+    
+    return -1;
+}
+
+/*
+ * Function: realizar_swap_restrito
+ * -----------------------------------------------------------------------------
+ *   Método auxiliar para a execuçao do método Path Relinking. O movimento de
+ *   troca deve ser realizado apenas nos elementos que não são referentes a
+ *   solução destino.
+ *
+ *   s: solucionador com o problema e as opções de execução.
+ *   explorada: solução que terá sua vizinhança explorada (o custo é
+ *   calculado apenas quando ainda não é conhecido).
+ *   resultado: a melhor solução encontrada após a execução do método.
+ *   lista_restrita: lista de elementos que não podem ter suas posições alteradas.
+ *   consiste em um vetor de inteiros onde cada posição é marcada como 0 (não é
+ *   restrita, ou seja pode ser alterada) ou 1 (é restrita, ou seja, não pode
+ *   ser alterada).
+ *
+ *   returns: custo da solução resultado, que recebe a melhor troca encontrada
+ *   ou uma cópia da solução explorada quando nenhuma troca a melhora.
+ */
+long long realizar_swap_restrito(struct solucionador* s, struct solucao* explorada, struct solucao* resultado, int* lista_restrita) {
+    struct problema* p = &s->problema;
+    int* solucao = explorada->elementos;
+    int i,j;
+    int melhor_i = 0;
+    int melhor_j = 0;
+    long long custo, custo_tmp, custo_inicial;
+    int tmp;
+    
+    custo_inicial = custo = custo_solucao(p, explorada);
+    
+    if(s->opcoes.debug && s->opcoes.debug_caminhos) {
+        printf("\nTentando localizar melhor vizinho na vizinhanca swap\n");
+        imprimir_solucao(p->tamanho, solucao);
+        linha();
+    }
+    
+    for(i = 1; i < p->tamanho; i++) {
+        if(lista_restrita[i]) {
+            continue;
+        }
+        
+        for(j = i + 1; j < p->tamanho; j++) {
+            if(lista_restrita[j]) {
+                continue;
+            }
+            
+            tmp = solucao[i];
+            solucao[i] = solucao[j];
+            solucao[j] = tmp;
+            
+            custo_tmp = calcular_custo(p, solucao);
+            
+            if(s->opcoes.debug && s->opcoes.debug_caminhos) {
+                imprimir_solucao(p->tamanho, solucao);
+                printf("de %lld para %lld\n", custo_inicial, custo_tmp);
+            }
+            
+            //desfazendo o movimento
+            solucao[j] = solucao[i];
+            solucao[i] = tmp;
+            
+            if(custo_tmp < custo) {
+                custo = custo_tmp;
+                melhor_i = i;
+                melhor_j = j;
+            }
+        }
+    }
+    
+    if(melhor_i) {
+        aplicar_movimento(p, explorada, 0, melhor_i, melhor_j, custo, resultado);
+    } else {
+        duplicar_solucao(p, explorada, resultado);
+    }
+    
+    return custo;
+}
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções auxiliares.
+// * -----------------------------------------------------------------------------
+
+/*
+ * Function: selection_sort
+ * -----------------------------------------------------------------------------
+ *   Função auxiliar que implementa do método de ordenação selecion sort.
+ *
+ *   array: vetor que será ordenado.
+ *   n: tamanho do vetor.
+ */
+void selection_sort(struct nodo* array, int n) {
+    int i, j;
+    int min;
+    struct nodo temp;
+    
+    for(i = 0; i < n - 1; i++) {
+        min=i;
+        for(j = i + 1; j < n; j++) {
+            if(array[j].valor < array[min].valor) {
+                min = j;
+            }
+        }
+        
+        temp = array[i];
+        array[i] = array[min];
+        array[min] = temp;
+    }
+}
+
+/*
+ * Function: copiar_solucao
+ * -----------------------------------------------------------------------------
+ *   Função auxiliar que copia uma soluçao de origem para uma solução de destino.
+ *   Os ponteiros precisam ter sido alocados previamente.
+ *
+ *   n: tamanho da solução.
+ *   origem: solução de origem.
+ *   destino: tamanho dos vetores.
+ */
+void copiar_solucao(int n, int* origem, int* destino) {
+    int i;
+    
+    for(i = 0; i < n + 1; i++) {
+        destino[i] = origem[i];
+    }
+}
+
+/*
+ * Function: trocar_solucoes
+ * -----------------------------------------------------------------------------
+ *   Troca os buffers de duas soluções. Aceitar uma solução candidata é feito
+ *   trocando os ponteiros da solução corrente e da candidata, sem copiar os
+ *   elementos; a cópia para o buffer do chamador ocorre uma única vez, ao
+ *   término da busca.
+ *
+ *   a: ponteiro para a primeira solução.
+ *   b: ponteiro para a segunda solução.
+ */
+void trocar_solucoes(struct solucao** a, struct solucao** b) {
+    struct solucao* tmp = *a;
+    
+    *a = *b;
+    *b = tmp;
+}
+
+/*
+ * Function: inicializar_solucao
+ * -----------------------------------------------------------------------------
+ *   Função auxiliar que inicializa um ponteiro com uma nova solução.
+ *
+ *   n: tamanho da solução.
+ *   solucao_base: solução que será baseada para a nova solução.
+ *
+ *   returns: um ponteiro alocado contendo uma soluçao base.
+ */
+int* inicializar_solucao(int n, int* solucao_base) {
+    int* nova_solucao;
+    
+    nova_solucao = malloc((n + 1) * sizeof(int));
+    
+    if(solucao_base) {
+        copiar_solucao(n, solucao_base, nova_solucao);
+    }
+    
+    return nova_solucao;
+    
+}
+
+/*
+ * Function: rnd
+ * -----------------------------------------------------------------------------
+ *   Gera um número aleatório entre 2 inteiros.
+ *
+ *   s: solucionador que mantém o estado do gerador.
+ *   min: limite inferior.
+ *   max: limite superior.
+ *
+ *   returns um número aleatório.
+ */
+int rnd(struct solucionador* s, int min, int max) {
+    min = ceil(min);
+    max = floor(max);
+    
+    return floor(aleatorio(s) % (max + 1 - min)) + min;
+}
+
+/*
+ * Function: semear
+ * -----------------------------------------------------------------------------
+ *   Inicializa o gerador de números aleatórios. O estado do gerador é mantido
+ *   explicitamente em cada solucionador (ao invés de utilizar rand) para que
+ *   possa ser gravado nos checkpoints e para que execuções em threads
+ *   diferentes não compartilhem estado.
+ *
+ *   s: solucionador que mantém o estado do gerador.
+ *   semente: semente do gerador.
+ */
+void semear(struct solucionador* s, unsigned long long semente) {
+    s->estado_aleatorio = semente * 0x9E3779B97F4A7C15ULL + 0x2545F4914F6CDD1DULL;
+    
+    if(!s->estado_aleatorio) {
+        s->estado_aleatorio = 1;
+    }
+}
+
+/*
+ * Function: aleatorio
+ * -----------------------------------------------------------------------------
+ *   Gera um número pseudoaleatório não negativo de 31 bits (xorshift64*).
+ *
+ *   s: solucionador que mantém o estado do gerador.
+ *
+ *   returns: um número aleatório entre 0 e INT_MAX.
+ */
+int aleatorio(struct solucionador* s) {
+    return sortear(&s->estado_aleatorio);
+}
+
+/*
+ * Function: sortear
+ * -----------------------------------------------------------------------------
+ *   Gera um número aleatório não negativo a partir de um estado explícito do
+ *   gerador xorshift64*, utilizado por aleatorio e pelos geradores próprios
+ *   de cada solução da construção em lote.
+ *
+ *   estado: estado do gerador (não nulo), atualizado a cada chamada.
+ *
+ *   returns: um número aleatório.
+ */
+int sortear(unsigned long long* estado) {
+    unsigned long long x = *estado;
+    
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *estado = x;
+    
+    return (int) ((x * 0x2545F4914F6CDD1DULL) >> 33);
+}
+
+/*
+ * Function: imprimir_solucao
+ * -----------------------------------------------------------------------------
+ *   Função auxiliar que imprime uma solução na tela.
+ *
+ *   n: tamanho da solução.
+ *   origem: solução que será impressa na tela.
+ */
+void imprimir_solucao(int n, int* solucao) {
+    int i;
+    
+    for(i = 0; i <= n; i++) {
+        printf("%d ", solucao[i]);
+    }
+    printf("\n");
+}
+
+/*
+ * Function: relogio
+ * -----------------------------------------------------------------------------
+ *   Retorna o tempo de relógio em segundos, medido por um relógio monotônico
+ *   de alta resolução. Ao contrário de clock(), não soma o tempo de
+ *   processador das demais threads do processo.
+ */
+double relogio(void) {
+    struct timespec t;
+    
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+/*
+ * Function: tempo_esgotado
+ * -----------------------------------------------------------------------------
+ *   Verifica se a execução corrente do solucionador ultrapassou o tempo
+ *   máximo das opções (0 indica que não há limite).
+ *
+ *   s: solucionador em execução.
+ */
+int tempo_esgotado(struct solucionador* s) {
+    return s->opcoes.tempo_maximo > 0 && relogio() - s->inicio >= s->opcoes.tempo_maximo;
+}
+
+/*
+ * Function: linha
+ * -----------------------------------------------------------------------------
+ *   Função auxiliar que imprime uma linha na tela.
+ */
+void linha(void) {
+    int i;
+    printf("\n");
+    for(i = 0; i < 80; i++) printf("_");
+    printf("\n");
+}
@@ -0,0 +1,124 @@
+#ifndef gvns_h
+#define gvns_h
+
+// * -----------------------------------------------------------------------------
+// * Interface pública da biblioteca do método GVNS: representação do problema,
+// * opções de execução e solucionador. As estruturas internas da busca e dos
+// * modos do programa são declaradas em interno.h e modos.h.
+// * -----------------------------------------------------------------------------
+
+#define TRUE 1
+#define FALSE 0
+
+// * -----------------------------------------------------------------------------
+// * Tipos de distância suportados. Instâncias no formato TSPLIB com coordenadas
+// * guardam apenas as coordenadas dos elementos e calculam as distâncias sob
+// * demanda quando possuem mais de TAMANHO_MAXIMO_MATRIZ elementos,
+// * opcionalmente com um cache de distâncias (ver opcoes.linhas_cache).
+// * -----------------------------------------------------------------------------
+#define DISTANCIA_MATRIZ 0
+#define DISTANCIA_EUC_2D 1
+#define DISTANCIA_CEIL_2D 2
+#define DISTANCIA_ATT 3
+#define TAMANHO_MAXIMO_MATRIZ 4096
+
+// * -----------------------------------------------------------------------------
+// * Códigos de erro retornados pelas funções da biblioteca, que não exibem
+// * mensagens nem encerram o programa (ver descrever_erro).
+// * -----------------------------------------------------------------------------
+#define ERRO_ABERTURA 1
+#define ERRO_FORMATO 2
+#define ERRO_DISTANCIA 3
+#define ERRO_MEMORIA 4
+#define ERRO_CHECKPOINT 5
+#define ERRO_SOLUCAO 6
+#define ERRO_ALTERACOES 7
+
+// * -----------------------------------------------------------------------------
+// * Modos da varredura unificada do VND (ver opcoes.varredura_unificada): é
+// * aplicado o melhor movimento da primeira vizinhança que melhora a solução
+// * (mesmo resultado do VND sequencial) ou o melhor movimento entre todas as
+// * vizinhanças.
+// * -----------------------------------------------------------------------------
+#define VARREDURA_POR_VIZINHANCA 1
+#define VARREDURA_MELHOR_GERAL 2
+
+// * -----------------------------------------------------------------------------
+// * Estrutura de dados básicas para representar em memória o problema tratado.
+// * A estrutura problema é somente leitura durante a busca e pode ser
+// * compartilhada entre solucionadores executados em threads diferentes.
+// * -----------------------------------------------------------------------------
+struct cache_distancias;
+struct kernel_custo;
+struct contexto;
+
+struct problema {
+    int tamanho;
+    int** elementos;
+    int tipo_distancia;
+    double* coordenada_x;
+    double* coordenada_y;
+    struct cache_distancias* cache;
+    void* matriz_compacta;
+    int passo;
+    const struct kernel_custo* kernel;
+    struct contexto* contexto;
+    int paginas_grandes;
+};
+
+// * -----------------------------------------------------------------------------
+// * Opções de execução do método e solucionador, cujo estado é interno à
+// * biblioteca. Todo o estado mutável da busca pertence ao solucionador, de
+// * forma que solucionadores distintos possam ser utilizados simultaneamente
+// * em threads diferentes.
+// * -----------------------------------------------------------------------------
+struct checkpoint;
+struct incumbente;
+struct solucionador;
+
+struct opcoes {
+    int iteracoes;
+    int vizinhancas;
+    int construcao_aleatoria;
+    long long alvo;
+    double tempo_maximo;
+    int linhas_cache;
+    int busca_localizada;
+    int varredura_unificada;
+    int tabela_ganhos;
+    int avaliacao_vetorial;
+    int construcoes;
+    int elite;
+    int threads_construcao;
+    int paginas_grandes;
+    int debug;
+    int debug_caminhos;
+    struct checkpoint* checkpoint;
+    int* solucao_inicial;
+    int* posicoes_afetadas;
+    int quantidade_afetadas;
+    struct incumbente* incumbente;
+    void (*ao_melhorar)(long long custo, int* solucao, int tamanho, void* dados);
+    int (*receber_incumbente)(int* solucao, long long* custo, void* dados);
+    void* dados;
+};
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções da interface do solucionador.
+// * -----------------------------------------------------------------------------
+void inicializar_opcoes(struct opcoes*);
+struct solucionador* criar_solucionador(struct problema*, struct opcoes*);
+long long executar_gvns(struct solucionador*, unsigned long long, int*);
+void liberar_solucionador(struct solucionador*);
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções de leitura e representação do problema.
+// * -----------------------------------------------------------------------------
+int ler_arquivo(struct problema*, char*, int);
+int inicializar_problema(struct problema*, int, const int*, int);
+int preparar_contexto(struct problema*, char*);
+long long calcular_custo(struct problema*, int*);
+void liberar_problema(struct problema*);
+const char* descrever_erro(int);
+
+#endif /* gvns_h */
@@ -0,0 +1,492 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+
+#include "interno.h"
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções da reotimização a partir de uma solução conhecida.
+// *
+// * A solução de uma execução anterior é adaptada às alterações da instância
+// * (elementos removidos são retirados da solução e elementos inseridos são
+// * incluídos pela inserção mais barata) e a busca parte dela, começando por
+// * um VND restrito às posições afetadas pelas alterações.
+// *
+// * Arquivo de alterações: uma operação por linha, aplicadas em ordem sobre a
+// * instância já alterada pelas linhas anteriores. Linhas vazias e iniciadas
+// * por # são ignoradas.
+// *   ALTERAR i j d               a distância de i para j passa a ser d
+// *   INSERIR d_0 ... d_n-1 [e_0 ... e_n-1]
+// *                               insere o elemento n, com as distâncias d_j
+// *                               dele para cada elemento j e e_j de cada
+// *                               elemento j para ele (iguais a d_j quando
+// *                               omitidas)
+// *   REMOVER k                   remove o elemento k (k > 0); os elementos
+// *                               seguintes são renumerados (k + 1 passa a ser
+// *                               k e assim por diante)
+// * -----------------------------------------------------------------------------
+
+struct alteracao {
+    int tamanho;
+    int* matriz;
+    int* rota;
+    int tamanho_rota;
+    int* pendentes;
+    int quantidade_pendentes;
+    char* afetados;
+};
+
+/*
+ * Function: ler_solucao_arquivo
+ * -----------------------------------------------------------------------------
+ *   Lê uma solução de um arquivo com os elementos separados por espaços ou
+ *   quebras de linha, iniciada pela origem (0). O retorno à origem ao final
+ *   é opcional.
+ *
+ *   arquivo: arquivo da solução.
+ *   tamanho: tamanho do problema.
+ *   erro: recebe 0 em caso de sucesso, ERRO_ABERTURA, ERRO_MEMORIA ou
+ *   ERRO_SOLUCAO caso o arquivo não contenha uma solução válida para o
+ *   problema.
+ *
+ *   returns: a solução lida (tamanho + 1 posições) ou NULL em caso de erro.
+ */
+int* ler_solucao_arquivo(char* arquivo, int tamanho, int* erro) {
+    FILE* fp = fopen(arquivo, "r");
+    int* solucao;
+    char* presente;
+    int quantidade = 0;
+    int elemento;
+    int valida = TRUE;
+    
+    if(!fp) {
+        *erro = ERRO_ABERTURA;
+        return NULL;
+    }
+    
+    solucao = malloc((tamanho + 1) * sizeof(int));
+    presente = calloc(tamanho, sizeof(char));
+    
+    if(!solucao || !presente) {
+        fclose(fp);
+        free(solucao);
+        free(presente);
+        *erro = ERRO_MEMORIA;
+        return NULL;
+    }
+    
+    while(valida && fscanf(fp, "%d", &elemento) == 1) {
+        //o retorno à origem encerra a solução
+        if(quantidade == tamanho && elemento == 0) {
+            break;
+        }
+        
+        valida = quantidade < tamanho && elemento >= 0 && elemento < tamanho && !presente[elemento] && (quantidade > 0 || elemento == 0);
+        
+        if(valida) {
+            presente[elemento] = TRUE;
+            solucao[quantidade++] = elemento;
+        }
+    }
+    
+    fclose(fp);
+    free(presente);
+    
+    if(!valida || quantidade != tamanho) {
+        free(solucao);
+        *erro = ERRO_SOLUCAO;
+        return NULL;
+    }
+    
+    solucao[tamanho] = 0;
+    *erro = 0;
+    
+    return solucao;
+}
+
+/*
+ * Function: gravar_solucao_arquivo
+ * -----------------------------------------------------------------------------
+ *   Grava uma solução no formato lido por ler_solucao_arquivo.
+ *
+ *   arquivo: arquivo da solução.
+ *   tamanho: tamanho do problema.
+ *   solucao: solução gravada.
+ *
+ *   returns: TRUE caso a solução tenha sido gravada.
+ */
+int gravar_solucao_arquivo(char* arquivo, int tamanho, int* solucao) {
+    FILE* fp = fopen(arquivo, "w");
+    
+    if(!fp) {
+        return FALSE;
+    }
+    
+    for(int i = 0; i <= tamanho; i++) {
+        fprintf(fp, i < tamanho ? "%d " : "%d\n", solucao[i]);
+    }
+    
+    return fclose(fp) == 0;
+}
+
+/*
+ * Function: remover_elemento
+ * -----------------------------------------------------------------------------
+ *   Remove um elemento da instância alterada e da rota, marcando como
+ *   afetados os seus vizinhos na rota, que passam a ser ligados por um novo
+ *   arco. Os elementos seguintes são renumerados.
+ *
+ *   a: alteração em andamento.
+ *   k: elemento removido.
+ *
+ *   returns: 0 em caso de sucesso ou ERRO_MEMORIA, com a alteração inalterada.
+ */
+static int remover_elemento(struct alteracao* a, int k) {
+    int n = a->tamanho;
+    int* matriz = malloc((size_t) (n - 1) * (n - 1) * sizeof(int));
+    int posicao = -1;
+    int destino = 0;
+    
+    if(!matriz) {
+        return ERRO_MEMORIA;
+    }
+    
+    for(int i = 0; i < a->tamanho_rota; i++) {
+        if(a->rota[i] == k) {
+            posicao = i;
+        }
+    }
+    
+    if(posicao >= 0) {
+        a->afetados[a->rota[posicao - 1]] = TRUE;
+        a->afetados[a->rota[(posicao + 1) % a->tamanho_rota]] = TRUE;
+        
+        memmove(a->rota + posicao, a->rota + posicao + 1, (a->tamanho_rota - posicao - 1) * sizeof(int));
+        a->tamanho_rota--;
+    } else {
+        for(int i = 0; i < a->quantidade_pendentes; i++) {
+            if(a->pendentes[i] == k) {
+                memmove(a->pendentes + i, a->pendentes + i + 1, (a->quantidade_pendentes - i - 1) * sizeof(int));
+                a->quantidade_pendentes--;
+                break;
+            }
+        }
+    }
+    
+    for(int i = 0; i < n; i++) {
+        for(int j = 0; j < n; j++) {
+            if(i != k && j != k) {
+                matriz[destino++] = a->matriz[(size_t) i * n + j];
+            }
+        }
+    }
+    
+    free(a->matriz);
+    a->matriz = matriz;
+    
+    memmove(a->afetados + k, a->afetados + k + 1, n - k - 1);
+    
+    for(int i = 0; i < a->tamanho_rota; i++) {
+        a->rota[i] -= a->rota[i] > k;
+    }
+    
+    for(int i = 0; i < a->quantidade_pendentes; i++) {
+        a->pendentes[i] -= a->pendentes[i] > k;
+    }
+    
+    a->tamanho = n - 1;
+    
+    return 0;
+}
+
+/*
+ * Function: inserir_elemento
+ * -----------------------------------------------------------------------------
+ *   Insere um novo elemento, com o índice a->tamanho, na instância alterada.
+ *   O elemento é incluído na rota apenas ao término das alterações (ver
+ *   incluir_pendentes).
+ *
+ *   a: alteração em andamento.
+ *   saida: distâncias do novo elemento para cada elemento.
+ *   entrada: distâncias de cada elemento para o novo elemento.
+ *
+ *   returns: 0 em caso de sucesso ou ERRO_MEMORIA, com a alteração inalterada.
+ */
+static int inserir_elemento(struct alteracao* a, int* saida, int* entrada) {
+    int n = a->tamanho;
+    int* matriz = malloc((size_t) (n + 1) * (n + 1) * sizeof(int));
+    int* rota = realloc(a->rota, (n + 1) * sizeof(int));
+    int* pendentes;
+    char* afetados;
+    
+    //as tabelas ampliadas com sucesso permanecem válidas para a alteração
+    if(rota) {
+        a->rota = rota;
+    }
+    
+    pendentes = rota ? realloc(a->pendentes, (a->quantidade_pendentes + 1) * sizeof(int)) : NULL;
+    
+    if(pendentes) {
+        a->pendentes = pendentes;
+    }
+    
+    afetados = pendentes ? realloc(a->afetados, n + 1) : NULL;
+    
+    if(afetados) {
+        a->afetados = afetados;
+    }
+    
+    if(!matriz || !afetados) {
+        free(matriz);
+        return ERRO_MEMORIA;
+    }
+    
+    for(int i = 0; i < n; i++) {
+        memcpy(matriz + (size_t) i * (n + 1), a->matriz + (size_t) i * n, n * sizeof(int));
+        matriz[(size_t) i * (n + 1) + n] = entrada[i];
+        matriz[(size_t) n * (n + 1) + i] = saida[i];
+    }
+    matriz[(size_t) n * (n + 1) + n] = 0;
+    
+    free(a->matriz);
+    a->matriz = matriz;
+    
+    a->pendentes[a->quantidade_pendentes++] = n;
+    a->afetados[n] = TRUE;
+    
+    a->tamanho = n + 1;
+    
+    return 0;
+}
+
+/*
+ * Function: aplicar_alteracoes
+ * -----------------------------------------------------------------------------
+ *   Aplica as operações do arquivo de alterações (ver o formato no início
+ *   deste bloco).
+ *
+ *   a: alteração em andamento.
+ *   arquivo: arquivo de alterações.
+ *
+ *   returns: 0 caso todas as operações tenham sido aplicadas, ERRO_ABERTURA,
+ *   ERRO_MEMORIA ou ERRO_ALTERACOES na primeira operação inválida.
+ */
+static int aplicar_alteracoes(struct alteracao* a, char* arquivo) {
+    FILE* fp = fopen(arquivo, "r");
+    char* linha = NULL;
+    size_t capacidade = 0;
+    int erro = 0;
+    int* valores = NULL;
+    int* ampliados;
+    int quantidade;
+    int lidos;
+    int i, j, d;
+    char* texto;
+    
+    if(!fp) {
+        return ERRO_ABERTURA;
+    }
+    
+    while(!erro && getline(&linha, &capacidade, fp) > 0) {
+        texto = linha;
+        
+        while(*texto == ' ' || *texto == '\t') {
+            texto++;
+        }
+        
+        if(*texto == '#' || *texto == '\n' || *texto == '\r' || *texto == '\0') {
+            continue;
+        }
+        
+        if(sscanf(texto, "ALTERAR %d %d %d", &i, &j, &d) == 3) {
+            if(i >= 0 && i < a->tamanho && j >= 0 && j < a->tamanho) {
+                a->matriz[(size_t) i * a->tamanho + j] = d;
+                a->afetados[i] = TRUE;
+                a->afetados[j] = TRUE;
+            } else {
+                erro = ERRO_ALTERACOES;
+            }
+        } else if(sscanf(texto, "REMOVER %d", &i) == 1) {
+            erro = i > 0 && i < a->tamanho ? remover_elemento(a, i) : ERRO_ALTERACOES;
+        } else if(strncmp(texto, "INSERIR", 7) == 0) {
+            ampliados = realloc(valores, 2 * (size_t) a->tamanho * sizeof(int));
+            
+            if(!ampliados) {
+                erro = ERRO_MEMORIA;
+                break;
+            }
+            
+            valores = ampliados;
+            texto += 7;
+            quantidade = 0;
+            
+            while(quantidade < 2 * a->tamanho && sscanf(texto, "%d%n", &valores[quantidade], &lidos) == 1) {
+                texto += lidos;
+                quantidade++;
+            }
+            
+            if(quantidade == a->tamanho || quantidade == 2 * a->tamanho) {
+                erro = inserir_elemento(a, valores, quantidade == a->tamanho ? valores : valores + a->tamanho);
+            } else {
+                erro = ERRO_ALTERACOES;
+            }
+        } else {
+            erro = ERRO_ALTERACOES;
+        }
+    }
+    
+    fclose(fp);
+    free(linha);
+    free(valores);
+    
+    return erro;
+}
+
+/*
+ * Function: incluir_pendentes
+ * -----------------------------------------------------------------------------
+ *   Inclui na rota, na ordem de inserção, os elementos inseridos pelas
+ *   alterações, cada um na posição de menor aumento do custo.
+ *
+ *   Inserir x entre as posições k e k + 1 de uma rota com m elementos soma 1
+ *   ao peso dos k arcos anteriores, substitui o arco (k, k + 1), de peso
+ *   m - k, pelos arcos (k, x) e (x, k + 1), de pesos m + 1 - k e m - k, e
+ *   mantém o peso dos arcos seguintes. Com a soma acumulada dos arcos
+ *   anteriores, cada posição é avaliada em O(1).
+ *
+ *   p: problema já alterado.
+ *   a: alteração em andamento.
+ */
+static void incluir_pendentes(struct problema* p, struct alteracao* a) {
+    int* rota = a->rota;
+    int m;
+    int x;
+    int melhor_posicao;
+    long long anteriores;
+    long long aumento;
+    long long melhor;
+    int arco;
+    
+    for(int t = 0; t < a->quantidade_pendentes; t++) {
+        x = a->pendentes[t];
+        m = a->tamanho_rota;
+        anteriores = 0;
+        melhor = LLONG_MAX;
+        melhor_posicao = 0;
+        
+        for(int k = 0; k < m; k++) {
+            arco = distancia(p, rota[k], rota[(k + 1) % m]);
+            aumento = anteriores + (long long) distancia(p, rota[k], x) * (m + 1 - k) + (long long) distancia(p, x, rota[(k + 1) % m]) * (m - k) - (long long) arco * (m - k);
+            
+            if(aumento < melhor) {
+                melhor = aumento;
+                melhor_posicao = k;
+            }
+            
+            anteriores += arco;
+        }
+        
+        memmove(rota + melhor_posicao + 2, rota + melhor_posicao + 1, (m - melhor_posicao - 1) * sizeof(int));
+        rota[melhor_posicao + 1] = x;
+        a->tamanho_rota++;
+    }
+    
+    a->quantidade_pendentes = 0;
+}
+
+/*
+ * Function: preparar_reotimizacao
+ * -----------------------------------------------------------------------------
+ *   Lê a solução inicial e, quando informado, aplica o arquivo de alterações
+ *   ao problema e à solução. O problema é substituído pela instância alterada
+ *   (apenas com a matriz de adjacência) e as posições da solução afetadas
+ *   pelas alterações são retornadas para o VND inicial (ver executar_gvns).
+ *
+ *   p: estrutura de dados representando o problema.
+ *   arquivo_solucao: arquivo da solução inicial.
+ *   arquivo_alteracoes: arquivo de alterações (NULL para nenhuma).
+ *   afetadas: recebe as posições afetadas (NULL sem alterações).
+ *   quantidade: recebe a quantidade de posições afetadas.
+ *   erro: recebe 0 em caso de sucesso ou o código do erro (ver
+ *   ler_solucao_arquivo e aplicar_alteracoes). As alterações exigem a matriz
+ *   de adjacência em memória (ERRO_ALTERACOES caso contrário).
+ *
+ *   returns: a solução inicial para o problema (p->tamanho + 1 posições) ou
+ *   NULL em caso de erro.
+ */
+int* preparar_reotimizacao(struct problema* p, char* arquivo_solucao, char* arquivo_alteracoes, int** afetadas, int* quantidade, int* erro) {
+    struct alteracao a;
+    int* solucao = ler_solucao_arquivo(arquivo_solucao, p->tamanho, erro);
+    
+    *afetadas = NULL;
+    *quantidade = 0;
+    
+    if(!solucao || !arquivo_alteracoes) {
+        return solucao;
+    }
+    
+    if(!p->elementos) {
+        free(solucao);
+        *erro = ERRO_ALTERACOES;
+        return NULL;
+    }
+    
+    a.tamanho = p->tamanho;
+    a.matriz = malloc((size_t) p->tamanho * p->tamanho * sizeof(int));
+    a.rota = solucao;
+    a.tamanho_rota = p->tamanho;
+    a.pendentes = NULL;
+    a.quantidade_pendentes = 0;
+    a.afetados = calloc(p->tamanho, sizeof(char));
+    
+    if(!a.matriz || !a.afetados) {
+        *erro = ERRO_MEMORIA;
+    } else {
+        memcpy(a.matriz, p->elementos[0], (size_t) p->tamanho * p->tamanho * sizeof(int));
+        *erro = aplicar_alteracoes(&a, arquivo_alteracoes);
+    }
+    
+    if(!*erro) {
+        liberar_problema(p);
+        *erro = inicializar_problema(p, a.tamanho, a.matriz, p->paginas_grandes);
+    }
+    
+    if(*erro) {
+        free(a.matriz);
+        free(a.rota);
+        free(a.pendentes);
+        free(a.afetados);
+        return NULL;
+    }
+    
+    incluir_pendentes(p, &a);
+    
+    solucao = realloc(a.rota, (p->tamanho + 1) * sizeof(int));
+    *afetadas = malloc(p->tamanho * sizeof(int));
+    
+    if(!solucao || !*afetadas) {
+        free(solucao ? solucao : a.rota);
+        free(*afetadas);
+        *afetadas = NULL;
+        free(a.matriz);
+        free(a.pendentes);
+        free(a.afetados);
+        *erro = ERRO_MEMORIA;
+        return NULL;
+    }
+    
+    solucao[p->tamanho] = 0;
+    
+    for(int k = 0; k < p->tamanho; k++) {
+        if(a.afetados[solucao[k]]) {
+            (*afetadas)[(*quantidade)++] = k;
+        }
+    }
+    
+    free(a.matriz);
+    free(a.pendentes);
+    free(a.afetados);
+    
+    return solucao;
+}
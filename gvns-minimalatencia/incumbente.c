@@ -0,0 +1,229 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+
+#include "interno.h"
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções do acesso concorrente à solução incumbente.
+// *
+// * A busca publica a solução incumbente a cada melhora (ver gvns) e outras
+// * threads podem lê-la a qualquer momento, sem bloquear a busca: a
+// * sequência é incrementada antes e depois da escrita (ímpar enquanto a
+// * solução é escrita) e o leitor repete a cópia caso a sequência tenha
+// * mudado durante a leitura. Há um único escritor por vez, a thread que
+// * realiza as execuções. Os elementos da solução são acessados
+// * individualmente como atômicos relaxados, o que equivale a acessos comuns
+// * na maioria das arquiteturas.
+// * -----------------------------------------------------------------------------
+
+/*
+ * Function: criar_incumbente
+ * -----------------------------------------------------------------------------
+ *   Cria a área de publicação da solução incumbente, ainda sem solução.
+ *
+ *   tamanho: tamanho do problema.
+ *
+ *   returns: a área de publicação alocada.
+ */
+struct incumbente* criar_incumbente(int tamanho) {
+    struct incumbente* inc = malloc(sizeof(struct incumbente));
+    
+    atomic_init(&inc->sequencia, 0);
+    atomic_init(&inc->custo, LLONG_MAX);
+    atomic_init(&inc->execucao, -1);
+    inc->tamanho = tamanho;
+    inc->solucao = malloc((tamanho + 1) * sizeof(atomic_int));
+    
+    return inc;
+}
+
+/*
+ * Function: publicar_incumbente
+ * -----------------------------------------------------------------------------
+ *   Publica a solução caso ela seja melhor que a solução já publicada (as
+ *   execuções seguintes não substituem a melhor solução das anteriores).
+ *   Chamada apenas pela thread que realiza as execuções.
+ *
+ *   inc: área de publicação.
+ *   custo: custo da solução.
+ *   solucao: solução publicada (inc->tamanho + 1 posições).
+ *   execucao: índice da execução que encontrou a solução.
+ */
+void publicar_incumbente(struct incumbente* inc, long long custo, int* solucao, int execucao) {
+    unsigned int sequencia = atomic_load_explicit(&inc->sequencia, memory_order_relaxed);
+    
+    if(custo >= atomic_load_explicit(&inc->custo, memory_order_relaxed)) {
+        return;
+    }
+    
+    atomic_store_explicit(&inc->sequencia, sequencia + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    
+    for(int i = 0; i <= inc->tamanho; i++) {
+        atomic_store_explicit(&inc->solucao[i], solucao[i], memory_order_relaxed);
+    }
+    
+    atomic_store_explicit(&inc->custo, custo, memory_order_relaxed);
+    atomic_store_explicit(&inc->execucao, execucao, memory_order_relaxed);
+    
+    atomic_store_explicit(&inc->sequencia, sequencia + 2, memory_order_release);
+}
+
+/*
+ * Function: ler_incumbente
+ * -----------------------------------------------------------------------------
+ *   Lê uma cópia consistente da solução publicada, sem bloquear a busca. Pode
+ *   ser chamada de qualquer thread.
+ *
+ *   inc: área de publicação.
+ *   solucao: recebe a solução (inc->tamanho + 1 posições); NULL para ler
+ *   apenas o custo e a execução.
+ *   custo: recebe o custo da solução.
+ *   execucao: recebe o índice da execução que encontrou a solução (NULL
+ *   quando não for necessário).
+ *
+ *   returns: TRUE caso alguma solução já tenha sido publicada.
+ */
+int ler_incumbente(struct incumbente* inc, int* solucao, long long* custo, int* execucao) {
+    unsigned int sequencia;
+    int indice;
+    
+    do {
+        sequencia = atomic_load_explicit(&inc->sequencia, memory_order_acquire);
+        
+        if(sequencia & 1) {
+            continue;
+        }
+        
+        for(int i = 0; solucao && i <= inc->tamanho; i++) {
+            solucao[i] = atomic_load_explicit(&inc->solucao[i], memory_order_relaxed);
+        }
+        
+        *custo = atomic_load_explicit(&inc->custo, memory_order_relaxed);
+        indice = atomic_load_explicit(&inc->execucao, memory_order_relaxed);
+        
+        atomic_thread_fence(memory_order_acquire);
+    } while((sequencia & 1) || sequencia != atomic_load_explicit(&inc->sequencia, memory_order_relaxed));
+    
+    if(execucao) {
+        *execucao = indice;
+    }
+    
+    return sequencia > 0;
+}
+
+/*
+ * Function: liberar_incumbente
+ * -----------------------------------------------------------------------------
+ *   Libera a área de publicação. Nenhuma thread pode estar lendo a solução.
+ *
+ *   inc: área de publicação.
+ */
+void liberar_incumbente(struct incumbente* inc) {
+    free(inc->solucao);
+    free(inc);
+}
+
+/*
+ * Function: exibir_progresso
+ * -----------------------------------------------------------------------------
+ *   Função executada pela thread de progresso: a cada intervalo exibe, na
+ *   saída de erros (a saída padrão mantém apenas o resultado), o custo da
+ *   solução incumbente publicada até o momento.
+ *
+ *   argumento: progresso em andamento (struct progresso).
+ *
+ *   returns: NULL.
+ */
+void* exibir_progresso(void* argumento) {
+    struct progresso* g = argumento;
+    struct timespec limite;
+    double proximo = g->inicio + g->intervalo;
+    double restante;
+    long long custo;
+    int execucao;
+    
+    pthread_mutex_lock(&g->mutex);
+    
+    while(!g->encerrar) {
+        //convertendo o instante monotônico para o relógio da condição
+        restante = proximo - relogio();
+        
+        if(restante < 0) {
+            restante = 0;
+        }
+        
+        clock_gettime(CLOCK_REALTIME, &limite);
+        limite.tv_sec += (time_t) restante;
+        limite.tv_nsec += (long) ((restante - (time_t) restante) * 1e9);
+        
+        if(limite.tv_nsec >= 1000000000) {
+            limite.tv_sec++;
+            limite.tv_nsec -= 1000000000;
+        }
+        
+        if(pthread_cond_timedwait(&g->condicao, &g->mutex, &limite) != ETIMEDOUT || g->encerrar) {
+            continue;
+        }
+        
+        proximo += g->intervalo;
+        
+        if(ler_incumbente(g->incumbente, NULL, &custo, &execucao)) {
+            fprintf(stderr, "Progresso (%.1fs): melhor custo %lld (execução %d)\n", relogio() - g->inicio, custo, execucao);
+        } else {
+            fprintf(stderr, "Progresso (%.1fs): construindo a solução inicial\n", relogio() - g->inicio);
+        }
+    }
+    
+    pthread_mutex_unlock(&g->mutex);
+    
+    return NULL;
+}
+
+/*
+ * Function: iniciar_progresso
+ * -----------------------------------------------------------------------------
+ *   Inicia a thread que exibe periodicamente o custo da solução incumbente.
+ *
+ *   inc: área de publicação lida pela thread.
+ *   intervalo: intervalo em segundos entre as exibições.
+ *
+ *   returns: o progresso em andamento.
+ */
+struct progresso* iniciar_progresso(struct incumbente* inc, double intervalo) {
+    struct progresso* g = malloc(sizeof(struct progresso));
+    
+    g->incumbente = inc;
+    g->intervalo = intervalo;
+    g->inicio = relogio();
+    g->encerrar = FALSE;
+    
+    pthread_mutex_init(&g->mutex, NULL);
+    pthread_cond_init(&g->condicao, NULL);
+    pthread_create(&g->thread, NULL, exibir_progresso, g);
+    
+    return g;
+}
+
+/*
+ * Function: finalizar_progresso
+ * -----------------------------------------------------------------------------
+ *   Encerra a thread de progresso.
+ *
+ *   g: progresso em andamento.
+ */
+void finalizar_progresso(struct progresso* g) {
+    pthread_mutex_lock(&g->mutex);
+    g->encerrar = TRUE;
+    pthread_cond_signal(&g->condicao);
+    pthread_mutex_unlock(&g->mutex);
+    
+    pthread_join(g->thread, NULL);
+    
+    pthread_mutex_destroy(&g->mutex);
+    pthread_cond_destroy(&g->condicao);
+    free(g);
+}
@@ -0,0 +1,175 @@
+//o macOS declara as funções de ucontext.h apenas no modo X/Open
+#ifdef __APPLE__
+#define _XOPEN_SOURCE 600
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <ucontext.h>
+
+#include "interno.h"
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções das execuções intercaladas.
+// *
+// * Uma única thread alterna entre várias execuções independentes do GVNS,
+// * cada uma com o seu solucionador e a sua pilha (corrotina). Antes de
+// * explorar uma vizinhança, a execução antecipa as distâncias dos primeiros
+// * arcos da solução explorada e cede a vez (ver ceder); enquanto essas
+// * distâncias são trazidas da memória, as demais execuções avançam. Cada
+// * execução utiliza a sua semente, como no modo serial, de forma que os
+// * resultados não dependem da intercalação.
+// * -----------------------------------------------------------------------------
+
+struct corrotina {
+    ucontext_t contexto;
+    ucontext_t* retorno;
+    char* pilha;
+    struct solucionador* solucionador;
+    int execucao;
+    int* solucao;
+    long long custo;
+    double tempo;
+    int concluida;
+};
+
+/*
+ * Function: executar_corrotina
+ * -----------------------------------------------------------------------------
+ *   Ponto de entrada da corrotina: realiza a execução atribuída e retorna ao
+ *   escalonador (uc_link). O endereço da corrotina é recebido em duas metades
+ *   de 32 bits, pois makecontext repassa apenas argumentos int.
+ *
+ *   alto: 32 bits mais significativos do endereço da corrotina.
+ *   baixo: 32 bits menos significativos do endereço da corrotina.
+ */
+static void executar_corrotina(unsigned int alto, unsigned int baixo) {
+    struct corrotina* c = (struct corrotina*) (((uintptr_t) alto << 16 << 16) | baixo);
+    
+    c->custo = executar_gvns(c->solucionador, c->execucao, c->solucao);
+    c->concluida = TRUE;
+}
+
+/*
+ * Function: iniciar_corrotina
+ * -----------------------------------------------------------------------------
+ *   Prepara a corrotina para realizar uma nova execução, reaproveitando o
+ *   seu solucionador e a sua pilha.
+ *
+ *   c: corrotina.
+ *   execucao: índice da execução (também a sua semente).
+ */
+static void iniciar_corrotina(struct corrotina* c, int execucao) {
+    uintptr_t endereco = (uintptr_t) c;
+    
+    c->execucao = execucao;
+    c->solucao = inicializar_solucao(c->solucionador->problema.tamanho, NULL);
+    c->custo = 0;
+    c->tempo = 0;
+    c->concluida = FALSE;
+    
+    getcontext(&c->contexto);
+    c->contexto.uc_stack.ss_sp = c->pilha;
+    c->contexto.uc_stack.ss_size = PILHA_CORROTINA;
+    c->contexto.uc_link = c->retorno;
+    makecontext(&c->contexto, (void (*)(void)) executar_corrotina, 2, (unsigned int) (endereco >> 16 >> 16), (unsigned int) endereco);
+}
+
+/*
+ * Function: executar_intercalado
+ * -----------------------------------------------------------------------------
+ *   Realiza as execuções primeira a execucoes - 1 intercalando até
+ *   intercaladas execuções em uma única thread. As execuções são retomadas
+ *   em rodízio e, ao término de uma delas, a próxima execução pendente ocupa
+ *   a sua corrotina. O tempo registrado de cada execução é a soma dos
+ *   intervalos em que ela esteve ativa.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   opcoes: opções de execução do método.
+ *   primeira: primeira execução realizada.
+ *   execucoes: quantidade total de execuções.
+ *   intercaladas: quantidade de execuções intercaladas.
+ *   informacoes: resultado de cada execução, na posição do seu índice.
+ */
+void executar_intercalado(struct problema* p, struct opcoes* opcoes, int primeira, int execucoes, int intercaladas, struct informacao_execucao* informacoes) {
+    ucontext_t escalonador;
+    struct corrotina* corrotinas;
+    struct corrotina* c;
+    int proxima = primeira;
+    int ativas = 0;
+    double inicio;
+    
+    if(intercaladas > execucoes - primeira) {
+        intercaladas = execucoes - primeira;
+    }
+    
+    if(intercaladas < 1) {
+        return;
+    }
+    
+    corrotinas = calloc(intercaladas, sizeof(struct corrotina));
+    
+    for(int k = 0; k < intercaladas; k++) {
+        c = &corrotinas[k];
+        c->retorno = &escalonador;
+        c->pilha = malloc(PILHA_CORROTINA);
+        c->solucionador = criar_solucionador(p, opcoes);
+        c->solucionador->corrotina = c;
+        
+        iniciar_corrotina(c, proxima++);
+        ativas++;
+    }
+    
+    while(ativas > 0) {
+        for(int k = 0; k < intercaladas; k++) {
+            c = &corrotinas[k];
+            
+            if(c->concluida) {
+                continue;
+            }
+            
+            inicio = relogio();
+            swapcontext(&escalonador, &c->contexto);
+            c->tempo += relogio() - inicio;
+            
+            if(!c->concluida) {
+                continue;
+            }
+            
+            informacoes[c->execucao].valor_encontrado = c->custo;
+            informacoes[c->execucao].tempo = c->tempo;
+            informacoes[c->execucao].solucao = c->solucao;
+            
+            if(proxima < execucoes) {
+                iniciar_corrotina(c, proxima++);
+            } else {
+                ativas--;
+            }
+        }
+    }
+    
+    for(int k = 0; k < intercaladas; k++) {
+        liberar_solucionador(corrotinas[k].solucionador);
+        free(corrotinas[k].pilha);
+    }
+    
+    free(corrotinas);
+}
+
+/*
+ * Function: ceder
+ * -----------------------------------------------------------------------------
+ *   Antecipa as distâncias dos primeiros arcos da solução que a execução
+ *   avaliará em seguida e devolve a vez ao escalonador. Chamada pela macro
+ *   CEDER apenas quando o solucionador pertence a uma corrotina.
+ *
+ *   s: solucionador da execução.
+ *   solucao: solução que será avaliada quando a execução for retomada.
+ */
+void ceder(struct solucionador* s, int* solucao) {
+    struct corrotina* c = s->corrotina;
+    
+    antecipar_custo(&s->problema, solucao, ANTECIPACAO_CORROTINA);
+    swapcontext(&c->contexto, c->retorno);
+}
@@ -0,0 +1,633 @@
+#ifndef interno_h
+#define interno_h
+
+#include <stdio.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "gvns.h"
+
+// * -----------------------------------------------------------------------------
+// * Limites de tamanho para o método exato (programação dinâmica). Abaixo de
+// * TAMANHO_MAXIMO_EXATO a instância é resolvida automaticamente pelo método
+// * exato; TAMANHO_LIMITE_EXATO é o maior tamanho aceito quando o método é
+// * solicitado explicitamente (a tabela ocupa 2^(n-1) * (n-1) inteiros).
+// * -----------------------------------------------------------------------------
+#define TAMANHO_MAXIMO_EXATO 20
+#define TAMANHO_LIMITE_EXATO 21
+
+// * -----------------------------------------------------------------------------
+// * Quantidade de distâncias de cada bloco do cache de distâncias.
+// * -----------------------------------------------------------------------------
+#define BLOCO_CACHE_DISTANCIAS 4
+
+// * -----------------------------------------------------------------------------
+// * Identificação do formato do arquivo de checkpoint, intervalo padrão (em
+// * segundos) entre as gravações e quantidade de parâmetros da busca gravados
+// * para validar a retomada (ver iniciar_checkpoint).
+// * -----------------------------------------------------------------------------
+#define CHECKPOINT_ASSINATURA "GVNSCKP2"
+#define CHECKPOINT_INTERVALO_PADRAO 60
+#define CHECKPOINT_PARAMETROS 10
+
+// * -----------------------------------------------------------------------------
+// * Identificação do formato do arquivo de contexto pré-processado.
+// * -----------------------------------------------------------------------------
+#define CONTEXTO_ASSINATURA "GVNSCTX1"
+
+// * -----------------------------------------------------------------------------
+// * Busca local localizada após o abalo. O abalo altera no máximo
+// * MAXIMO_POSICOES_ABALO posições da solução e o VND localizado avalia apenas
+// * os movimentos que envolvem posições a até RAIO_BUSCA_LOCALIZADA posições de
+// * distância das posições alteradas. A região cresce a cada melhora.
+// * -----------------------------------------------------------------------------
+#define MAXIMO_POSICOES_ABALO 6
+#define RAIO_BUSCA_LOCALIZADA 2
+#define MOVIMENTO_NA_REGIAO(regiao, i, j) (!(regiao) || (regiao)[i] || (regiao)[j])
+
+// * -----------------------------------------------------------------------------
+// * Abalos profundos, utilizados quando o método explora mais de 5
+// * vizinhanças (a última vizinhança continua sem alterar a solução): o
+// * double-bridge e a ruína e reconstrução, que remove até
+// * RUINA_MAXIMO_ELEMENTOS elementos e os reinsere pela menor latência.
+// * -----------------------------------------------------------------------------
+#define VIZINHANCA_DOUBLE_BRIDGE 5
+#define VIZINHANCA_RUINA 6
+#define RUINA_MAXIMO_ELEMENTOS 5
+
+// * -----------------------------------------------------------------------------
+// * Quantidade de vizinhanças do VND avaliadas pela varredura unificada (ver
+// * VARREDURA_POR_VIZINHANCA e VARREDURA_MELHOR_GERAL).
+// * -----------------------------------------------------------------------------
+#define QUANTIDADE_VIZINHANCAS_VND 5
+
+// * -----------------------------------------------------------------------------
+// * Tabela persistente de ganhos do VND completo (ver explorar_tabela_ganhos):
+// * utilizada em instâncias com ao menos TAMANHO_MINIMO_TABELA_GANHOS
+// * elementos. Quando mais de 1 / FRACAO_RECALCULO_TABELA_GANHOS das posições
+// * mudou desde a última consulta, todas as linhas são recalculadas.
+// * -----------------------------------------------------------------------------
+#define TAMANHO_MINIMO_TABELA_GANHOS 500
+#define FRACAO_RECALCULO_TABELA_GANHOS 8
+
+// * -----------------------------------------------------------------------------
+// * Avaliação vetorial do VND (ver explorar_vizinhanca_vetorial): utilizada em
+// * instâncias com até TAMANHO_MAXIMO_VETORIAL elementos, que é também a
+// * quantidade de lanes de cada vetor. As linhas da matriz ordenada pela
+// * solução possuem COLUNAS_VETORIAIS posições.
+// * -----------------------------------------------------------------------------
+#define TAMANHO_MAXIMO_VETORIAL 16
+#define COLUNAS_VETORIAIS (2 * TAMANHO_MAXIMO_VETORIAL + 2)
+
+// * -----------------------------------------------------------------------------
+// * Quantidade máxima de threads da construção em lote.
+// * -----------------------------------------------------------------------------
+#define MAXIMO_THREADS_CONSTRUCAO 64
+
+// * -----------------------------------------------------------------------------
+// * Rastro de eventos da busca: tipos de evento e capacidade padrão do buffer
+// * circular. Compilar com SEM_RASTREAMENTO remove toda a instrumentação; sem
+// * um rastro associado ao solucionador, o custo é apenas o teste do ponteiro.
+// * -----------------------------------------------------------------------------
+#define RASTRO_CONSTRUCAO 0
+#define RASTRO_ABALO 1
+#define RASTRO_VIZINHANCA 2
+#define RASTRO_PATH_RELINKING 3
+#define RASTRO_MELHORA 4
+#define RASTRO_CAPACIDADE_PADRAO 262144
+
+#ifdef SEM_RASTREAMENTO
+#define RASTRO_INICIO(s, marca)
+#define RASTRO_EVENTO(s, tipo, marca, vizinhanca, custo)
+#define RASTRO_PONTO(s, tipo, vizinhanca, custo)
+#else
+#define RASTRO_INICIO(s, marca) double marca = (s)->rastro ? relogio() : 0
+#define RASTRO_EVENTO(s, tipo, marca, vizinhanca, custo) do { if((s)->rastro) registrar_evento((s)->rastro, tipo, marca, vizinhanca, custo); } while(0)
+#define RASTRO_PONTO(s, tipo, vizinhanca, custo) do { if((s)->rastro) registrar_evento((s)->rastro, tipo, -1, vizinhanca, custo); } while(0)
+#endif
+
+// * -----------------------------------------------------------------------------
+// * Perfil de desempenho por fase da busca: fases medidas (cada vizinhança do
+// * VND é uma fase, a partir de PERFIL_VIZINHANCA), contadores lidos e
+// * profundidade máxima das fases aninhadas. Compilar com SEM_RASTREAMENTO
+// * também remove esta instrumentação.
+// * -----------------------------------------------------------------------------
+#define PERFIL_CONSTRUCAO 0
+#define PERFIL_ABALO 1
+#define PERFIL_PATH_RELINKING 2
+#define PERFIL_VARREDURA 3
+#define PERFIL_VIZINHANCA 4
+#define PERFIL_DEMAIS (PERFIL_VIZINHANCA + QUANTIDADE_VIZINHANCAS_VND)
+#define QUANTIDADE_FASES_PERFIL (PERFIL_DEMAIS + 1)
+#define QUANTIDADE_CONTADORES_PERFIL 7
+#define PROFUNDIDADE_MAXIMA_PERFIL 8
+
+#ifdef SEM_RASTREAMENTO
+#define PERFIL_ENTRAR(s, fase)
+#define PERFIL_SAIR(s)
+#else
+#define PERFIL_ENTRAR(s, fase) do { if((s)->perfil) entrar_fase_perfil((s)->perfil, fase); } while(0)
+#define PERFIL_SAIR(s) do { if((s)->perfil) sair_fase_perfil((s)->perfil); } while(0)
+#endif
+
+// * -----------------------------------------------------------------------------
+// * Constantes da alocação das tabelas grandes (matriz de distâncias, matriz
+// * compacta, listas de vizinhos e cache de distâncias) em páginas grandes.
+// * Blocos menores que MEMORIA_MINIMO_MAPEAMENTO são alocados pelo malloc.
+// * -----------------------------------------------------------------------------
+#define PAGINA_GRANDE (2 * 1024 * 1024)
+#define MEMORIA_MINIMO_MAPEAMENTO PAGINA_GRANDE
+#define MEMORIA_CABECALHO 64
+#define MEMORIA_PAGINAS_NORMAIS 0
+#define MEMORIA_PAGINAS_TRANSPARENTES 1
+#define MEMORIA_PAGINAS_GRANDES 2
+
+// * -----------------------------------------------------------------------------
+// * Execuções intercaladas: distância, em arcos, da antecipação (prefetch)
+// * das distâncias no cálculo de custo, tamanho a partir do qual a matriz
+// * deixa de caber na cache e a antecipação compensa, e quantidade de arcos
+// * antecipados antes de uma execução ceder a vez; tamanho da pilha de cada
+// * execução.
+// * -----------------------------------------------------------------------------
+#define ANTECIPACAO_CUSTO 16
+#define TAMANHO_MINIMO_ANTECIPACAO 2048
+#define ANTECIPACAO_CORROTINA 32
+#define PILHA_CORROTINA (512 * 1024)
+
+#define CEDER(s, solucao) do { if((s)->corrotina) ceder(s, solucao); } while(0)
+
+// * -----------------------------------------------------------------------------
+// * Estruturas de dados internas da representação do problema: cache de
+// * distâncias, contexto pré-processado e kernels especializados do cálculo de
+// * custo.
+// * -----------------------------------------------------------------------------
+struct cache_distancias {
+    int capacidade;
+    int blocos_linha;
+    int mascara;
+    int* baldes;
+    long long* chaves;
+    int* proximo_balde;
+    int* anterior;
+    int* proximo;
+    int mais_recente;
+    int menos_recente;
+    int* valores;
+};
+
+// * -----------------------------------------------------------------------------
+// * Contexto pré-processado da instância: dados derivados apenas da instância,
+// * construídos uma única vez e compartilhados, somente leitura, por todas as
+// * execuções. vizinhos[i * tamanho + k] é o k-ésimo elemento mais próximo de
+// * i.
+// * -----------------------------------------------------------------------------
+struct contexto {
+    int tamanho;
+    unsigned long long assinatura;
+    long long limite_inferior;
+    int* vizinhos;
+};
+
+struct kernel_custo {
+    const char* nome;
+    int bits;
+    int tamanho_maximo;
+    long long (*custo)(struct problema*, int*);
+};
+
+struct nodo {
+    int indice;
+    int valor;
+};
+
+// * -----------------------------------------------------------------------------
+// * Solução manipulada pela busca: os elementos (p->tamanho + 1 posições, com
+// * a origem no início e no fim), a posição de cada elemento e o custo, válido
+// * enquanto a solução não estiver marcada como alterada.
+// * -----------------------------------------------------------------------------
+struct solucao {
+    int* elementos;
+    int* posicoes;
+    long long custo;
+    int alterada;
+};
+
+struct informacao_execucao {
+    long long valor_encontrado;
+    double tempo;
+    int* solucao;
+};
+
+// * -----------------------------------------------------------------------------
+// * Estado da busca gravado nos checkpoints. Como o GVNS sempre abala a melhor
+// * solução, ela também é a solução corrente da busca.
+// * -----------------------------------------------------------------------------
+struct estado_busca {
+    int concluidas;
+    int em_andamento;
+    int iteracao;
+    int vizinhanca;
+    long long custo;
+    unsigned long long estado_aleatorio;
+    double tempo;
+    int* solucao;
+};
+
+struct checkpoint {
+    char* arquivo;
+    int intervalo;
+    time_t ultima_gravacao;
+    int retomar;
+    double inicio;
+    double tempo_anterior;
+    int tamanho;
+    unsigned long long assinatura;
+    int parametros[CHECKPOINT_PARAMETROS];
+    long long alvo;
+    struct informacao_execucao* informacoes;
+    struct estado_busca estado;
+    struct estado_busca gravacao;
+    int pendente;
+    int encerrar;
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t condicao;
+};
+
+// * -----------------------------------------------------------------------------
+// * Solução incumbente publicada pela busca para leitura por outras threads
+// * (ver publicar_incumbente) e thread que exibe periodicamente o seu custo.
+// * -----------------------------------------------------------------------------
+struct incumbente {
+    atomic_uint sequencia;
+    atomic_llong custo;
+    atomic_int execucao;
+    int tamanho;
+    atomic_int* solucao;
+};
+
+struct progresso {
+    struct incumbente* incumbente;
+    double intervalo;
+    double inicio;
+    int encerrar;
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t condicao;
+};
+
+// * -----------------------------------------------------------------------------
+// * Rastro de eventos e perfil de desempenho da busca e estado de um
+// * solucionador (gerador de números aleatórios, cache de distâncias e áreas
+// * de trabalho reaproveitadas entre as execuções).
+// * -----------------------------------------------------------------------------
+struct evento_rastro {
+    double inicio;
+    double duracao;
+    long long custo;
+    int tipo;
+    int execucao;
+    int vizinhanca;
+};
+
+struct rastro {
+    struct evento_rastro* eventos;
+    long long capacidade;
+    long long total;
+    int execucao;
+    double inicio;
+};
+
+struct medicao_perfil {
+    long long chamadas;
+    double tempo;
+    long long contadores[QUANTIDADE_CONTADORES_PERFIL];
+};
+
+struct perfil {
+    int descritores[QUANTIDADE_CONTADORES_PERFIL];
+    int posicoes[QUANTIDADE_CONTADORES_PERFIL];
+    int lider;
+    int abertos;
+    int erro;
+    long long leitura[QUANTIDADE_CONTADORES_PERFIL];
+    double instante;
+    int pilha[PROFUNDIDADE_MAXIMA_PERFIL];
+    int profundidade;
+    int excedentes;
+    struct medicao_perfil atual[QUANTIDADE_FASES_PERFIL];
+    struct medicao_perfil total[QUANTIDADE_FASES_PERFIL];
+    struct medicao_perfil* execucoes;
+    int* indices;
+    int quantidade;
+    int capacidade;
+};
+
+struct solucionador {
+    struct problema problema;
+    struct opcoes opcoes;
+    unsigned long long estado_aleatorio;
+    double inicio;
+    struct rastro* rastro;
+    struct perfil* perfil;
+    struct lote_construcao* lote;
+    struct corrotina* corrotina;
+    struct tabela_ganhos* ganhos;
+    struct percurso_vetorial* vetorial;
+    int execucao;
+};
+
+// * -----------------------------------------------------------------------------
+// * Área de trabalho da construção em lote, alocada na primeira execução do
+// * solucionador e reaproveitada pelas seguintes, e tarefa de cada thread da
+// * construção.
+// * -----------------------------------------------------------------------------
+struct lote_construcao {
+    int capacidade;
+    int threads;
+    float percentual_inicial;
+    float percentual_final;
+    int* solucoes;
+    char* inseridos;
+    unsigned long long* estados;
+    long long* custos;
+    int* ordem;
+    struct nodo* vizinhos;
+    int* linhas;
+};
+
+struct tarefa_construcao {
+    struct solucionador* solucionador;
+    int trabalhador;
+    int primeira;
+    int quantidade;
+};
+
+// * -----------------------------------------------------------------------------
+// * Melhor movimento (i, j) de uma vizinhança na varredura unificada.
+// * -----------------------------------------------------------------------------
+struct movimento {
+    long long custo;
+    int i;
+    int j;
+};
+
+// * -----------------------------------------------------------------------------
+// * Tabela persistente de ganhos: para cada vizinhança, o melhor movimento
+// * (i, melhor_j[i]) de cada linha i, a sua variação de custo e a solução
+// * para a qual as linhas foram calculadas.
+// * -----------------------------------------------------------------------------
+struct linhas_ganhos {
+    int* referencia;
+    int* melhor_j;
+    long long* variacao;
+    int valida;
+};
+
+struct tabela_ganhos {
+    struct linhas_ganhos linhas[QUANTIDADE_VIZINHANCAS_VND];
+    long long* prefixos;
+    char* afetada;
+    int* alteradas;
+};
+
+// * -----------------------------------------------------------------------------
+// * Matriz de distâncias ordenada pela solução explorada na avaliação vetorial,
+// * a sua transposta e os prefixos dos arcos, com a coluna c na posição c + 1.
+// * Cada linha é montada sob demanda e guarda a geração (a solução) para a
+// * qual foi montada.
+// * -----------------------------------------------------------------------------
+struct percurso_vetorial {
+    int referencia[TAMANHO_MAXIMO_VETORIAL + 1];
+    unsigned int geracao;
+    unsigned int geracao_distancias[TAMANHO_MAXIMO_VETORIAL + 1];
+    unsigned int geracao_transposta[TAMANHO_MAXIMO_VETORIAL + 1];
+    int distancias[TAMANHO_MAXIMO_VETORIAL + 1][COLUNAS_VETORIAIS];
+    int transposta[TAMANHO_MAXIMO_VETORIAL + 1][COLUNAS_VETORIAIS];
+    int arco[COLUNAS_VETORIAIS];
+    int soma[COLUNAS_VETORIAIS];
+    int soma_ponderada[COLUNAS_VETORIAIS];
+    int soma_inversa[COLUNAS_VETORIAIS];
+    int soma_inversa_ponderada[COLUNAS_VETORIAIS];
+};
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções básicas para a implementação do método GVNS
+// * -----------------------------------------------------------------------------
+void construir_solucao(struct solucionador*, float, float, int*);
+long long encontrar_melhor_vizinho(struct solucionador*, struct solucao*, int, const char*, struct solucao*);
+long long vnd(struct solucionador*, int, struct solucao*, struct solucao*);
+long long vnd_localizado(struct solucionador*, int, int*, int, struct solucao*, struct solucao*);
+void marcar_regiao(char*, int, int);
+int gerar_vizinho_aleatorio(struct solucionador*, int, int, struct solucao*, struct solucao*, int*);
+long long gvns(struct solucionador*, int, int, struct solucao*, struct solucao*);
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções que implementam o método exato para instâncias pequenas.
+// * -----------------------------------------------------------------------------
+long long resolver_exato(struct problema*, int*);
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções que implementam os movimentos de exploração de vizinhança.
+// * -----------------------------------------------------------------------------
+int realizar_random_double_bridge(struct solucionador*, int*, int*, int*);
+int realizar_ruina_reconstrucao(struct solucionador*, int*, int*, int*);
+void inserir_menor_latencia(struct problema*, int*, int, int);
+long long realizar_swap(struct solucionador*, struct solucao*, const char*, struct solucao*);
+void realizar_swap_2opt(struct problema*, int*, int, int, int*);
+long long realizar_insercao(struct solucionador*, struct solucao*, const char*, struct solucao*);
+long long realizar_2opt(struct solucionador*, struct solucao*, const char*, struct solucao*);
+long long realizar_oropt2(struct solucionador*, struct solucao*, const char*, struct solucao*);
+long long realizar_oropt3(struct solucionador*, struct solucao*, const char*, struct solucao*);
+long long realizar_path_relinking(struct solucionador*, struct solucao*, struct solucao*, struct solucao*);
+int localizar_elemento(int*, int, int, int);
+long long realizar_swap_restrito(struct solucionador*, struct solucao*, struct solucao*, int*);
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções da varredura unificada das vizinhanças do VND.
+// * -----------------------------------------------------------------------------
+long long preparar_prefixos(struct problema*, int*, long long*);
+int varrer_vizinhancas(struct solucionador*, struct solucao*, int, const char*, long long*, struct solucao*);
+void aplicar_movimento(struct problema*, struct solucao*, int, int, int, long long, struct solucao*);
+struct tabela_ganhos* preparar_tabela_ganhos(struct solucionador*);
+long long explorar_tabela_ganhos(struct solucionador*, struct solucao*, int, struct solucao*);
+void liberar_tabela_ganhos(struct tabela_ganhos*);
+long long verificar_vizinhancas(struct problema*, int);
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções da avaliação vetorial do VND nas instâncias pequenas.
+// * -----------------------------------------------------------------------------
+long long explorar_vizinhanca_vetorial(struct solucionador*, struct solucao*, int, const char*, struct solucao*);
+void liberar_percurso_vetorial(struct percurso_vetorial*);
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções da representação das soluções durante a busca.
+// * -----------------------------------------------------------------------------
+struct solucao* criar_solucao(struct problema*, int*);
+void definir_solucao(struct problema*, struct solucao*, int*, long long);
+void duplicar_solucao(struct problema*, struct solucao*, struct solucao*);
+long long custo_solucao(struct problema*, struct solucao*);
+void atualizar_posicoes(struct solucao*, int, int);
+void trocar_elementos(struct solucao*, int, int);
+void liberar_solucao(struct solucao*);
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções auxiliares.
+// * -----------------------------------------------------------------------------
+void selection_sort(struct nodo *, int);
+void copiar_solucao(int, int*, int*);
+void trocar_solucoes(struct solucao**, struct solucao**);
+int* inicializar_solucao(int, int*);
+int rnd(struct solucionador*, int, int);
+void semear(struct solucionador*, unsigned long long);
+int aleatorio(struct solucionador*);
+int sortear(unsigned long long*);
+void imprimir_solucao(int, int*);
+double relogio(void);
+int tempo_esgotado(struct solucionador*);
+void linha(void);
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções de leitura e representação do problema.
+// * -----------------------------------------------------------------------------
+int ler_arquivo_tsplib(struct problema*, FILE*);
+int** alocar_matriz(int, int);
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções de acesso às distâncias entre os elementos.
+// * -----------------------------------------------------------------------------
+int calcular_distancia(struct problema*, int, int);
+int obter_distancia_cache(struct problema*, int, int);
+void inicializar_cache_distancias(struct problema*, int);
+void liberar_cache_distancias(struct cache_distancias*);
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções do contexto pré-processado da instância.
+// * -----------------------------------------------------------------------------
+int construir_contexto(struct problema*, struct contexto*);
+unsigned long long calcular_assinatura(struct problema*);
+int carregar_contexto(struct contexto*, char*);
+int gravar_contexto(struct contexto*, char*);
+void liberar_contexto(struct contexto*);
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções de seleção e avaliação dos kernels especializados.
+// * -----------------------------------------------------------------------------
+int preparar_kernel(struct problema*, const struct kernel_custo*);
+void liberar_kernel(struct problema*);
+void selecionar_kernel(struct problema*);
+int* gerar_solucoes_teste(struct problema*, int);
+double medir_custo(struct problema*, int*, int, int, long long*);
+void comparar_kernels(struct problema*, int);
+void antecipar_custo(struct problema*, int*, int);
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções da construção em lote.
+// * -----------------------------------------------------------------------------
+struct lote_construcao* preparar_lote(struct solucionador*);
+void construir_lote(struct solucionador*, struct lote_construcao*, int, int, int);
+void* executar_tarefa_construcao(void*);
+long long construir_melhor_solucao(struct solucionador*, float, float, int*);
+void liberar_lote(struct lote_construcao*);
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções de alocação das tabelas grandes em páginas grandes.
+// * -----------------------------------------------------------------------------
+void* alocar_memoria(size_t, int);
+int modo_memoria(void*);
+const char* descrever_modo_memoria(int);
+void liberar_memoria(void*);
+void comparar_memoria(struct problema*, int);
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções de checkpoint e retomada da busca.
+// * -----------------------------------------------------------------------------
+struct checkpoint* iniciar_checkpoint(char*, int, struct problema*, struct opcoes*, int, int, struct informacao_execucao*);
+int carregar_checkpoint(struct checkpoint*);
+void registrar_checkpoint(struct checkpoint*, int, int, long long, unsigned long long, int*);
+void concluir_execucao_checkpoint(struct checkpoint*, int);
+void finalizar_checkpoint(struct checkpoint*);
+void* gravar_checkpoints(void*);
+int gravar_checkpoint(struct checkpoint*, struct estado_busca*);
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções da reotimização a partir de uma solução conhecida.
+// * -----------------------------------------------------------------------------
+int* ler_solucao_arquivo(char*, int, int*);
+int gravar_solucao_arquivo(char*, int, int*);
+int* preparar_reotimizacao(struct problema*, char*, char*, int**, int*, int*);
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções da renumeração dos elementos.
+// * -----------------------------------------------------------------------------
+int* ordenar_por_proximidade(struct problema*);
+int renumerar_problema(struct problema*, const int*);
+void traduzir_solucao(int, const int*, int*);
+void renumerar_solucao(int, const int*, int*);
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções do acesso concorrente à solução incumbente.
+// * -----------------------------------------------------------------------------
+struct incumbente* criar_incumbente(int);
+void publicar_incumbente(struct incumbente*, long long, int*, int);
+int ler_incumbente(struct incumbente*, int*, long long*, int*);
+void liberar_incumbente(struct incumbente*);
+void* exibir_progresso(void*);
+struct progresso* iniciar_progresso(struct incumbente*, double);
+void finalizar_progresso(struct progresso*);
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções das execuções intercaladas.
+// * -----------------------------------------------------------------------------
+void executar_intercalado(struct problema*, struct opcoes*, int, int, int, struct informacao_execucao*);
+void ceder(struct solucionador*, int*);
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções do rastro de eventos da busca.
+// * -----------------------------------------------------------------------------
+struct rastro* criar_rastro(long long);
+void registrar_evento(struct rastro*, int, double, int, long long);
+int gravar_rastro(struct rastro*, char*);
+void liberar_rastro(struct rastro*);
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções do perfil de desempenho por fase da busca.
+// * -----------------------------------------------------------------------------
+struct perfil* criar_perfil(void);
+int contador_disponivel(struct perfil*, int);
+void descrever_perfil(struct perfil*);
+void iniciar_execucao_perfil(struct perfil*);
+void entrar_fase_perfil(struct perfil*, int);
+void sair_fase_perfil(struct perfil*);
+void concluir_execucao_perfil(struct perfil*, int);
+int gravar_perfil(struct perfil*, char*);
+void exibir_perfil(struct perfil*);
+void liberar_perfil(struct perfil*);
+
+/*
+ * Function: distancia
+ * -----------------------------------------------------------------------------
+ *   Retorna a distância entre 2 elementos. Todas as rotinas do método acessam
+ *   as distâncias por essa função, de forma que a matriz de adjacência não
+ *   precise estar em memória nas instâncias grandes: sem a matriz a distância
+ *   é obtida do cache de distâncias (quando habilitado) ou calculada a partir
+ *   das coordenadas.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   i: elemento de origem.
+ *   j: elemento de destino.
+ */
+static inline int distancia(struct problema* p, int i, int j) {
+    if(p->elementos) {
+        return p->elementos[i][j];
+    }
+    
+    if(p->cache) {
+        return obter_distancia_cache(p, i, j);
+    }
+    
+    return calcular_distancia(p, i, j);
+}
+
+#endif /* interno_h */
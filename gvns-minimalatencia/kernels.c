@@ -0,0 +1,315 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include <limits.h>
+
+#include "interno.h"
+
+// * -----------------------------------------------------------------------------
+// * Kernels especializados para o cálculo do custo de uma solução. Cada kernel
+// * lê uma cópia contígua da matriz de adjacência (matriz_compacta) com
+// * elementos de largura fixa e, nas instâncias pequenas, com a largura da
+// * linha (passo) conhecida em tempo de compilação. A matriz de 16 bits de uma
+// * instância com até 64 elementos ocupa no máximo 8 KB. A partir de
+// * TAMANHO_MINIMO_ANTECIPACAO elementos, as distâncias são antecipadas
+// * ANTECIPACAO_CUSTO arcos à frente. Os índices são calculados em size_t,
+// * pois i * passo excede um int a partir de 46341 elementos (caso
+// * TAMANHO_MAXIMO_MATRIZ seja ampliado).
+// *
+// * Apenas o custo completo é especializado: as vizinhanças do VND avaliam
+// * cada candidato por calcular_custo e, portanto, já utilizam o kernel. As
+// * variações em O(1) da varredura unificada e da tabela de ganhos leem no
+// * máximo seis distâncias por movimento, e a leitura pela matriz compacta
+// * não alterou o tempo dessas avaliações além da variação entre execuções.
+// * -----------------------------------------------------------------------------
+#define KERNEL_CUSTO(nome, tipo, passo_fixo) \
+    static long long nome(struct problema* p, int* solucao) { \
+        const tipo* m = (const tipo*) p->matriz_compacta; \
+        const int n = p->tamanho; \
+        const size_t passo = (passo_fixo) ? (passo_fixo) : (size_t) p->passo; \
+        const int antecipar = !(passo_fixo) && n >= TAMANHO_MINIMO_ANTECIPACAO; \
+        long long custo = 0; \
+        \
+        for(int i = 0; i < n; i++) { \
+            if(antecipar && i + ANTECIPACAO_CUSTO < n) { \
+                __builtin_prefetch(&m[solucao[i + ANTECIPACAO_CUSTO] * passo + solucao[i + ANTECIPACAO_CUSTO + 1]]); \
+            } \
+            custo += (long long) m[solucao[i] * passo + solucao[i + 1]] * (n - i); \
+        } \
+        \
+        return custo; \
+    }
+
+KERNEL_CUSTO(custo_u16_16, uint16_t, 16)
+KERNEL_CUSTO(custo_u16_32, uint16_t, 32)
+KERNEL_CUSTO(custo_u16_64, uint16_t, 64)
+KERNEL_CUSTO(custo_u16_n, uint16_t, 0)
+KERNEL_CUSTO(custo_i32_16, int32_t, 16)
+KERNEL_CUSTO(custo_i32_32, int32_t, 32)
+KERNEL_CUSTO(custo_i32_64, int32_t, 64)
+KERNEL_CUSTO(custo_i32_n, int32_t, 0)
+
+// * -----------------------------------------------------------------------------
+// * Kernels disponíveis em ordem de preferência. O primeiro kernel compatível
+// * com a instância (largura dos elementos e tamanho) é o selecionado.
+// * -----------------------------------------------------------------------------
+static const struct kernel_custo kernels_custo[] = {
+    {"uint16/n<=16", 16, 16, custo_u16_16},
+    {"uint16/n<=32", 16, 32, custo_u16_32},
+    {"uint16/n<=64", 16, 64, custo_u16_64},
+    {"uint16", 16, 0, custo_u16_n},
+    {"int32/n<=16", 32, 16, custo_i32_16},
+    {"int32/n<=32", 32, 32, custo_i32_32},
+    {"int32/n<=64", 32, 64, custo_i32_64},
+    {"int32", 32, 0, custo_i32_n},
+};
+
+#define QUANTIDADE_KERNELS (int) (sizeof(kernels_custo) / sizeof(kernels_custo[0]))
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções de seleção e avaliação dos kernels especializados.
+// * -----------------------------------------------------------------------------
+
+/*
+ * Function: kernel_compativel
+ * -----------------------------------------------------------------------------
+ *   Verifica se um kernel pode ser utilizado para o problema, considerando o
+ *   tamanho da instância e o intervalo dos valores da matriz.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   k: kernel avaliado.
+ *
+ *   returns: TRUE caso o kernel seja compatível.
+ */
+static int kernel_compativel(struct problema* p, const struct kernel_custo* k) {
+    if(!p->elementos || (k->tamanho_maximo && p->tamanho > k->tamanho_maximo)) {
+        return FALSE;
+    }
+    
+    if(k->bits == 16) {
+        for(int i = 0; i < p->tamanho; i++) {
+            for(int j = 0; j < p->tamanho; j++) {
+                if(p->elementos[i][j] < 0 || p->elementos[i][j] > UINT16_MAX) {
+                    return FALSE;
+                }
+            }
+        }
+    }
+    
+    return TRUE;
+}
+
+/*
+ * Function: preparar_kernel
+ * -----------------------------------------------------------------------------
+ *   Monta a matriz compacta utilizada pelo kernel informado e o associa ao
+ *   problema, liberando o kernel anterior. Com valores de 32 bits e linhas do
+ *   tamanho da instância, a matriz compacta coincide com a matriz de
+ *   adjacência, que é utilizada diretamente em vez de copiada.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   k: kernel que será utilizado.
+ *
+ *   returns: TRUE caso o kernel tenha sido associado ao problema.
+ */
+int preparar_kernel(struct problema* p, const struct kernel_custo* k) {
+    int passo;
+    
+    if(!kernel_compativel(p, k)) {
+        return FALSE;
+    }
+    
+    passo = k->tamanho_maximo ? k->tamanho_maximo : p->tamanho;
+    
+    liberar_kernel(p);
+    
+    if(k->bits == 32 && passo == p->tamanho) {
+        p->matriz_compacta = p->elementos[0];
+    } else {
+        p->matriz_compacta = alocar_memoria((size_t) passo * passo * (k->bits / 8), p->paginas_grandes);
+        
+        if(!p->matriz_compacta) {
+            return FALSE;
+        }
+        
+        for(int i = 0; i < p->tamanho; i++) {
+            for(int j = 0; j < p->tamanho; j++) {
+                if(k->bits == 16) {
+                    ((uint16_t*) p->matriz_compacta)[(size_t) i * passo + j] = (uint16_t) p->elementos[i][j];
+                } else {
+                    ((int32_t*) p->matriz_compacta)[(size_t) i * passo + j] = p->elementos[i][j];
+                }
+            }
+        }
+    }
+    
+    p->passo = passo;
+    p->kernel = k;
+    
+    return TRUE;
+}
+
+/*
+ * Function: liberar_kernel
+ * -----------------------------------------------------------------------------
+ *   Desassocia o kernel do problema, liberando a matriz compacta apenas
+ *   quando ela é uma cópia da matriz de adjacência (ver preparar_kernel).
+ *
+ *   p: estrutura de dados representando o problema.
+ */
+void liberar_kernel(struct problema* p) {
+    if(p->kernel && (p->kernel->bits != 32 || p->passo != p->tamanho)) {
+        liberar_memoria(p->matriz_compacta);
+    }
+    
+    p->matriz_compacta = NULL;
+    p->kernel = NULL;
+}
+
+/*
+ * Function: selecionar_kernel
+ * -----------------------------------------------------------------------------
+ *   Seleciona o kernel de custo mais específico para o problema a partir do
+ *   seu tamanho e do maior valor da matriz. Problemas sem a matriz de
+ *   adjacência em memória continuam utilizando o cálculo genérico.
+ *
+ *   p: estrutura de dados representando o problema.
+ */
+void selecionar_kernel(struct problema* p) {
+    for(int k = 0; k < QUANTIDADE_KERNELS; k++) {
+        if(preparar_kernel(p, &kernels_custo[k])) {
+            return;
+        }
+    }
+}
+
+/*
+ * Function: medir_custo
+ * -----------------------------------------------------------------------------
+ *   Mede o tempo médio, em nanossegundos, do cálculo do custo das soluções
+ *   informadas.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   solucoes: soluções avaliadas (quantidade * (p->tamanho + 1) posições).
+ *   quantidade: quantidade de soluções.
+ *   repeticoes: quantidade de vezes que as soluções serão avaliadas.
+ *   soma: soma dos custos calculados (evita que o cálculo seja descartado
+ *   pelo compilador e permite conferir os kernels).
+ */
+double medir_custo(struct problema* p, int* solucoes, int quantidade, int repeticoes, long long* soma) {
+    clock_t inicio = clock();
+    
+    *soma = 0;
+    for(int r = 0; r < repeticoes; r++) {
+        for(int i = 0; i < quantidade; i++) {
+            *soma += calcular_custo(p, solucoes + (size_t) i * (p->tamanho + 1));
+        }
+    }
+    
+    return (double) (clock() - inicio) / CLOCKS_PER_SEC * 1e9 / ((double) quantidade * repeticoes);
+}
+
+/*
+ * Function: gerar_solucoes_teste
+ * -----------------------------------------------------------------------------
+ *   Gera soluções aleatórias, com semente fixa, para as comparações de
+ *   desempenho do cálculo de custo.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   quantidade: quantidade de soluções.
+ *
+ *   returns: as soluções geradas (quantidade * (p->tamanho + 1) posições).
+ */
+int* gerar_solucoes_teste(struct problema* p, int quantidade) {
+    struct opcoes opcoes;
+    struct solucionador* s;
+    int* solucoes = malloc((size_t) quantidade * (p->tamanho + 1) * sizeof(int));
+    
+    inicializar_opcoes(&opcoes);
+    s = criar_solucionador(p, &opcoes);
+    semear(s, 0);
+    
+    for(int i = 0; i < quantidade; i++) {
+        int* solucao = solucoes + (size_t) i * (p->tamanho + 1);
+        
+        for(int j = 0; j < p->tamanho; j++) {
+            solucao[j] = j;
+        }
+        solucao[p->tamanho] = 0;
+        
+        for(int j = p->tamanho - 1; j > 1; j--) {
+            int k = rnd(s, 1, j);
+            int t = solucao[j];
+            solucao[j] = solucao[k];
+            solucao[k] = t;
+        }
+    }
+    
+    liberar_solucionador(s);
+    
+    return solucoes;
+}
+
+/*
+ * Function: comparar_kernels
+ * -----------------------------------------------------------------------------
+ *   Compara o tempo do cálculo de custo do caminho genérico com cada kernel
+ *   compatível com o problema, imprimindo uma linha por kernel no formato:
+ *   <KERNEL>;<NS_POR_AVALIACAO>;<GANHO_SOBRE_O_GENERICO>
+ *
+ *   p: estrutura de dados representando o problema.
+ *   avaliacoes: quantidade aproximada de avaliações por kernel.
+ */
+void comparar_kernels(struct problema* p, int avaliacoes) {
+    struct problema tmp = *p;
+    int quantidade = 64;
+    int repeticoes = avaliacoes / quantidade > 0 ? avaliacoes / quantidade : 1;
+    int* solucoes = gerar_solucoes_teste(p, quantidade);
+    long long soma_generico, soma;
+    double generico, tempo;
+    
+    tmp.kernel = NULL;
+    tmp.matriz_compacta = NULL;
+    generico = medir_custo(&tmp, solucoes, quantidade, repeticoes, &soma_generico);
+    printf("generico;%.2f;1.00\n", generico);
+    
+    for(int k = 0; k < QUANTIDADE_KERNELS; k++) {
+        if(!preparar_kernel(&tmp, &kernels_custo[k])) {
+            continue;
+        }
+        
+        tempo = medir_custo(&tmp, solucoes, quantidade, repeticoes, &soma);
+        printf("%s;%.2f;%.2f%s\n", kernels_custo[k].nome, tempo, tempo > 0 ? generico / tempo : 0, soma == soma_generico ? "" : ";DIVERGENTE");
+    }
+    
+    liberar_kernel(&tmp);
+    free(solucoes);
+}
+
+/*
+ * Function: antecipar_custo
+ * -----------------------------------------------------------------------------
+ *   Solicita antecipadamente (prefetch) as distâncias dos primeiros arcos de
+ *   uma solução, na representação lida pelo cálculo de custo do problema.
+ *   Utilizada antes de uma execução intercalada ceder a vez (ver ceder), de
+ *   forma que as distâncias cheguem à memória cache enquanto as demais
+ *   execuções avançam. Sem a matriz em memória não há o que antecipar.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   solucao: solução que será avaliada.
+ *   arcos: quantidade de arcos antecipados.
+ */
+void antecipar_custo(struct problema* p, int* solucao, int arcos) {
+    if(arcos > p->tamanho) {
+        arcos = p->tamanho;
+    }
+    
+    for(int i = 0; i < arcos; i++) {
+        if(p->kernel) {
+            __builtin_prefetch((const char*) p->matriz_compacta + ((size_t) solucao[i] * p->passo + solucao[i + 1]) * (p->kernel->bits / 8));
+        } else if(p->elementos) {
+            __builtin_prefetch(&p->elementos[solucao[i]][solucao[i + 1]]);
+        }
+    }
+}
@@ -2,89 +2,148 @@
 #include <stdio.h>
 #include <string.h>
 #include <time.h>
-#include <math.h>
 #include <limits.h>
 
-#define TRUE 1
-#define FALSE 0
-
-// * -----------------------------------------------------------------------------
-// * Variáveis globais utilizadas como parâmetro de execução do programa.
-// * -----------------------------------------------------------------------------
-int debug;
-int debug_caminhos;
-int alvo = 0;
-
-// * -----------------------------------------------------------------------------
-// * Estrutura de dados básicas para representar em memória o problema tratado.
-// * -----------------------------------------------------------------------------
-struct problema {
-    int tamanho;
-    int** elementos;
-};
-
-struct nodo {
-    int indice;
-    int valor;
-};
-
-struct informacao_execucao {
-    int valor_encontrado;
-    double tempo;
-    int* solucao;
-};
-
-// * -----------------------------------------------------------------------------
-// * Bloco de funções básicas para a implementação do método GVNS
-// * -----------------------------------------------------------------------------
-int calcular_custo(struct problema, int*);
-void construir_solucao(struct problema, float, float, int*);
-void encontrar_melhor_vizinho(struct problema p, int* solucao_inicial, int vizinhanca, int* solucao);
-void vnd(struct problema, int, int*, int*);
-void gerar_vizinho_aleatorio(struct problema, int, int*, int*);
-void gvns(struct problema, int, int, int*, int*);
-
-// * -----------------------------------------------------------------------------
-// * Bloco de funções que implementam os movimentos de exploração de vizinhança.
-// * -----------------------------------------------------------------------------
-void realizar_random_double_bridge(struct problema, int*, int*);
-void realizar_swap(struct problema, int*, int*);
-void realizar_swap_2opt(struct problema p, int*, int, int, int*);
-void realizar_insercao(struct problema, int*, int*);
-void realizar_2opt(struct problema, int*, int*);
-void realizar_oropt2(struct problema, int*, int*);
-void realizar_oropt3(struct problema, int*, int*);
-void realizar_path_relinking(struct problema, int*, int*, int*);
-int localizar_elemento(int*, int, int, int);
-void realizar_swap_restrito(struct problema, int*, int*, int*);
-
-// * -----------------------------------------------------------------------------
-// * Bloco de funções auxiliares.
-// * -----------------------------------------------------------------------------
-void selection_sort(struct nodo *, int);
-void copiar_solucao(int, int*, int*);
-int* inicializar_solucao(int, int*);
-int rnd(int, int);
-void ler_arquivo(struct problema*, char[20]);
-void imprimir_solucao(int, int*);
-void linha();
-
+#include "modos.h"
 
 /*
  * Function: main
  * -----------------------------------------------------------------------------
  *   Ponto de entrada da execução do programa. O programa aceita os seguintes 
- *   parâmetros (que deverão ser passados via linha de comando).
+ *   parâmetros (que deverão ser passados via linha de comando). O método em
+ *   si é implementado pela biblioteca estática gvns (interface pública em
+ *   gvns.h); este programa apenas lê a instância, realiza as execuções e
+ *   agrega os resultados, com os modos declarados em modos.h.
  *
  *   arquivo: arquivo que serão analisado.
  *   iteracoes: quantidade de iterações que serão realizadas pelo método GVNS.
  *   vizinhancas: quantidade de vizinhanças que serão exploradas pelo método GVNS.
- *   valor limite: 5.
+ *   Com 5, apenas os pequenos movimentos; 6 inclui o abalo double-bridge e 7
+ *   ou mais também a ruína e reconstrução (a última vizinhança nunca altera
+ *   a solução, ver gerar_vizinho_aleatorio).
  *   construcao_aleatoria: 1 indica que será utilizada uma construção aleatória e 0
  *   indica uma solução gulosa.
  *   execucoes: quantidade de execucoes do método GVNS.
  *   debug: indica se o programa será executado em modo debug imprimindo
  *   informações relevantes para analise e identificação de defeitos.
+ *   alvo (opcional): valor alvo; a busca é interrompida ao alcançá-lo.
+ *
+ *   Opções adicionais (após os parâmetros acima):
+ *   --heuristico: não utiliza o método exato automaticamente em instâncias
+ *   pequenas (até TAMANHO_MAXIMO_EXATO elementos).
+ *   --alvo-exato: calcula o valor ótimo pelo método exato e o utiliza como
+ *   alvo das execuções do GVNS.
+ *   --cache-linhas <n>: mantém em memória, no espaço de n linhas de
+ *   distâncias, os blocos de distâncias usados mais recentemente quando a
+ *   instância não possui a matriz de adjacência (instâncias TSPLIB com
+ *   coordenadas e mais de TAMANHO_MAXIMO_MATRIZ elementos). Desativada por
+ *   padrão: calcular EUC_2D, CEIL_2D ou ATT costuma custar menos que buscar
+ *   a distância na cache.
+ *   --checkpoint <arquivo>: grava periodicamente o estado da busca no arquivo
+ *   informado (por padrão <arquivo da instância>.checkpoint).
+ *   --intervalo-checkpoint <s>: intervalo em segundos entre as gravações
+ *   (padrão CHECKPOINT_INTERVALO_PADRAO).
+ *   --resume: retoma a busca a partir do checkpoint, produzindo os mesmos
+ *   resultados de uma execução sem interrupções. A retomada é recusada
+ *   quando a instância ou as opções da busca diferem das gravadas. O arquivo
+ *   é removido ao término de todas as execuções.
+ *   --contexto: grava o contexto pré-processado da instância (listas de
+ *   vizinhos ordenados e limite inferior) em <arquivo da instância>.contexto
+ *   e o reaproveita nas próximas execuções enquanto o conteúdo da instância
+ *   não mudar. Sem a opção, o contexto é construído em memória.
+ *   --vnd-localizado: após cada abalo, explora apenas as vizinhanças da
+ *   região alterada pelo abalo no lugar de toda a solução. É mais rápido,
+ *   mas os resultados diferem dos obtidos com o VND completo.
+ *   --varredura-unificada: avalia todas as vizinhanças do VND em uma única
+ *   varredura da solução, com os mesmos resultados do VND sequencial.
+ *   --varredura-unificada-geral: como a anterior, mas aplica o melhor
+ *   movimento entre todas as vizinhanças a cada passo do VND.
+ *   --sem-tabela-ganhos: reavalia todos os movimentos a cada passo do VND
+ *   completo no lugar de manter a tabela persistente de ganhos (ver
+ *   explorar_tabela_ganhos), com os mesmos resultados.
+ *   --sem-avaliacao-vetorial: avalia os movimentos do VND um a um nas
+ *   instâncias com até TAMANHO_MAXIMO_VETORIAL elementos, no lugar de
+ *   avaliar os movimentos de cada linha juntos (ver
+ *   explorar_vizinhanca_vetorial), com os mesmos resultados.
+ *   --construcoes <k>: constrói k soluções iniciais por execução, em lote, e
+ *   inicia o GVNS pela de menor custo (ver construir_melhor_solucao).
+ *   --elite <e>: com --construcoes, aplica o VND às e melhores construções e
+ *   inicia o GVNS pela melhor solução resultante.
+ *   --threads-construcao <n>: distribui as construções do lote entre n
+ *   threads, com os mesmos resultados da construção sequencial.
+ *   --rastro <arquivo>: registra os eventos da busca (construção, abalos,
+ *   vizinhanças do VND, path relinking e melhoras) e os grava ao término no
+ *   arquivo informado, no formato trace-event do Chrome (extensão .json) ou
+ *   CSV (ver gravar_rastro). Indisponível quando compilado com
+ *   SEM_RASTREAMENTO.
+ *   --rastro-capacidade <n>: quantidade de eventos mantidos no rastro; os
+ *   mais antigos são descartados (padrão RASTRO_CAPACIDADE_PADRAO).
+ *   --perfil <arquivo>: mede o tempo e os contadores de desempenho do
+ *   processador (ciclos, instruções, falhas de cache, de desvio e de TLB)
+ *   de cada fase da busca e de cada vizinhança do VND, exibe o total ao
+ *   término na saída de erros e grava no arquivo as medições de cada
+ *   execução e o total (ver gravar_perfil). Os contadores indisponíveis no
+ *   sistema ficam vazios. Apenas nas execuções em série; indisponível quando
+ *   compilado com SEM_RASTREAMENTO.
+ *   --intercalar <k>: intercala k execuções em uma única thread, alternando
+ *   entre elas antes de cada vizinhança do VND enquanto as distâncias da
+ *   próxima vizinhança são trazidas da memória (ver executar_intercalado).
+ *   Os resultados são os mesmos das execuções seriais. Não é combinada com
+ *   o checkpoint, com o rastro nem com o perfil.
+ *   --solucao-inicial <arquivo>: inicia todas as execuções pela solução do
+ *   arquivo (os elementos na ordem visitada, a partir da origem) no lugar da
+ *   construção.
+ *   --delta <arquivo>: com --solucao-inicial, aplica à instância as
+ *   alterações do arquivo (distâncias alteradas, elementos inseridos e
+ *   removidos), adapta a solução inicial a elas e aplica o VND apenas às
+ *   posições afetadas antes do GVNS (ver preparar_reotimizacao). Com poucas
+ *   iterações, reotimiza rapidamente uma solução já conhecida.
+ *   --gravar-solucao <arquivo>: grava a melhor solução encontrada no formato
+ *   lido por --solucao-inicial.
+ *   --renumerar: renumera os elementos antes da busca, atribuindo índices
+ *   consecutivos a elementos próximos (na ordem da solução inicial, quando
+ *   informada, ou da cadeia gulosa de vizinhos mais próximos), de forma que
+ *   os acessos à matriz de adjacência durante a busca sejam mais próximos
+ *   entre si (ver renumerar_problema). As soluções exibidas e gravadas
+ *   utilizam os índices originais.
+ *   --progresso <s>: exibe a cada s segundos, na saída de erros, o custo da
+ *   melhor solução encontrada até o momento pelas execuções seriais ou
+ *   intercaladas, lido sem interromper a busca (ver ler_incumbente).
+ *   --ttt: realiza o experimento time-to-target no lugar das execuções
+ *   seriais (ver abaixo). Exige um alvo (ou --alvo-exato).
+ *   --threads <n>: quantidade de threads do experimento time-to-target (por
+ *   padrão, uma por processador).
+ *   --tempo-maximo <s>: tempo máximo em segundos de cada execução do
+ *   experimento time-to-target (padrão TTT_TEMPO_MAXIMO_PADRAO).
+ *   --coordenador <socket>: distribui as execuções entre os processos
+ *   trabalhadores conectados ao socket de domínio Unix informado e imprime
+ *   a mesma saída das execuções seriais (ver executar_coordenador).
+ *   --processos <n>: quantidade de trabalhadores locais iniciados pelo
+ *   coordenador (padrão 0, apenas trabalhadores iniciados externamente).
+ *   --sem-compartilhar: o coordenador não repassa aos trabalhadores a melhor
+ *   solução conhecida, mantendo as execuções independentes.
+ *   --trabalhador <socket>: realiza as execuções atribuídas pelo coordenador
+ *   do socket informado. A instância e os parâmetros do método devem ser os
+ *   mesmos do coordenador, que recusa o trabalhador caso contrário.
+ *   --sem-paginas-grandes: aloca as tabelas grandes (matriz de adjacência,
+ *   matriz compacta, listas de vizinhos e cache de distâncias) em páginas
+ *   normais. Por padrão são utilizadas páginas grandes de 2 MB, explícitas
+ *   ou transparentes, quando disponíveis, nas tabelas de pelo menos 2 MB (ver
+ *   alocar_memoria); o modo obtido é sempre exibido na saída de erros.
+ *   --benchmark-memoria <n>: compara, com n avaliações, o cálculo de custo
+ *   com a matriz de adjacência em páginas normais e em páginas grandes e
+ *   encerra o programa.
+ *   --benchmark-kernels <n>: compara, com n avaliações, o cálculo de custo
+ *   genérico com cada kernel especializado compatível com a instância e
+ *   encerra o programa.
+ *   --verificar-vizinhancas <k>: confere, em VNDs completos a partir de k
+ *   soluções aleatórias, as avaliações em O(1) da varredura unificada, da
+ *   tabela de ganhos e da avaliação vetorial com as funções realizar_* (ver
+ *   verificar_vizinhancas) e encerra o programa, com código de saída 1 em
+ *   caso de divergência. Destinada às instâncias pequenas.
+ *
+ *   Instâncias com até TAMANHO_MAXIMO_EXATO elementos executadas sem alvo são
+ *   resolvidas uma única vez pelo método exato, no lugar das execuções do GVNS.
  *
  *   Ao término da execução do programa a seguinte saida é exibida na tela (caso
  *   o programa não esteja em modo debug):
@@ -102,1194 +161,614 @@ void linha();
  *
  *   Exemplo:
  *   teste.txt;560;0.03;800;0.05;700;0.06
+ *
+ *   Ajuste de parâmetros:
+ *   --ajuste <lista> <execucoes> [--iteracoes a,b,...] [--vizinhancas a,b,...]
+ *   [--construcao a,b,...] [--threads n] [--corrida] [--vnd-localizado]
+ *   Lê uma única vez as instâncias relacionadas no arquivo de lista (um
+ *   caminho por linha) e avalia todas as combinações dos valores informados
+ *   (os parâmetros não informados utilizam o valor padrão), com execucoes
+ *   sementes por instância, em paralelo. Com --corrida as configurações
+ *   claramente piores são eliminadas a cada rodada. A melhor configuração de
+ *   cada classe de instâncias (tamanho) é impressa (ver executar_ajuste).
+ *
+ *   No experimento time-to-target as execuções são realizadas em paralelo,
+ *   ignorando a quantidade de iterações: cada execução continua até alcançar
+ *   o alvo ou esgotar o tempo máximo. A saída é a distribuição empírica do
+ *   tempo de relógio até o alvo, já ordenada e com a probabilidade acumulada
+ *   de cada execução (ver imprimir_ttt):
+ *   <NOME_ARQUIVO>;<K>;<TEMPO>;<PROBABILIDADE>;<EXECUCAO>;<VALOR>
+ *   <NOME_ARQUIVO>;<ALCANCADAS>;<EXECUCOES>;<TEMPO_MEDIO>
+ *
+ *   Modo serviço:
+ *   --servico <socket|-> [--threads n] [--cache-instancias k]
+ *   [--sem-paginas-grandes]
+ *   Permanece em execução atendendo requisições JSON, uma por linha, dos
+ *   clientes conectados ao socket de domínio Unix informado ou da entrada
+ *   padrão ("-"), com as respostas na saída padrão. As execuções de todas as
+ *   requisições são distribuídas entre n threads (por padrão, uma por
+ *   processador) e as k instâncias usadas mais recentemente (padrão
+ *   SERVICO_CAPACIDADE_CACHE_PADRAO) permanecem em memória, com o seu
+ *   contexto pré-processado. O formato das requisições e das respostas é
+ *   descrito em servico.c.
  */
 int main(int argc, char *argv[]) {
     int* solucao;
-    int iteracoes;
-    int vizinhancas;
-    int construcao_aleatoria;
     int execucoes;
-    clock_t inicio;
+    int modo_exato = TRUE;
+    int alvo_exato = FALSE;
+    int resolvido = FALSE;
+    char* arquivo_checkpoint = NULL;
+    int intervalo_checkpoint = CHECKPOINT_INTERVALO_PADRAO;
+    int retomar = FALSE;
+    int inicio_execucoes = 0;
+    int ttt = FALSE;
+    int threads = 0;
+    int intercaladas = 0;
+    double tempo_maximo = TTT_TEMPO_MAXIMO_PADRAO;
+    char* arquivo;
+    char* arquivo_contexto = NULL;
+    char* socket_coordenador = NULL;
+    char* socket_trabalhador = NULL;
+    char* arquivo_rastro = NULL;
+    char* arquivo_perfil = NULL;
+    char* arquivo_solucao_inicial = NULL;
+    char* arquivo_alteracoes = NULL;
+    char* arquivo_gravacao = NULL;
+    int melhor_execucao = 0;
+    int renumerar = FALSE;
+    int* ordem = NULL;
+    double intervalo_progresso = 0;
+    struct progresso* progresso = NULL;
+    long long capacidade_rastro = RASTRO_CAPACIDADE_PADRAO;
+    int processos = 0;
+    int compartilhar = TRUE;
+    double tempo_anterior;
+    double inicio;
+    int erro;
     struct problema p;
+    struct opcoes opcoes;
+    struct solucionador* s;
     struct informacao_execucao* informacoes_execucao;
     
+    inicializar_opcoes(&opcoes);
+    
+    if(argc >= 3 && strcmp(argv[1], "--servico") == 0) {
+        int capacidade_cache = SERVICO_CAPACIDADE_CACHE_PADRAO;
+        
+        for(int k = 3; k < argc; k++) {
+            if(strcmp(argv[k], "--threads") == 0 && k + 1 < argc) {
+                threads = atoi(argv[++k]);
+            } else if(strcmp(argv[k], "--cache-instancias") == 0 && k + 1 < argc) {
+                capacidade_cache = atoi(argv[++k]);
+            } else if(strcmp(argv[k], "--sem-paginas-grandes") == 0) {
+                opcoes.paginas_grandes = FALSE;
+            }
+        }
+        
+        return executar_servico(argv[2], threads, capacidade_cache, opcoes.paginas_grandes) ? 0 : 1;
+    }
+    
+    if(argc >= 4 && strcmp(argv[1], "--ajuste") == 0) {
+        int* valores[3] = {NULL, NULL, NULL};
+        int quantidades[3] = {1, 1, 1};
+        int corrida = FALSE;
+        int busca_localizada = FALSE;
+        struct ajuste* a;
+        int resultado = 1;
+        
+        for(int k = 4; k < argc; k++) {
+            if(strcmp(argv[k], "--iteracoes") == 0 && k + 1 < argc) {
+                quantidades[0] = ler_valores(argv[++k], &valores[0]);
+            } else if(strcmp(argv[k], "--vizinhancas") == 0 && k + 1 < argc) {
+                quantidades[1] = ler_valores(argv[++k], &valores[1]);
+            } else if(strcmp(argv[k], "--construcao") == 0 && k + 1 < argc) {
+                quantidades[2] = ler_valores(argv[++k], &valores[2]);
+            } else if(strcmp(argv[k], "--threads") == 0 && k + 1 < argc) {
+                threads = atoi(argv[++k]);
+            } else if(strcmp(argv[k], "--corrida") == 0) {
+                corrida = TRUE;
+            } else if(strcmp(argv[k], "--vnd-localizado") == 0) {
+                busca_localizada = TRUE;
+            }
+        }
+        
+        //parâmetros não informados utilizam o valor padrão
+        for(int k = 0; k < 3; k++) {
+            if(!valores[k]) {
+                valores[k] = malloc(sizeof(int));
+                valores[k][0] = k == 0 ? opcoes.iteracoes : k == 1 ? opcoes.vizinhancas : opcoes.construcao_aleatoria;
+            }
+        }
+        
+        a = criar_ajuste(argv[2], atoi(argv[3]), threads, corrida);
+        
+        if(a) {
+            a->opcoes.busca_localizada = busca_localizada;
+            definir_grade_ajuste(a, valores[0], quantidades[0], valores[1], quantidades[1], valores[2], quantidades[2]);
+            executar_ajuste(a);
+            liberar_ajuste(a);
+            resultado = 0;
+        }
+        
+        for(int k = 0; k < 3; k++) {
+            free(valores[k]);
+        }
+        
+        return resultado;
+    }
     
    if(argc >= 7) {
        //lendo o arquivo da instância
-       ler_arquivo(&p, argv[1]);
+       arquivo = argv[1];
+       
+       //a matriz de adjacência é alocada durante a leitura do arquivo
+       for(int a = 7; a < argc; a++) {
+           if(strcmp(argv[a], "--sem-paginas-grandes") == 0) {
+               opcoes.paginas_grandes = FALSE;
+           }
+       }
+       
+       erro = ler_arquivo(&p, arquivo, opcoes.paginas_grandes);
+       
+       if(erro) {
+           printf("Não foi possível ler a instância %s: %s\n", arquivo, descrever_erro(erro));
+           return 1;
+       }
         
-       iteracoes = atoi(argv[2]);
-       vizinhancas = atoi(argv[3]);
-       construcao_aleatoria = atoi(argv[4]);
+       opcoes.iteracoes = atoi(argv[2]);
+       opcoes.vizinhancas = atoi(argv[3]);
+       opcoes.construcao_aleatoria = atoi(argv[4]);
        execucoes = atoi(argv[5]);
        
-       debug = atoi(argv[6]);
-       debug_caminhos = debug;
+       opcoes.debug = atoi(argv[6]);
+       opcoes.debug_caminhos = opcoes.debug;
        
-       if(argc == 8) {
-           alvo = atoi(argv[7]);
+       for(int a = 7; a < argc; a++) {
+           if(strcmp(argv[a], "--heuristico") == 0) {
+               modo_exato = FALSE;
+           } else if(strcmp(argv[a], "--alvo-exato") == 0) {
+               alvo_exato = TRUE;
+           } else if(strcmp(argv[a], "--cache-linhas") == 0 && a + 1 < argc) {
+               opcoes.linhas_cache = atoi(argv[++a]);
+           } else if(strcmp(argv[a], "--checkpoint") == 0 && a + 1 < argc) {
+               arquivo_checkpoint = argv[++a];
+           } else if(strcmp(argv[a], "--intervalo-checkpoint") == 0 && a + 1 < argc) {
+               intervalo_checkpoint = atoi(argv[++a]);
+           } else if(strcmp(argv[a], "--resume") == 0) {
+               retomar = TRUE;
+           } else if(strcmp(argv[a], "--vnd-localizado") == 0) {
+               opcoes.busca_localizada = TRUE;
+           } else if(strcmp(argv[a], "--varredura-unificada") == 0) {
+               opcoes.varredura_unificada = VARREDURA_POR_VIZINHANCA;
+           } else if(strcmp(argv[a], "--varredura-unificada-geral") == 0) {
+               opcoes.varredura_unificada = VARREDURA_MELHOR_GERAL;
+           } else if(strcmp(argv[a], "--sem-tabela-ganhos") == 0) {
+               opcoes.tabela_ganhos = FALSE;
+           } else if(strcmp(argv[a], "--sem-avaliacao-vetorial") == 0) {
+               opcoes.avaliacao_vetorial = FALSE;
+           } else if(strcmp(argv[a], "--construcoes") == 0 && a + 1 < argc) {
+               opcoes.construcoes = atoi(argv[++a]);
+           } else if(strcmp(argv[a], "--elite") == 0 && a + 1 < argc) {
+               opcoes.elite = atoi(argv[++a]);
+           } else if(strcmp(argv[a], "--threads-construcao") == 0 && a + 1 < argc) {
+               opcoes.threads_construcao = atoi(argv[++a]);
+           } else if(strcmp(argv[a], "--contexto") == 0) {
+               arquivo_contexto = malloc(strlen(arquivo) + strlen(".contexto") + 1);
+               sprintf(arquivo_contexto, "%s.contexto", arquivo);
+           } else if(strcmp(argv[a], "--rastro") == 0 && a + 1 < argc) {
+               arquivo_rastro = argv[++a];
+           } else if(strcmp(argv[a], "--rastro-capacidade") == 0 && a + 1 < argc) {
+               capacidade_rastro = atoll(argv[++a]);
+           } else if(strcmp(argv[a], "--perfil") == 0 && a + 1 < argc) {
+               arquivo_perfil = argv[++a];
+           } else if(strcmp(argv[a], "--intercalar") == 0 && a + 1 < argc) {
+               intercaladas = atoi(argv[++a]);
+           } else if(strcmp(argv[a], "--solucao-inicial") == 0 && a + 1 < argc) {
+               arquivo_solucao_inicial = argv[++a];
+           } else if(strcmp(argv[a], "--delta") == 0 && a + 1 < argc) {
+               arquivo_alteracoes = argv[++a];
+           } else if(strcmp(argv[a], "--gravar-solucao") == 0 && a + 1 < argc) {
+               arquivo_gravacao = argv[++a];
+           } else if(strcmp(argv[a], "--renumerar") == 0) {
+               renumerar = TRUE;
+           } else if(strcmp(argv[a], "--progresso") == 0 && a + 1 < argc) {
+               intervalo_progresso = atof(argv[++a]);
+           } else if(strcmp(argv[a], "--ttt") == 0) {
+               ttt = TRUE;
+           } else if(strcmp(argv[a], "--threads") == 0 && a + 1 < argc) {
+               threads = atoi(argv[++a]);
+           } else if(strcmp(argv[a], "--tempo-maximo") == 0 && a + 1 < argc) {
+               tempo_maximo = atof(argv[++a]);
+           } else if(strcmp(argv[a], "--coordenador") == 0 && a + 1 < argc) {
+               socket_coordenador = argv[++a];
+           } else if(strcmp(argv[a], "--processos") == 0 && a + 1 < argc) {
+               processos = atoi(argv[++a]);
+           } else if(strcmp(argv[a], "--sem-compartilhar") == 0) {
+               compartilhar = FALSE;
+           } else if(strcmp(argv[a], "--trabalhador") == 0 && a + 1 < argc) {
+               socket_trabalhador = argv[++a];
+               modo_exato = FALSE;
+           } else if(strcmp(argv[a], "--sem-paginas-grandes") == 0) {
+               //tratado antes da leitura do arquivo
+           } else if(strcmp(argv[a], "--benchmark-memoria") == 0 && a + 1 < argc) {
+               comparar_memoria(&p, atoi(argv[++a]));
+               liberar_problema(&p);
+               return 0;
+           } else if(strcmp(argv[a], "--benchmark-kernels") == 0 && a + 1 < argc) {
+               if(p.kernel) {
+                   printf("Kernel selecionado: %s\n", p.kernel->nome);
+               }
+               comparar_kernels(&p, atoi(argv[++a]));
+               liberar_problema(&p);
+               return 0;
+           } else if(strcmp(argv[a], "--verificar-vizinhancas") == 0 && a + 1 < argc) {
+               long long divergencias = verificar_vizinhancas(&p, atoi(argv[++a]));
+               liberar_problema(&p);
+               return divergencias > 0;
+           } else {
+               opcoes.alvo = atoll(argv[a]);
+           }
        }
     } else {
         //-- configurações de teste
-        ler_arquivo(&p, "/Users/gleissonassis/Dropbox/Mestrado/Implementações/minima-latencia/grasp-minimalatencia/instancias/40_1_100_1000.txt");
+        arquivo = "/Users/gleissonassis/Dropbox/Mestrado/Implementações/minima-latencia/grasp-minimalatencia/instancias/40_1_100_1000.txt";
+        erro = ler_arquivo(&p, arquivo, opcoes.paginas_grandes);
+        
+        if(erro) {
+            printf("Não foi possível ler a instância %s: %s\n", arquivo, descrever_erro(erro));
+            return 1;
+        }
         
-        iteracoes = 1000;
-        vizinhancas = 5;
-        construcao_aleatoria = 1;
+        opcoes.iteracoes = 1000;
+        opcoes.vizinhancas = 5;
+        opcoes.construcao_aleatoria = 1;
         execucoes = 100;
-        debug = 0;
-        debug_caminhos = 0;
-        alvo = 3481;
+        opcoes.debug = 0;
+        opcoes.debug_caminhos = 0;
+        opcoes.alvo = 3481;
     }
     
-    informacoes_execucao = (struct informacao_execucao*) malloc(execucoes * sizeof(struct informacao_execucao));
+    if(arquivo_alteracoes && !arquivo_solucao_inicial) {
+        printf("As alterações (--delta) exigem a solução inicial (--solucao-inicial).\n");
+        liberar_problema(&p);
+        return 1;
+    }
     
-    for(int i = 0; i < execucoes; i++) {
-        srand(i);
-        
-        inicio = clock();
+    //as alterações substituem a instância e devem preceder o contexto
+    if(arquivo_solucao_inicial) {
+        opcoes.solucao_inicial = preparar_reotimizacao(&p, arquivo_solucao_inicial, arquivo_alteracoes, &opcoes.posicoes_afetadas, &opcoes.quantidade_afetadas, &erro);
         
-        solucao = inicializar_solucao(p.tamanho, NULL);
-        if(construcao_aleatoria) {
-            construir_solucao(p, 1, 1, solucao);
-        } else {
-            construir_solucao(p, 0.0001, 0.0001, solucao);
+        if(!opcoes.solucao_inicial) {
+            printf("Não foi possível preparar a reotimização de %s%s%s: %s\n", arquivo_solucao_inicial, arquivo_alteracoes ? " com " : "", arquivo_alteracoes ? arquivo_alteracoes : "", descrever_erro(erro));
+            liberar_problema(&p);
+            return 1;
         }
-        gvns(p, iteracoes, vizinhancas, solucao, solucao);
-        
-        informacoes_execucao[i].tempo = (double)(clock() - inicio) / CLOCKS_PER_SEC;
-        informacoes_execucao[i].valor_encontrado = calcular_custo(p, solucao);
-        informacoes_execucao[i].solucao = inicializar_solucao(p.tamanho, solucao);
         
-        free(solucao);
+        if(opcoes.debug && arquivo_alteracoes) {
+            printf("Instância alterada: %d elementos, %d posições afetadas\n", p.tamanho, opcoes.quantidade_afetadas);
+            linha();
+        }
     }
     
-    long total = 0;
-    double total_execucao = 0;
-    int melhor_valor = INT_MAX;
-    int pior_valor = 0;
-    double tempo_melhor = 0;
-    double tempo_pior = 0;
-    
-    for(int i = 0; i < execucoes; i++) {
-        if(debug) {
-            printf("Execucao: %d\n", i);
-            printf("Valor: %d\n", informacoes_execucao[i].valor_encontrado);
-            printf("Tempo: %.2fs\n", informacoes_execucao[i].tempo);
-            imprimir_solucao(p.tamanho, informacoes_execucao[i].solucao);
-            linha();
+    //a busca utiliza os novos índices; as soluções são traduzidas apenas na saída
+    if(renumerar) {
+        if(opcoes.solucao_inicial) {
+            ordem = inicializar_solucao(p.tamanho, opcoes.solucao_inicial);
+        } else {
+            ordem = ordenar_por_proximidade(&p);
         }
         
-        total += informacoes_execucao[i].valor_encontrado;
-        total_execucao += informacoes_execucao[i].tempo;
-        
-        if(melhor_valor >= informacoes_execucao[i].valor_encontrado) {
-            melhor_valor = informacoes_execucao[i].valor_encontrado;
-            tempo_melhor = informacoes_execucao[i].tempo;
-        }
+        erro = renumerar_problema(&p, ordem);
         
-        if(informacoes_execucao[i].valor_encontrado >= pior_valor) {
-            pior_valor = informacoes_execucao[i].valor_encontrado;
-            tempo_pior = informacoes_execucao[i].tempo;
+        if(erro) {
+            printf("Não foi possível renumerar os elementos: %s\n", descrever_erro(erro));
+            liberar_problema(&p);
+            return 1;
         }
         
-        if(alvo > 0) {
-            printf("%s;%d;%d;%.2f\n", argv[1], i, informacoes_execucao[i].valor_encontrado, informacoes_execucao[i].tempo);
+        if(opcoes.solucao_inicial) {
+            renumerar_solucao(p.tamanho, ordem, opcoes.solucao_inicial);
         }
-        
-        free(informacoes_execucao[i].solucao);
     }
     
-    printf("%s;%d;%.2f;%d;%.2f;%.2f;%.2f\n", argv[1], melhor_valor, tempo_melhor, pior_valor, tempo_pior, (double)(total / execucoes), (double)(total_execucao / execucoes));
-    
-    free(p.elementos);
-    free(informacoes_execucao);
+    //dados derivados apenas da instância, compartilhados por todas as execuções
+    erro = preparar_contexto(&p, arquivo_contexto);
+    free(arquivo_contexto);
     
-    return 0;
-}
-
-// * -----------------------------------------------------------------------------
-// * Bloco de funções básicas para a implementação do método GVNS
-// * -----------------------------------------------------------------------------
-
-/*
- * Function: calcular_custo
- * -----------------------------------------------------------------------------
- *   Calcula o custo de uma solução.
- *
- *   p: estrutura de dados representando o problema.
- *   solucao: solução que terá o custo avaliado.
- */
-int calcular_custo(struct problema p, int* solucao) {
-    int custo = 0;
-    int i;
-    if(!solucao) {
-        printf("!!!!!!");
-    }
-    for(i = 0; i < p.tamanho; i++) {
-        custo += p.elementos[solucao[i]][solucao[i + 1]] * (p.tamanho - i);
+    if(erro) {
+        printf("Não foi possível preparar o contexto da instância: %s\n", descrever_erro(erro));
+        free(opcoes.solucao_inicial);
+        free(ordem);
+        liberar_problema(&p);
+        return 1;
     }
     
-    return custo;
-}
-
-/*
- * Function: construir_solucao
- * -----------------------------------------------------------------------------
- *   Constroi um solução viável para o problema. A construção pode ser gulosa
- *   ou aleatória, dependendo dos parâmetros informados como percentual_inicial
- *   e percentual_final.
- *
- *   p: estrutura de dados representando o problema.
- *   percentual_inicial: indica o percentual inicial de elementos que serão
- *   analisados para a construção do caminho.
- *   percentual_final: indica o percentual final de elementos que serão
- *   analisados para a construção do caminho.
- *   solucao: solucao gerada.
- */
-void construir_solucao(struct problema p, float percentual_inicial, float percentual_final, int* solucao) {
-    int iv, indice_selecionado, indice_selecionado2;
-    int *inserido;
-    struct nodo *vizinhos;
-    int numero_candidatos;
-    float taxa_crescimento, percentual_atual;
-    
-    //estabelecendo o numero de candidatos a entrar no solucao
-    numero_candidatos = ceil(percentual_inicial * p.tamanho);
-    
-    taxa_crescimento = (percentual_final - percentual_inicial) / p.tamanho;
-    
-    percentual_atual = percentual_inicial + taxa_crescimento;
-    
-    //alocando memoria para o array que ira informar se um elemento
-    //ja foi inserido no solucao ou nao e inicializando os valores
-    inserido = malloc(p.tamanho * sizeof(int));
-    for(int i = 0; i < p.tamanho; i++) {
-        inserido[i] = FALSE;
+    //o modo obtido é exibido na saída de erros para não alterar a saída dos resultados
+    if(p.elementos) {
+        fprintf(stderr, "Matriz de adjacência: %s\n", descrever_modo_memoria(modo_memoria(p.elementos[0])));
     }
     
-    //alocando memoria para o array que irá armazenar informações sobre a vizinhança
-    //do elemento atual
-    vizinhos = (struct nodo*) malloc((p.tamanho) * sizeof(struct nodo));
+    if(p.contexto) {
+        fprintf(stderr, "Listas de vizinhos: %s\n", descrever_modo_memoria(modo_memoria(p.contexto->vizinhos)));
+    }
     
-    solucao[0] = 0;
-    inserido[0] = TRUE;
+    informacoes_execucao = (struct informacao_execucao*) malloc(execucoes * sizeof(struct informacao_execucao));
     
-    for(int i = 0; i < p.tamanho; i++) {
-        //indice do vizinho atual;
-        iv = 0;
+    if(p.tamanho <= TAMANHO_LIMITE_EXATO && (alvo_exato || (modo_exato && opcoes.alvo == 0 && p.tamanho <= TAMANHO_MAXIMO_EXATO))) {
+        inicio = relogio();
         
-        //construindo a lista de vizinhos e seus respectivos valores
-        for(int j = 0; j < p.tamanho; j++) {
-            //nao pode ser selecionado um elemento que ja esteja no solucao
-            if(!inserido[j]) {
-                vizinhos[iv].indice = j;
-                vizinhos[iv].valor = p.elementos[i][j];
-                
-                iv++;
-            }
-        }
+        solucao = inicializar_solucao(p.tamanho, NULL);
+        long long valor_exato = resolver_exato(&p, solucao);
         
-        if(iv == 0) {
-            solucao[i + 1] = 0;
-            //printf("Vertice inserido no solucao: %d\n", solucao[i + 1]);
-        } else {
-            //ordenando a lista de vizinhos por custo da aresta
-            selection_sort(vizinhos, iv);
-            
-            //selecionando um elemento aleatorio para entrar no solucao
-            do {
-                if(numero_candidatos > iv) {
-                    indice_selecionado = rand() % iv;
-                    indice_selecionado2 = rand() % iv;
-                } else {
-                    indice_selecionado = rand() % numero_candidatos;
-                    indice_selecionado2 = rand() % numero_candidatos;
-                }
+        if(valor_exato >= 0) {
+            if(alvo_exato) {
+                opcoes.alvo = valor_exato;
                 
-                if(!inserido[vizinhos[indice_selecionado2].indice] && vizinhos[indice_selecionado].valor > vizinhos[indice_selecionado2].valor) {
-                    indice_selecionado = indice_selecionado2;
+                if(opcoes.debug) {
+                    printf("Alvo calculado pelo método exato: %lld\n", opcoes.alvo);
+                    
+                    if(ordem) {
+                        traduzir_solucao(p.tamanho, ordem, solucao);
+                    }
+                    
+                    imprimir_solucao(p.tamanho, solucao);
+                    linha();
                 }
-            } while(inserido[vizinhos[indice_selecionado].indice] == TRUE);
-            solucao[i + 1] = vizinhos[indice_selecionado].indice;
-            inserido[vizinhos[indice_selecionado].indice] = TRUE;
-            
-            //printf("Vertice inserido no solucao: %d\n", solucao[i + 1]);
-            
-            numero_candidatos = ceil(percentual_atual * p.tamanho);
-            percentual_atual += taxa_crescimento;
-            
+            } else {
+                //a solução ótima é a mesma para todas as execuções
+                execucoes = 1;
+                informacoes_execucao[0].tempo = relogio() - inicio;
+                informacoes_execucao[0].valor_encontrado = valor_exato;
+                informacoes_execucao[0].solucao = inicializar_solucao(p.tamanho, solucao);
+                resolvido = TRUE;
+            }
+        } else if(opcoes.debug) {
+            printf("Memória insuficiente para o método exato, utilizando o GVNS.\n");
         }
+        
+        free(solucao);
     }
     
-    //liberando memoria alocada para os arrays
-    free(inserido);
-    free(vizinhos);
-}
-
-/*
- * Function: encontrar_melhor_vizinho
- * -----------------------------------------------------------------------------
- *   Constroi um solução viável para o problema. A construção pode ser gulosa
- *   ou aleatória, dependendo dos parâmetros informados como percentual_inicial
- *   e percentual_final.
- *
- *   p: estrutura de dados representando o problema.
- *   solucao_inicial: solução inicial que terá a vizinhaça explorada.
- *   vizinhanca: número da vizinhança que será avaliada.
- *   solucao_resultado: melhor vizinho encontrado ao explorar a vizinhança
- *   informada.
- */
-void encontrar_melhor_vizinho(struct problema p, int* solucao_inicial, int vizinhanca, int* solucao_resultado) {
-    switch (vizinhanca) {
-        case 0:
-            realizar_swap(p, solucao_inicial, solucao_resultado);
-            break;
-        case 1:
-            realizar_2opt(p, solucao_inicial, solucao_resultado);
-            break;
-        case 2:
-            realizar_insercao(p, solucao_inicial, solucao_resultado);
-            break;
-        case 3:
-            realizar_oropt2(p, solucao_inicial, solucao_resultado);
-            break;
-        case 4:
-            realizar_oropt3(p, solucao_inicial, solucao_resultado);
-            break;
-        default:
-            break;
-    }
-}
-
-/*
- * Function: vnd
- * -----------------------------------------------------------------------------
- *   O método VND faz uma busca local em todas as vizinhanças informadas.
- *
- *   Princípios básicos:
- *   1) Um ótimo local com relação a uma vizinhança não necessariamente
- *      corresponde a um ótimo com relação a outra vizinhança.
- *   2) Um ótimo global corresponde a um ótimo local para todas as estruturas
- *      de vizinhança
- *   3) Para muitos problemas, ótimos locais com relação a uma vizinhança são
- *      relativamente próximos.
- *
- *   Referência:
- *   http://www.decom.ufop.br/marcone/Disciplinas/InteligenciaComputacional/VNS.ppt
- *
- *   p: estrutura de dados representando o problema.
- *   vizinhancas: número de vizinhanças que serão exploradas.
- *   solucao_inicial: solução inicial que terá a vizinhaça explorada.
- *   solucao_resultado: melhor vizinho encontrado ao explorar as vizinhanças
- *   informadas.
- */
-void vnd(struct problema p, int vizinhancas, int* solucao_inicial, int* solucao_resultado) {
-    int custo = INT_MAX;
-    int custo_tmp = 0;
-    
-    copiar_solucao(p.tamanho, solucao_inicial, solucao_resultado);
-    int* solucao_tmp = inicializar_solucao(p.tamanho, solucao_inicial);
-    
-    custo = calcular_custo(p, solucao_inicial);
-    
-    int vizinhanca = 0;
-    
-    while (vizinhanca < vizinhancas) {
-        if(custo <= alvo) {
-            return;
+    if(ttt && !resolvido) {
+        if(opcoes.alvo <= 0) {
+            printf("O experimento time-to-target exige um alvo.\n");
+            liberar_problema(&p);
+            free(informacoes_execucao);
+            return 1;
         }
         
-        if(debug) {
-            printf("Iniciando a exploração da vizinhança: %d\n", vizinhanca);
-        }
+        //as execuções terminam apenas pelo alvo ou pelo tempo máximo
+        opcoes.iteracoes = INT_MAX;
+        opcoes.tempo_maximo = tempo_maximo;
+        opcoes.debug = 0;
+        opcoes.debug_caminhos = 0;
         
-        encontrar_melhor_vizinho(p, solucao_resultado, vizinhanca, solucao_tmp);
+        struct resultado_ttt* resultados = executar_ttt(&p, &opcoes, execucoes, threads);
+        imprimir_ttt(arquivo, resultados, execucoes);
         
-        custo_tmp = calcular_custo(p, solucao_tmp);
+        free(resultados);
+        liberar_problema(&p);
+        free(informacoes_execucao);
         
-        if(custo_tmp < custo) {
-            copiar_solucao(p.tamanho, solucao_tmp, solucao_resultado);
-            custo = custo_tmp;
-            
-            if(debug) {
-                printf("VND - Custo melhorado (v=%d): %d\n", vizinhanca, custo);
-                imprimir_solucao(p.tamanho, solucao_resultado);
-            }
-            
-            vizinhanca = 0;
-        } else {
-            vizinhanca++;
-        }
+        return 0;
     }
     
-    free(solucao_tmp);
-}
-
-
-/*
- * Function: gerar_vizinho_aleatorio
- * -----------------------------------------------------------------------------
- *   Função que abala uma solução com o objetivo de explorar de forma melhor
- *   o espaço de soluções.
- *
- *   p: estrutura de dados representando o problema.
- *   vizinhanca: vizinhança que será utilizada para gerar uma nova solução.
- *   solucao: solução que terá a vizinhaça explorada.
- *   solucao_resultado: melhor vizinho encontrado ao explorar as vizinhanças
- *   informadas.
- */
-void gerar_vizinho_aleatorio(struct problema p, int vizinhanca, int* solucao, int* solucao_resultado) {
-    int tmp1;
-    int tmp2;
-    int tmp3;
-    int i;
-    int j;
-    
-    copiar_solucao(p.tamanho, solucao, solucao_resultado);
-    
-    switch (vizinhanca) {
-        case 0:
-            i = rnd(1, p.tamanho - 1);
-            j = rnd(1, p.tamanho - 1);
-            
-            if(debug) {
-                printf("swap aleatorio entre %d e %d\n", i, j);
-            }
-            
-            tmp1 = solucao_resultado[i];
-            solucao_resultado[i] = solucao_resultado[j];
-            solucao_resultado[j] = tmp1;
-            break;
-        case 1:
-            i = rnd(1, p.tamanho / 2);
-            j = rnd(i + 2, p.tamanho - 1);
-            
-            if(debug) {
-                printf("2opt aleatorio entre %d e %d\n", i, j);
-            }
-            
-            realizar_swap_2opt(p, solucao_resultado, i, j, solucao_resultado);
-            break;
-        case 2:
-            i = rnd(1, p.tamanho - 2);
-            do{
-                j = rnd(i, p.tamanho - 1);
-            }while(i == j);
-            
-            if(debug) {
-                printf("insercao aleatoria entre %d e %d\n", i, j);
-            }
-            
-            tmp1 = solucao_resultado[i];
-            
-            for(int k = i; k <= j; k++) {
-                solucao_resultado[k] = solucao_resultado[k + 1];
-            }
-            solucao_resultado[j] = tmp1;
-            break;
-        case 3:
-            i = rnd(1, p.tamanho / 2);
-            j = rnd(i + 2, p.tamanho - 2);
-            
-            tmp1 = solucao_resultado[i];
-            tmp2 = solucao_resultado[i + 1];
-            
-            if(debug) {
-                printf("or opt2 aleatoria entre %d e %d\n", i, j);
-            }
-            
-            solucao_resultado[i] = solucao_resultado[j];
-            solucao_resultado[i + 1] = solucao_resultado[j + 1];
-            solucao_resultado[j] = tmp1;
-            solucao_resultado[j + 1] = tmp2;
-            break;
-        case 4:
-            i = rnd(1, (p.tamanho-1) / 2);
-            j = rnd(i + 3, p.tamanho - 3);
-            
-            tmp1 = solucao_resultado[i];
-            tmp2 = solucao_resultado[i + 1];
-            tmp3 = solucao_resultado[i + 2];
-            
-            if(debug) {
-                printf("or opt3 aleatoria entre %d e %d\n", i, j);
-            }
-            
-            solucao_resultado[i] = solucao_resultado[j];
-            solucao_resultado[i + 1] = solucao_resultado[j + 1];
-            solucao_resultado[i + 2] = solucao_resultado[j + 2];
-            solucao_resultado[j] = tmp1;
-            solucao_resultado[j + 1] = tmp2;
-            solucao_resultado[j + 2] = tmp3;
-            break;
-        default:
-            break;
+    if(socket_trabalhador) {
+        opcoes.debug = 0;
+        opcoes.debug_caminhos = 0;
+        
+        int concluido = executar_trabalhador(&p, &opcoes, socket_trabalhador);
+        
+        liberar_problema(&p);
+        free(informacoes_execucao);
+        
+        return concluido ? 0 : 1;
     }
-}
-
-/*
- * Function: vns
- * -----------------------------------------------------------------------------
- *   O método General VNS (GVNS) realiza busca local do VNS feita pelo VND.
- *
- *   1) Proposto por Nenad Mladenovic & Pierre Hansen em 1997
- *   2) Metaheurísticas de busca local que explora o espaço de soluções através
- *   de trocas sistemáticas de estruturas de vizinhança.
- *   3) Explora vizinhanças gradativamente mais “distantes”
- *   4) Focaliza a busca em torno de uma nova solução somente se um movimento
- *   de melhora é realizado.
- *
- *   Referência:
- *   http://www.decom.ufop.br/marcone/Disciplinas/InteligenciaComputacional/VNS.ppt
- *
- *   p: estrutura de dados representando o problema.
- *   iteracoes: número de iterações para o método.
- *   vizinhancas: número de vizinhanças que serão exploradas.
- *   solucao_inicial: solução inicial que terá a vizinhaça explorada.
- *   solucao_resultado: melhor vizinho encontrado ao explorar as vizinhanças
- *   informadas.
- */
-void gvns(struct problema p, int iteracoes, int vizinhancas, int* solucao_inicial, int* solucao_resultado) {
-    int custo = INT_MAX;
-    int custo_tmp = 0;
-    int vizinhanca = 0;
-    
-    int* solucao_tmp = inicializar_solucao(p.tamanho, solucao_inicial);
-    copiar_solucao(p.tamanho, solucao_inicial, solucao_resultado);
     
-    for(int i = 0; i < iteracoes; i++) {
-        if(debug) {
-            printf("Iniciando o processo na iteração %d. Melhor custo %d", i, custo);
-            linha();
-        }
+    if(socket_coordenador && !resolvido) {
+        struct opcoes opcoes_trabalhadores = opcoes;
         
-        vizinhanca = 0;
+        opcoes_trabalhadores.debug = 0;
+        opcoes_trabalhadores.debug_caminhos = 0;
         
-        while (vizinhanca <= vizinhancas) {
-            if(custo <= alvo) {
-                return;
+        if(!executar_coordenador(&p, &opcoes_trabalhadores, socket_coordenador, processos, execucoes, compartilhar, informacoes_execucao)) {
+            for(int i = 0; i < execucoes; i++) {
+                free(informacoes_execucao[i].solucao);
             }
-            gerar_vizinho_aleatorio(p, vizinhanca, solucao_resultado, solucao_tmp);
             
-            vnd(p, vizinhancas, solucao_tmp, solucao_tmp);
+            liberar_problema(&p);
+            free(informacoes_execucao);
             
-            custo_tmp = calcular_custo(p, solucao_tmp);
-            
-            if(custo_tmp < custo) {
-                copiar_solucao(p.tamanho, solucao_tmp, solucao_resultado);
-                custo = custo_tmp;
-                
-                if(debug) {
-                    printf("Custo melhorado (GVNS v=%d): %d\n", vizinhanca, custo);
-                }
-                
-                vizinhanca = 0;
-            } else {
-                if(custo_tmp > custo) {
-                    realizar_path_relinking(p, solucao_tmp, solucao_resultado, solucao_tmp);
-                    custo_tmp = calcular_custo(p, solucao_tmp);
-                
-                    if(custo_tmp < custo) {
-                        copiar_solucao(p.tamanho, solucao_tmp, solucao_resultado);
-                        custo = custo_tmp;
-                    
-                        if(debug) {
-                            printf("Custo melhorado (PATH): %d\n", custo);
-                        }
-                    
-                        vizinhanca = 0;
-                    } else {
-                        vizinhanca++;
-                    }
-                } else {
-                    vizinhanca++;
-                }
-            }
+            return 1;
         }
-    }
-}
-
-// * -----------------------------------------------------------------------------
-// * Bloco de funções que implementam os movimentos de exploração de vizinhança.
-// * -----------------------------------------------------------------------------
-
-/*
- * Function: realizar_random_double_bridge
- * -----------------------------------------------------------------------------
- *   O movimento double-bridge consiste em remover 4 arcos e reconectar o
- *   caminho gerando uma nova solução viável para o problema. Ao invés de
- *   selecionar arcos fixos (geralmente quebrando a solução em 4 partes iguais),
- *   arcos aleatórios são selecionados, visto que essa função é utilizada como
- *   shake do método GVNS.
- *
- *   p: estrutura de dados representando o problema
- *   solucao: solucao que terá sua vizinhança explorada.
- *   solucao_resultado: a melhor solução encontrada após a execução do método.
- */
-void realizar_random_double_bridge(struct problema p, int* solucao, int* solucao_resultado) {
-    int i, j;
-    int tmp1, tmp2;
-    
-    i = rnd(2, p.tamanho / 2);
-    j = rnd(i + 2, p.tamanho - 1);
-    
-    copiar_solucao(p.tamanho, solucao, solucao_resultado);
-    
-    tmp1 = solucao_resultado[i];
-    tmp2 = solucao_resultado[i - 1];
-    
-    solucao_resultado[i] = solucao_resultado[j];
-    solucao_resultado[i - 1] = solucao_resultado[j - 1];
-    solucao_resultado[j] = tmp1;
-    solucao_resultado[j - 1] = tmp2;
-}
-
-/*
- * Function: realizar_swap
- * -----------------------------------------------------------------------------
- *   O movimento swap consiste em selecionar 2 elementos da solução e realizar
- *   a troca de posição.
- *
- *   p: estrutura de dados representando o problema
- *   solucao: solucao que terá sua vizinhança explorada.
- *   solucao_resultado: a melhor solução encontrada após a execução do método.
- */
-void realizar_swap(struct problema p, int* solucao, int* solucao_resultado) {
-    int i,j;
-    int custo, custo_tmp, custo_inicial;
-    int *solucao_tmp;
-    int *solucao_inicial;
-    int tmp;
-    
-    custo_inicial = custo = calcular_custo(p, solucao);
-    
-    solucao_tmp = inicializar_solucao(p.tamanho, NULL);
-    solucao_inicial = inicializar_solucao(p.tamanho, solucao);
-    
-    
-    if(debug && debug_caminhos) {
-        printf("\nTentando localizar melhor vizinho na vizinhanca swap\n");
-        imprimir_solucao(p.tamanho, solucao);
-        linha();
+        
+        resolvido = TRUE;
     }
     
-    for(i = 1; i < p.tamanho; i++) {
-        for(j = i + 1; j < p.tamanho; j++) {
-            if(custo <= alvo) {
-                return;
-            }
-            
-            copiar_solucao(p.tamanho, solucao_inicial, solucao_tmp);
-            tmp = solucao_tmp[i];
-            solucao_tmp[i] = solucao_tmp[j];
-            solucao_tmp[j] = tmp;
-            
-            custo_tmp = calcular_custo(p, solucao_tmp);
-            
-            if(debug && debug_caminhos) {
-                imprimir_solucao(p.tamanho, solucao_tmp);
-                printf("de %d para %d\n", custo_inicial, custo_tmp);
-            }
-            
-            
-            if(custo_tmp < custo) {
-                custo = custo_tmp;
-                copiar_solucao(p.tamanho, solucao_tmp, solucao_resultado);
-            }
+    if(!resolvido && (arquivo_checkpoint || retomar)) {
+        if(!arquivo_checkpoint) {
+            arquivo_checkpoint = malloc(strlen(arquivo) + strlen(".checkpoint") + 1);
+            sprintf(arquivo_checkpoint, "%s.checkpoint", arquivo);
         }
-    }
-    
-    free(solucao_tmp);
-    free(solucao_inicial);
-}
-
-/*
- * Function: realizar_insercao
- * -----------------------------------------------------------------------------
- *   Implementação da estratégia inserção que consiste basicamente em inserir
- *   um nodo entre outros 2 nodos explorando a vizinhaça de uma solução.
- *
- *   p: estrutura de dados representando o problema.
- *   solucao: solucao que terá sua vizinhança explorada.
- *   solucao_resultado: a melhor solução encontrada após a execução do método.
- */
-void realizar_insercao(struct problema p, int* solucao, int* solucao_resultado) {
-    int custo, custo_tmp, custo_inicial;
-    int* solucao_tmp;
-    int* solucao_inicial;
-    int tmp;
-    
-    custo_inicial = custo = calcular_custo(p, solucao);
-    
-    solucao_inicial = inicializar_solucao(p.tamanho, solucao);
-    
-    if(debug && debug_caminhos) {
-        printf("\nTentando localizar melhor vizinho na vizinhanca inserção\n");
-        imprimir_solucao(p.tamanho, solucao);
-        linha();
-    }
-    
-    solucao_resultado = inicializar_solucao(p.tamanho, solucao);
-    solucao_tmp = inicializar_solucao(p.tamanho, solucao);
-    
-    for(int i = 1; i < p.tamanho; i++) {
-        copiar_solucao(p.tamanho, solucao_inicial, solucao_tmp);
         
-        for(int j = i; j < p.tamanho - 1; j++) {
-            if(custo <= alvo) {
-                return;
-            }
-            
-            tmp = solucao_tmp[j];
-            solucao_tmp[j] = solucao_tmp[j + 1];
-            solucao_tmp[j + 1] = tmp;
-            custo_tmp = calcular_custo(p, solucao_tmp);
-            
-            if(debug && debug_caminhos) {
-                imprimir_solucao(p.tamanho, solucao_tmp);
-                printf("de %d para %d\n", custo_inicial, custo_tmp);
-            }
+        opcoes.checkpoint = iniciar_checkpoint(arquivo_checkpoint, intervalo_checkpoint, &p, &opcoes, execucoes, renumerar, informacoes_execucao);
+        
+        int carregado = retomar ? carregar_checkpoint(opcoes.checkpoint) : FALSE;
+        
+        //o arquivo inválido é preservado para que possa ser retomado com os parâmetros corretos
+        if(carregado < 0) {
+            printf("Não foi possível retomar a partir de %s: %s\n", arquivo_checkpoint, descrever_erro(ERRO_CHECKPOINT));
+            liberar_problema(&p);
+            free(informacoes_execucao);
+            return 1;
+        }
+        
+        if(carregado) {
+            inicio_execucoes = opcoes.checkpoint->estado.concluidas;
             
-            if(custo_tmp < custo) {
-                custo = custo_tmp;
-                copiar_solucao(p.tamanho, solucao_tmp, solucao_resultado);
+            if(opcoes.debug) {
+                printf("Retomando a partir da execução %d\n", inicio_execucoes);
             }
         }
     }
     
-    free(solucao_tmp);
-    free(solucao_inicial);
-}
-
-/*
- * Function: realizar_2opt
- * -----------------------------------------------------------------------------
- *   O método consiste em remover 2 arcos não adjacentes e outros 2 são
- *   inseridos, visando gerar vizinhos de uma dada solução.
- *
- *   p: estrutura de dados representando o problema
- *   solucao: solucao que terá sua vizinhança explorada.
- *   solucao_resultado: a melhor solução encontrada após a execução do método.
- */
-void realizar_2opt(struct problema p, int* solucao, int* solucao_resultado) {
-    int i,j;
-    int custo, custo_tmp, custo_inicial;
-    int* solucao_tmp;
-    int* solucao_inicial;
-    
-    custo_inicial = custo = calcular_custo(p, solucao);
-    
-    solucao_tmp = inicializar_solucao(p.tamanho, NULL);
-    solucao_inicial = inicializar_solucao(p.tamanho, solucao);
+    //as execuções seriais e intercaladas publicam a incumbente em uma única thread
+    if(intervalo_progresso > 0 && !resolvido) {
+        opcoes.incumbente = criar_incumbente(p.tamanho);
+        progresso = iniciar_progresso(opcoes.incumbente, intervalo_progresso);
+    }
     
+    s = criar_solucionador(&p, &opcoes);
     
-    if(debug && debug_caminhos) {
-        printf("\nTentando localizar melhor vizinho na vizinhanca 2-opt\n");
-        imprimir_solucao(p.tamanho, solucao);
-        linha();
+#ifdef SEM_RASTREAMENTO
+    if(arquivo_rastro) {
+        printf("Rastro indisponível: programa compilado com SEM_RASTREAMENTO.\n");
+        arquivo_rastro = NULL;
     }
     
-    for(i = 1; i < p.tamanho - 1; i++) {
-        for(j = i + 1; j < p.tamanho; j++) {
-            if(custo <= alvo) {
-                return;
-            }
-            
-            realizar_swap_2opt(p, solucao_inicial, i, j, solucao_tmp);
-            
-            custo_tmp = calcular_custo(p, solucao_tmp);
-            
-            if(debug && debug_caminhos) {
-                imprimir_solucao(p.tamanho, solucao_tmp);
-                printf("de %d para %d\n", custo_inicial, custo_tmp);
-            }
-            
-            if(custo_tmp < custo) {
-                custo = custo_tmp;
-                copiar_solucao(p.tamanho, solucao_tmp, solucao_resultado);
-            }
-        }
+    if(arquivo_perfil) {
+        printf("Perfil indisponível: programa compilado com SEM_RASTREAMENTO.\n");
+        arquivo_perfil = NULL;
     }
+#endif
     
-    free(solucao_tmp);
-    free(solucao_inicial);
-}
-
-/*
- * Function: realizar_swap_2opt
- * -----------------------------------------------------------------------------
- *   Método auxiliar para a execução da exploração da vizinhança do movimento
- *   2-opt.
- *
- *   p: estrutura de dados representando o problema.
- *   solucao: solucao que terá sua vizinhança explorada.
- *   solucao_resultado: a melhor solução encontrada após a execução do método.
- */
-void realizar_swap_2opt(struct problema p, int* solucao, int i, int k, int* solucao_resultado) {
-    
-    int* solucao_tmp = inicializar_solucao(p.tamanho, solucao);
-    
-    for(int c = 0; c <= i - 1; c++) {
-        solucao_tmp[c] = solucao[c];
+    if(intercaladas > 1 && opcoes.checkpoint) {
+        printf("As execuções intercaladas não são combinadas com o checkpoint; realizando as execuções em série.\n");
+        intercaladas = 0;
     }
     
-    int dec = 0;
-    for(int c = i; c <= k; c++) {
-        solucao_tmp[c] = solucao[k - dec];
-        dec++;
+    if(intercaladas > 1 && arquivo_rastro) {
+        printf("Rastro indisponível nas execuções intercaladas.\n");
+        arquivo_rastro = NULL;
     }
     
-    for(int c = k + 1; c < p.tamanho - 1; c++) {
-        solucao_tmp[c] = solucao[c];
+    if(intercaladas > 1 && arquivo_perfil) {
+        printf("Perfil indisponível nas execuções intercaladas.\n");
+        arquivo_perfil = NULL;
     }
     
-    copiar_solucao(p.tamanho, solucao_tmp, solucao_resultado);
-    free(solucao_tmp);
-}
-
-/*
- * Function: realizar_oropt2
- * -----------------------------------------------------------------------------
- *   O movimento or opt2 consiste em selecionar 2 pares e trocar suas posições.
- *
- *   p: estrutura de dados representando o problema
- *   solucao: solucao que terá sua vizinhança explorada.
- *   solucao_resultado: a melhor solução encontrada após a execução do método.
- */
-void realizar_oropt2(struct problema p, int* solucao, int* solucao_resultado) {
-    int i,j;
-    int custo, custo_tmp, custo_inicial;
-    int* solucao_tmp;
-    int* solucao_inicial;
-    int tmp1, tmp2;
-    
-    custo_inicial = custo = calcular_custo(p, solucao);
+    if(arquivo_rastro) {
+        s->rastro = criar_rastro(capacidade_rastro);
+    }
     
-    solucao_tmp = inicializar_solucao(p.tamanho, NULL);
-    solucao_inicial = inicializar_solucao(p.tamanho, solucao);
+    if(arquivo_perfil) {
+        s->perfil = criar_perfil();
+        descrever_perfil(s->perfil);
+    }
     
-    if(debug && debug_caminhos) {
-        printf("\nTentando localizar melhor vizinho na vizinhanca or2opt\n");
-        imprimir_solucao(p.tamanho, solucao);
-        linha();
+    if(intercaladas > 1 && !resolvido) {
+        executar_intercalado(&p, &opcoes, inicio_execucoes, execucoes, intercaladas, informacoes_execucao);
+        resolvido = TRUE;
     }
     
-    for(i = 1; i < p.tamanho - 1; i++) {
-        copiar_solucao(p.tamanho, solucao_inicial, solucao_tmp);
+    for(int i = inicio_execucoes; i < execucoes && !resolvido; i++) {
+        inicio = relogio();
+        tempo_anterior = 0;
         
-        tmp1 = solucao_tmp[i];
-        tmp2 = solucao_tmp[i + 1];
-        
-        for(j = i + 2; j < p.tamanho - 1; j++) {
-            if(custo <= alvo) {
-                return;
-            }
-            
-            solucao_tmp[j - 2] = solucao_tmp[j];
-            solucao_tmp[j] = tmp2;
-            solucao_tmp[j - 1] = tmp1;
-            
-            custo_tmp = calcular_custo(p, solucao_tmp);
-            
-            if(debug && debug_caminhos) {
-                imprimir_solucao(p.tamanho, solucao_tmp);
-                printf("de %d para %d\n", custo_inicial, custo_tmp);
+        if(opcoes.checkpoint) {
+            if(opcoes.checkpoint->retomar) {
+                tempo_anterior = opcoes.checkpoint->estado.tempo;
             }
             
-            if(custo_tmp < custo) {
-                custo = custo_tmp;
-                copiar_solucao(p.tamanho, solucao_tmp, solucao_resultado);
-            }
+            opcoes.checkpoint->inicio = inicio;
+            opcoes.checkpoint->tempo_anterior = tempo_anterior;
         }
-    }
-    
-    free(solucao_tmp);
-    free(solucao_inicial);
-}
-
-/*
- * Function: realizar_oropt3
- * -----------------------------------------------------------------------------
- *   O movimento or opt3 consiste em selecionar 2 trios e trocar suas posições.
- *
- *   p: estrutura de dados representando o problema
- *   solucao: solucao que terá sua vizinhança explorada.
- *   solucao_resultado: a melhor solução encontrada após a execução do método.
- */
-void realizar_oropt3(struct problema p, int* solucao, int* solucao_resultado) {
-    int i,j;
-    int custo, custo_tmp, custo_inicial;
-    int *solucao_tmp;
-    int *solucao_inicial;
-    int tmp1, tmp2, tmp3;
-    
-    custo_inicial = custo = calcular_custo(p, solucao);
-    
-    solucao_tmp = inicializar_solucao(p.tamanho, NULL);
-    solucao_inicial = inicializar_solucao(p.tamanho, solucao);
-    
-    if(debug && debug_caminhos) {
-        printf("\nTentando localizar melhor vizinho na vizinhanca or3opt\n");
-        imprimir_solucao(p.tamanho, solucao);
-        linha();
-    }
-    
-    for(i = 1; i < p.tamanho - 1; i++) {
-        copiar_solucao(p.tamanho, solucao_inicial, solucao_tmp);
         
-        tmp1 = solucao_tmp[i];
-        tmp2 = solucao_tmp[i + 1];
-        tmp3 = solucao_tmp[i + 2];
+        solucao = inicializar_solucao(p.tamanho, NULL);
         
-        for(j = i + 3; j < p.tamanho - 2; j++) {
-            if(custo <= alvo) {
-                return;
-            }
-            
-            solucao_tmp[j - 3] = solucao_tmp[j];
-            solucao_tmp[j] = tmp3;
-            solucao_tmp[j - 1] = tmp2;
-            solucao_tmp[j - 2] = tmp1;
+        informacoes_execucao[i].valor_encontrado = executar_gvns(s, i, solucao);
+        informacoes_execucao[i].tempo = tempo_anterior + relogio() - inicio;
+        informacoes_execucao[i].solucao = solucao;
         
-            custo_tmp = calcular_custo(p, solucao_tmp);
-            
-            if(debug && debug_caminhos) {
-                imprimir_solucao(p.tamanho, solucao_tmp);
-                printf("de %d para %d\n", custo_inicial, custo_tmp);
-            }
-            
-            if(custo_tmp < custo) {
-                custo = custo_tmp;
-                copiar_solucao(p.tamanho, solucao_tmp, solucao_resultado);
-            }
+        if(opcoes.checkpoint) {
+            concluir_execucao_checkpoint(opcoes.checkpoint, i + 1);
         }
     }
     
-    free(solucao_tmp);
-    free(solucao_inicial);
-}
-
-/*
- * Function: realizar_path_relinking
- * -----------------------------------------------------------------------------
- *   Implementação da estratégia Path Relinking que consiste basicamente em
- *   gerar soluções intermediárias entre 2 caminhos, após cada solução
- *   intermediária gerada contendo componentes da solução final uma busca local
- *   é realizada, explorando a vizinhanção baseada em trocas simples entre 2
- *   elementos, tentando melhorar a solução.
- *
- *   p: estrutura de dados representando o problema.
- *   origem: caminho inicial.
- *   destino: caminho de destino.
- *   solucao_resultado: a melhor solução encontrada após a execução do path
- *   relinking.
- */
-void realizar_path_relinking(struct problema p, int* origem, int* destino, int *solucao_resultado) {
-    int custo;
-    int custo_tmp;
-    int pos;
-    int tmp;
-    int* origem_tmp;
-    int* solucao_swap_tmp;
-    int* lista_restrita;
-    
-    
-    solucao_swap_tmp = inicializar_solucao(p.tamanho, NULL);
-    origem_tmp = inicializar_solucao(p.tamanho, origem);
-    copiar_solucao(p.tamanho, destino, solucao_resultado);
-    lista_restrita = inicializar_solucao(p.tamanho, NULL);
-    
-    custo = calcular_custo(p, destino);
-    
-    for(int i = 0; i <= p.tamanho; i++) {
-        lista_restrita[i] = 0;
+    if(progresso) {
+        finalizar_progresso(progresso);
+        liberar_incumbente(opcoes.incumbente);
     }
     
-    custo = calcular_custo(p, origem);
+    if(opcoes.checkpoint) {
+        finalizar_checkpoint(opcoes.checkpoint);
+    }
     
-    for(int i = 1; i < p.tamanho; i++) {
-        if(destino[i] == origem_tmp[i]) {
-            lista_restrita[i] = 1;
-            continue;
+    if(arquivo_rastro) {
+        if(!gravar_rastro(s->rastro, arquivo_rastro)) {
+            printf("Não foi possível gravar o rastro em %s\n", arquivo_rastro);
         }
         
-        pos = localizar_elemento(origem_tmp, p.tamanho, destino[i], i + 1);
-        
-        tmp = origem_tmp[i];
-        origem_tmp[i] = origem_tmp[pos];
-        origem_tmp[pos] = tmp;
-        
-        lista_restrita[i] = 1;
-        
-        do {
-            if(custo <= alvo) {
-                return;
-            }
-            
-            realizar_swap_restrito(p, origem_tmp, solucao_swap_tmp, lista_restrita);
-            custo_tmp = calcular_custo(p, solucao_swap_tmp);
-            
-            if(custo_tmp < custo) {
-                custo = custo_tmp;
-                copiar_solucao(p.tamanho, solucao_swap_tmp, solucao_resultado);
-            }
-        } while(custo_tmp < custo);
+        liberar_rastro(s->rastro);
     }
     
-    free(origem_tmp);
-    free(solucao_swap_tmp);
-}
-
-/*
- * Function: localizar_elemento
- * -----------------------------------------------------------------------------
- *   Implementação da estratégia Path Relinking que consiste basicamente em
- *   gerar soluções intermediárias entre 2 caminhos, após cada solução
- *   intermediária gerada contendo componentes da solução final uma busca local
- *   é realizada, explorando a vizinhanção baseada em trocas simples entre 2
- *   elementos, tentando melhorar a solução.
- *
- *   solucao: solução que será analisada em busca do elemento.
- *   tamanho: tamanho da solução.
- *   valor: valor que será pesquisado na solução.
- *   posicao_inicial: posição que a busca será iniciada.
- *
- *   returns: posição do valor informado e caso não seja encontrado o valor -1
- *   é retornado.
- */
-int localizar_elemento(int* solucao, int tamanho, int valor, int posicao_inicial) {
-    int i = posicao_inicial;
-    
-    for(; i < tamanho; i++) {
-        if(solucao[i] == valor) {
-            return i;
+    if(arquivo_perfil) {
+        exibir_perfil(s->perfil);
+        
+        if(!gravar_perfil(s->perfil, arquivo_perfil)) {
+            printf("Não foi possível gravar o perfil em %s\n", arquivo_perfil);
         }
+        
+        liberar_perfil(s->perfil);
     }
     
-    return -1;
-}
-
-/*
- * Function: realizar_swap_restrito
- * -----------------------------------------------------------------------------
- *   Método auxiliar para a execuçao do método Path Relinking. O movimento de
- *   troca deve ser realizado apenas nos elementos que não são referentes a
- *   solução destino.
- *
- *   p: estrutura de dados representando o problema.
- *   solucao: solucao que terá sua vizinhança explorada.
- *   solucao_resultado: a melhor solução encontrada após a execução do método.
- *   lista_restrita: lista de elementos que não podem ter suas posições alteradas.
- *   consiste em um vetor de inteiros onde cada posição é marcada como 0 (não é
- *   restrita, ou seja pode ser alterada) ou 1 (é restrita, ou seja, não pode
- *   ser alterada).
- */
-void realizar_swap_restrito(struct problema p, int* solucao, int* solucao_resultado, int* lista_restrita) {
-    int i,j;
-    int custo, custo_tmp, custo_inicial;
-    int *solucao_tmp;
-    int *solucao_inicial;
-    int tmp;
-    
-    custo_inicial = custo = calcular_custo(p, solucao);
-    
-    solucao_tmp = inicializar_solucao(p.tamanho, NULL);
-    solucao_inicial = inicializar_solucao(p.tamanho, solucao);
+    liberar_solucionador(s);
     
-    copiar_solucao(p.tamanho, solucao, solucao_resultado);
-    
-    if(debug && debug_caminhos) {
-        printf("\nTentando localizar melhor vizinho na vizinhanca swap\n");
-        imprimir_solucao(p.tamanho, solucao);
-        linha();
-    }
+    long long total = 0;
+    double total_execucao = 0;
+    long long melhor_valor = LLONG_MAX;
+    long long pior_valor = 0;
+    double tempo_melhor = 0;
+    double tempo_pior = 0;
     
-    for(i = 1; i < p.tamanho; i++) {
-        if(lista_restrita[i]) {
-            continue;
+    for(int i = 0; i < execucoes; i++) {
+        if(ordem) {
+            traduzir_solucao(p.tamanho, ordem, informacoes_execucao[i].solucao);
         }
         
-        for(j = i + 1; j < p.tamanho; j++) {
-            if(lista_restrita[j]) {
-                continue;
-            }
-            
-            copiar_solucao(p.tamanho, solucao_inicial, solucao_tmp);
-            tmp = solucao_tmp[i];
-            solucao_tmp[i] = solucao_tmp[j];
-            solucao_tmp[j] = tmp;
-            
-            custo_tmp = calcular_custo(p, solucao_tmp);
-            
-            if(debug && debug_caminhos) {
-                imprimir_solucao(p.tamanho, solucao_tmp);
-                printf("de %d para %d\n", custo_inicial, custo_tmp);
-            }
-            
-            
-            if(custo_tmp < custo) {
-                custo = custo_tmp;
-                copiar_solucao(p.tamanho, solucao_tmp, solucao_resultado);
-            }
+        if(opcoes.debug) {
+            printf("Execucao: %d\n", i);
+            printf("Valor: %lld\n", informacoes_execucao[i].valor_encontrado);
+            printf("Tempo: %.2fs\n", informacoes_execucao[i].tempo);
+            imprimir_solucao(p.tamanho, informacoes_execucao[i].solucao);
+            linha();
         }
-    }
-    
-    free(solucao_tmp);
-    free(solucao_inicial);
-}
-
-// * -----------------------------------------------------------------------------
-// * Bloco de funções auxiliares.
-// * -----------------------------------------------------------------------------
-
-/*
- * Function: selection_sort
- * -----------------------------------------------------------------------------
- *   Função auxiliar que implementa do método de ordenação selecion sort.
- *
- *   array: vetor que será ordenado.
- *   n: tamanho do vetor.
- */
-void selection_sort(struct nodo* array, int n) {
-    int i, j;
-    int min;
-    struct nodo temp;
-    
-    for(i = 0; i < n - 1; i++) {
-        min=i;
-        for(j = i + 1; j < n; j++) {
-            if(array[j].valor < array[min].valor) {
-                min = j;
-            }
+        
+        total += informacoes_execucao[i].valor_encontrado;
+        total_execucao += informacoes_execucao[i].tempo;
+        
+        if(melhor_valor >= informacoes_execucao[i].valor_encontrado) {
+            melhor_valor = informacoes_execucao[i].valor_encontrado;
+            tempo_melhor = informacoes_execucao[i].tempo;
+            melhor_execucao = i;
         }
         
-        temp = array[i];
-        array[i] = array[min];
-        array[min] = temp;
+        if(informacoes_execucao[i].valor_encontrado >= pior_valor) {
+            pior_valor = informacoes_execucao[i].valor_encontrado;
+            tempo_pior = informacoes_execucao[i].tempo;
+        }
+        
+        if(opcoes.alvo > 0) {
+            printf("%s;%d;%lld;%.2f\n", arquivo, i, informacoes_execucao[i].valor_encontrado, informacoes_execucao[i].tempo);
+        }
     }
-}
-
-/*
- * Function: copiar_solucao
- * -----------------------------------------------------------------------------
- *   Função auxiliar que copia uma soluçao de origem para uma solução de destino.
- *   Os ponteiros precisam ter sido alocados previamente.
- *
- *   n: tamanho da solução.
- *   origem: solução de origem.
- *   destino: tamanho dos vetores.
- */
-void copiar_solucao(int n, int* origem, int* destino) {
-    int i;
     
-    for(i = 0; i < n + 1; i++) {
-        destino[i] = origem[i];
+    if(arquivo_gravacao && !gravar_solucao_arquivo(arquivo_gravacao, p.tamanho, informacoes_execucao[melhor_execucao].solucao)) {
+        printf("Não foi possível gravar a solução em %s\n", arquivo_gravacao);
     }
-}
-
-/*
- * Function: inicializar_solucao
- * -----------------------------------------------------------------------------
- *   Função auxiliar que inicializa um ponteiro com uma nova solução.
- *
- *   n: tamanho da solução.
- *   solucao_base: solução que será baseada para a nova solução.
- *
- *   returns: um ponteiro alocado contendo uma soluçao base.
- */
-int* inicializar_solucao(int n, int* solucao_base) {
-    int* nova_solucao;
-    
-    nova_solucao = malloc((n + 1) * sizeof(int));
     
-    if(solucao_base) {
-        copiar_solucao(n, solucao_base, nova_solucao);
+    for(int i = 0; i < execucoes; i++) {
+        free(informacoes_execucao[i].solucao);
     }
     
-    return nova_solucao;
+    printf("%s;%lld;%.2f;%lld;%.2f;%.2f;%.2f\n", arquivo, melhor_valor, tempo_melhor, pior_valor, tempo_pior, (double)(total / execucoes), (double)(total_execucao / execucoes));
     
-}
-
-/*
- * Function: rnd
- * -----------------------------------------------------------------------------
- *   Gera um número aleatório entre 2 inteiros.
- *
- *   min: limite inferior.
- *   max: limite superior.
- *
- *   returns um número aleatório.
- */
-int rnd(int min, int max) {
-    min = ceil(min);
-    max = floor(max);
-    
-    return floor(rand() % (max + 1 - min)) + min;
-}
-
-/*
- * Function: ler_arquivo
- * -----------------------------------------------------------------------------
- *   Lê um arquivo com o formato definido e mapeia a matriz de adjacência para
- *   memória.
- *
- *   p: estrutura de dados representando o problema.
- *   arquivo: caminho físico para o arquivo que será lido.
- */
-void ler_arquivo(struct problema* p, char arquivo[2000]) {
-    FILE* fp;
-    int t;
-    
-    fp = fopen(arquivo, "r");
-    fscanf(fp, "%d %d\n\n", &p->tamanho, &t);
-    
-    //alocando espaço para a matriz de adjacencia
-    p->elementos = malloc(p->tamanho * p->tamanho * sizeof(int));
-    
-    
-    //pulando as linhas de 1s
-    for(int i = 0; i < p->tamanho; i++) {
-        fscanf(fp, "%d ", &t);
-    }
-    
-    //percorrendo os elementos da matriz de ajdacencia que estao no arquivo
-    for(int i = 0; i < p->tamanho; i++) {
-        p->elementos[i] = malloc(p->tamanho * sizeof(int));
-        
-        for(int j = 0; j < p->tamanho; j++) {
-            p->elementos[i][j] = 0;
-            fscanf(fp, "%d ", &p->elementos[i][j]);
-        }
-    }
-}
-
-/*
- * Function: imprimir_solucao
- * -----------------------------------------------------------------------------
- *   Função auxiliar que imprime uma solução na tela.
- *
- *   n: tamanho da solução.
- *   origem: solução que será impressa na tela.
- */
-void imprimir_solucao(int n, int* solucao) {
-    int i;
+    liberar_problema(&p);
+    free(informacoes_execucao);
+    free(opcoes.solucao_inicial);
+    free(opcoes.posicoes_afetadas);
+    free(ordem);
     
-    for(i = 0; i <= n; i++) {
-        printf("%d ", solucao[i]);
-    }
-    printf("\n");
-}
-
-/*
- * Function: linha
- * -----------------------------------------------------------------------------
- *   Função auxiliar que imprime uma linha na tela.
- */
-void linha() {
-    int i;
-    printf("\n");
-    for(i = 0; i < 80; i++) printf("_");
-    printf("\n");
+    return 0;
 }
-
@@ -0,0 +1,222 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "interno.h"
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções de alocação das tabelas grandes em páginas grandes.
+// *
+// * Cada bloco é precedido por um cabeçalho de MEMORIA_CABECALHO bytes com a
+// * região alocada e o modo de páginas obtido, de forma que liberar_memoria
+// * e modo_memoria recebam apenas o endereço. Blocos alocados pelo malloc
+// * são marcados com tamanho 0.
+// * -----------------------------------------------------------------------------
+
+struct cabecalho_memoria {
+    void* base;
+    size_t tamanho;
+    int modo;
+};
+
+/*
+ * Function: alocar_memoria
+ * -----------------------------------------------------------------------------
+ *   Aloca um bloco zerado de memória para uma tabela grande (matriz de
+ *   distâncias, matriz compacta, listas de vizinhos, cache de distâncias). Os
+ *   acessos aleatórios dessas tabelas durante a busca esgotam a TLB com
+ *   páginas de 4 KB em instâncias grandes.
+ *
+ *   Blocos menores que MEMORIA_MINIMO_MAPEAMENTO não ocupam sequer uma
+ *   página grande e são alocados pelo malloc. Com paginas_grandes, os
+ *   demais tentam, nesta ordem:
+ *
+ *   1) páginas grandes explícitas de 2 MB (mmap com MAP_HUGETLB), que exigem
+ *   páginas reservadas pelo sistema (vm.nr_hugepages);
+ *   2) páginas grandes transparentes, com o bloco alinhado a 2 MB e
+ *   madvise(MADV_HUGEPAGE);
+ *   3) páginas normais.
+ *
+ *   Sem paginas_grandes o bloco é marcado com MADV_NOHUGEPAGE, garantindo
+ *   páginas normais mesmo quando o sistema as promove automaticamente.
+ *
+ *   tamanho: tamanho do bloco em bytes.
+ *   paginas_grandes: TRUE para tentar utilizar páginas grandes (ver
+ *   opcoes.paginas_grandes e problema.paginas_grandes).
+ *
+ *   returns: o endereço do bloco ou NULL caso não haja memória.
+ */
+void* alocar_memoria(size_t tamanho, int paginas_grandes) {
+    struct cabecalho_memoria* c;
+    size_t total = tamanho + MEMORIA_CABECALHO;
+    size_t arredondado = (total + PAGINA_GRANDE - 1) / PAGINA_GRANDE * PAGINA_GRANDE;
+    void* bloco = MAP_FAILED;
+    char* base;
+    size_t mapeado = arredondado;
+    int modo = MEMORIA_PAGINAS_NORMAIS;
+    
+    if(tamanho < MEMORIA_MINIMO_MAPEAMENTO) {
+        //o cabeçalho alinhado à linha de cache preserva o alinhamento do bloco
+        if(posix_memalign(&bloco, MEMORIA_CABECALHO, total) != 0) {
+            return NULL;
+        }
+        
+        memset(bloco, 0, total);
+        
+        c = bloco;
+        c->base = bloco;
+        c->tamanho = 0;
+        c->modo = MEMORIA_PAGINAS_NORMAIS;
+        
+        return (char*) bloco + MEMORIA_CABECALHO;
+    }
+    
+#ifdef MAP_HUGETLB
+    if(paginas_grandes) {
+        bloco = mmap(NULL, arredondado, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        modo = MEMORIA_PAGINAS_GRANDES;
+    }
+#endif
+    
+    base = bloco;
+    
+    if(bloco == MAP_FAILED) {
+        //o mmap devolve blocos alinhados a 4 KB; as páginas grandes
+        //transparentes cobrem apenas os trechos alinhados a 2 MB
+        mapeado = arredondado + PAGINA_GRANDE;
+        base = mmap(NULL, mapeado, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        modo = MEMORIA_PAGINAS_NORMAIS;
+        
+        if(base == MAP_FAILED) {
+            return NULL;
+        }
+        
+        bloco = base + (PAGINA_GRANDE - (size_t) base % PAGINA_GRANDE) % PAGINA_GRANDE;
+    
+#if defined(MADV_HUGEPAGE) && defined(MADV_NOHUGEPAGE)
+        if(paginas_grandes) {
+            if(madvise(bloco, arredondado, MADV_HUGEPAGE) == 0) {
+                modo = MEMORIA_PAGINAS_TRANSPARENTES;
+            }
+        } else {
+            madvise(bloco, arredondado, MADV_NOHUGEPAGE);
+        }
+#endif
+    }
+    
+    c = bloco;
+    c->base = base;
+    c->tamanho = mapeado;
+    c->modo = modo;
+    
+    return (char*) bloco + MEMORIA_CABECALHO;
+}
+
+/*
+ * Function: modo_memoria
+ * -----------------------------------------------------------------------------
+ *   Retorna o modo de páginas de um bloco alocado por alocar_memoria.
+ *
+ *   endereco: endereço do bloco.
+ *
+ *   returns: MEMORIA_PAGINAS_GRANDES, MEMORIA_PAGINAS_TRANSPARENTES ou
+ *   MEMORIA_PAGINAS_NORMAIS.
+ */
+int modo_memoria(void* endereco) {
+    struct cabecalho_memoria* c = (struct cabecalho_memoria*) ((char*) endereco - MEMORIA_CABECALHO);
+    
+    return c->modo;
+}
+
+/*
+ * Function: descrever_modo_memoria
+ * -----------------------------------------------------------------------------
+ *   Retorna a descrição de um modo de páginas.
+ *
+ *   modo: modo de páginas (MEMORIA_*).
+ *
+ *   returns: a descrição do modo.
+ */
+const char* descrever_modo_memoria(int modo) {
+    switch (modo) {
+        case MEMORIA_PAGINAS_GRANDES:
+            return "páginas grandes de 2 MB (MAP_HUGETLB)";
+        case MEMORIA_PAGINAS_TRANSPARENTES:
+            return "páginas grandes transparentes (MADV_HUGEPAGE)";
+        default:
+            return "páginas normais";
+    }
+}
+
+/*
+ * Function: liberar_memoria
+ * -----------------------------------------------------------------------------
+ *   Libera um bloco alocado por alocar_memoria.
+ *
+ *   endereco: endereço do bloco (NULL é ignorado).
+ */
+void liberar_memoria(void* endereco) {
+    struct cabecalho_memoria* c;
+    
+    if(!endereco) {
+        return;
+    }
+    
+    c = (struct cabecalho_memoria*) ((char*) endereco - MEMORIA_CABECALHO);
+    
+    if(c->tamanho == 0) {
+        free(c->base);
+    } else {
+        munmap(c->base, c->tamanho);
+    }
+}
+
+/*
+ * Function: comparar_memoria
+ * -----------------------------------------------------------------------------
+ *   Compara o tempo do cálculo de custo genérico (acessos aleatórios à matriz
+ *   de adjacência) com a matriz em páginas normais e em páginas grandes,
+ *   imprimindo uma linha por modo no formato:
+ *   <MODO>;<NS_POR_AVALIACAO>;<GANHO_SOBRE_PAGINAS_NORMAIS>
+ *
+ *   p: estrutura de dados representando o problema.
+ *   avaliacoes: quantidade aproximada de avaliações por modo.
+ */
+void comparar_memoria(struct problema* p, int avaliacoes) {
+    struct problema tmp = *p;
+    int quantidade = 64;
+    int repeticoes = avaliacoes / quantidade > 0 ? avaliacoes / quantidade : 1;
+    int* solucoes;
+    int* matrizes[2];
+    long long somas[2];
+    double tempos[2];
+    
+    if(!p->elementos) {
+        printf("A comparação exige a matriz de adjacência em memória.\n");
+        return;
+    }
+    
+    solucoes = gerar_solucoes_teste(p, quantidade);
+    tmp.kernel = NULL;
+    tmp.elementos = malloc(p->tamanho * sizeof(int*));
+    
+    for(int m = 0; m < 2; m++) {
+        matrizes[m] = alocar_memoria((size_t) p->tamanho * p->tamanho * sizeof(int), m == 1);
+        
+        for(int i = 0; i < p->tamanho; i++) {
+            tmp.elementos[i] = matrizes[m] + (size_t) i * p->tamanho;
+            memcpy(tmp.elementos[i], p->elementos[i], p->tamanho * sizeof(int));
+        }
+        
+        tempos[m] = medir_custo(&tmp, solucoes, quantidade, repeticoes, &somas[m]);
+    }
+    
+    printf("%s;%.2f;1.00\n", descrever_modo_memoria(modo_memoria(matrizes[0])), tempos[0]);
+    printf("%s;%.2f;%.2f%s\n", descrever_modo_memoria(modo_memoria(matrizes[1])), tempos[1], tempos[1] > 0 ? tempos[0] / tempos[1] : 0, somas[0] == somas[1] ? "" : ";DIVERGENTE");
+    
+    liberar_memoria(matrizes[0]);
+    liberar_memoria(matrizes[1]);
+    free(tmp.elementos);
+    free(solucoes);
+}
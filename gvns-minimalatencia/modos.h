@@ -0,0 +1,251 @@
+#ifndef modos_h
+#define modos_h
+
+#include <sys/types.h>
+
+#include "interno.h"
+
+// * -----------------------------------------------------------------------------
+// * Tempo máximo padrão (em segundos) de cada execução do experimento
+// * time-to-target.
+// * -----------------------------------------------------------------------------
+#define TTT_TEMPO_MAXIMO_PADRAO 3600
+
+// * -----------------------------------------------------------------------------
+// * Ajuste de parâmetros por corrida: quantidade de rodadas antes da primeira
+// * eliminação e quantidade de erros padrão que a diferença média em relação
+// * à melhor configuração deve superar para que uma configuração seja
+// * eliminada.
+// * -----------------------------------------------------------------------------
+#define AJUSTE_RODADAS_MINIMAS 3
+#define AJUSTE_LIMIAR_ELIMINACAO 2.0
+
+// * -----------------------------------------------------------------------------
+// * Modo serviço: quantidade padrão de instâncias mantidas em cache e limites
+// * das requisições. Vizinhanças além de VIZINHANCA_RUINA + 1 apenas repetem o
+// * abalo que não altera a solução.
+// * -----------------------------------------------------------------------------
+#define SERVICO_CAPACIDADE_CACHE_PADRAO 8
+#define SERVICO_MAXIMO_EXECUCOES 1000
+#define SERVICO_MAXIMO_VIZINHANCAS (VIZINHANCA_RUINA + 1)
+
+// * -----------------------------------------------------------------------------
+// * Modo distribuído: tamanho da mensagem de identificação do trabalhador (ver
+// * descrever_configuracao) e intervalo, em milissegundos, da verificação dos
+// * trabalhadores locais encerrados.
+// * -----------------------------------------------------------------------------
+#define DISTRIBUIDO_CONFIGURACAO 256
+#define DISTRIBUIDO_INTERVALO_VERIFICACAO 200
+
+// * -----------------------------------------------------------------------------
+// * Experimento time-to-target: resultado de cada execução e estado
+// * compartilhado entre as threads que realizam as execuções.
+// * -----------------------------------------------------------------------------
+struct resultado_ttt {
+    int execucao;
+    long long valor;
+    double tempo;
+    int alcancado;
+};
+
+struct experimento_ttt {
+    struct problema* problema;
+    struct opcoes* opcoes;
+    int execucoes;
+    int proxima;
+    struct resultado_ttt* resultados;
+    pthread_mutex_t mutex;
+};
+
+// * -----------------------------------------------------------------------------
+// * Ajuste de parâmetros: configurações avaliadas, tarefas de uma rodada e
+// * estado do ajuste. Os custos e tempos de todas as execuções são guardados
+// * para as comparações pareadas da corrida.
+// * -----------------------------------------------------------------------------
+struct configuracao_ajuste {
+    int iteracoes;
+    int vizinhancas;
+    int construcao_aleatoria;
+    int ativa;
+    double desvio;
+    double tempo;
+};
+
+struct tarefa_ajuste {
+    int configuracao;
+    int instancia;
+};
+
+struct ajuste {
+    char** arquivos;
+    struct problema* instancias;
+    int quantidade_instancias;
+    struct configuracao_ajuste* configuracoes;
+    int quantidade_configuracoes;
+    struct opcoes opcoes;
+    int execucoes;
+    int threads;
+    int corrida;
+    long long* custos;
+    double* tempos;
+    struct tarefa_ajuste* tarefas;
+    int quantidade_tarefas;
+    int proxima;
+    int rodada;
+    pthread_mutex_t mutex;
+};
+
+// * -----------------------------------------------------------------------------
+// * Modo distribuído: conexão com buffer de leitura de linhas, estado do
+// * coordenador e estado de cada processo trabalhador.
+// * -----------------------------------------------------------------------------
+struct conexao {
+    int fd;
+    char* buffer;
+    size_t tamanho;
+    size_t capacidade;
+    int execucao;
+    int identificada;
+};
+
+struct coordenador {
+    int tamanho;
+    int execucoes;
+    int compartilhar;
+    int proxima;
+    int concluidas;
+    int* pendentes;
+    int quantidade_pendentes;
+    struct conexao* conexoes;
+    int quantidade_conexoes;
+    int capacidade_conexoes;
+    struct informacao_execucao* informacoes;
+    long long custo_melhor;
+    int* melhor;
+    int* solucao_tmp;
+    char configuracao[DISTRIBUIDO_CONFIGURACAO];
+};
+
+struct trabalhador {
+    struct conexao conexao;
+    int tamanho;
+    int recebida;
+    long long custo_recebido;
+    int* solucao_recebida;
+};
+
+// * -----------------------------------------------------------------------------
+// * Modo serviço: instâncias mantidas em cache (com a contagem das requisições
+// * que as utilizam), clientes conectados, requisições em andamento e tarefas
+// * (uma por execução) da fila compartilhada pelas threads do serviço.
+// * -----------------------------------------------------------------------------
+struct instancia_servico {
+    char* chave;
+    struct problema problema;
+    int referencias;
+    unsigned long ultimo_uso;
+};
+
+struct servico;
+
+struct cliente_servico {
+    struct servico* servico;
+    struct conexao conexao;
+    int saida;
+    int referencias;
+    int encerrado;
+    pthread_mutex_t mutex;
+};
+
+struct requisicao_servico {
+    char* id;
+    struct cliente_servico* cliente;
+    struct instancia_servico* instancia;
+    struct opcoes opcoes;
+    unsigned long long semente;
+    int execucoes;
+    int pendentes;
+    int incumbentes;
+    int reaproveitada;
+    long long melhor;
+    double inicio;
+    pthread_mutex_t mutex;
+};
+
+struct tarefa_servico {
+    struct requisicao_servico* requisicao;
+    int execucao;
+    struct tarefa_servico* proxima;
+};
+
+struct servico {
+    struct instancia_servico** instancias;
+    int quantidade_instancias;
+    int capacidade_cache;
+    int paginas_grandes;
+    unsigned long relogio;
+    pthread_mutex_t mutex_cache;
+    struct tarefa_servico* primeira;
+    struct tarefa_servico* ultima;
+    int requisicoes;
+    int encerrar;
+    pthread_mutex_t mutex;
+    pthread_cond_t tarefas;
+    pthread_cond_t ociosidade;
+};
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções do experimento time-to-target (TTT).
+// * -----------------------------------------------------------------------------
+struct resultado_ttt* executar_ttt(struct problema*, struct opcoes*, int, int);
+void* executar_execucoes_ttt(void*);
+void imprimir_ttt(char*, struct resultado_ttt*, int);
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções do ajuste de parâmetros.
+// * -----------------------------------------------------------------------------
+struct ajuste* criar_ajuste(char*, int, int, int);
+void definir_grade_ajuste(struct ajuste*, int*, int, int*, int, int*, int);
+void executar_ajuste(struct ajuste*);
+void executar_rodada_ajuste(struct ajuste*, int*, int, int);
+void* executar_tarefas_ajuste(void*);
+int avaliar_configuracoes(struct ajuste*, int*, int, int);
+void eliminar_configuracoes(struct ajuste*, int*, int, int);
+long long menor_custo_ajuste(struct ajuste*, int, int);
+size_t indice_ajuste(struct ajuste*, int, int, int);
+int ler_valores(char*, int**);
+void liberar_ajuste(struct ajuste*);
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções do modo distribuído (coordenador e trabalhadores).
+// * -----------------------------------------------------------------------------
+int conectar_socket(char*, int);
+void iniciar_conexao(struct conexao*, int);
+void encerrar_conexao(struct conexao*);
+int receber_linha(struct conexao*, int, char**);
+int enviar_mensagem(int, char*, int, int*);
+int ler_solucao_mensagem(char*, int, int*);
+void descrever_configuracao(struct problema*, struct opcoes*, char*);
+int aguardar_trabalhadores(pid_t*, int);
+void atribuir_execucao(struct coordenador*, struct conexao*);
+void tratar_mensagem_coordenador(struct coordenador*, struct conexao*, char*);
+int executar_coordenador(struct problema*, struct opcoes*, char*, int, int, int, struct informacao_execucao*);
+void enviar_incumbente(long long, int*, int, void*);
+int receber_incumbente(int*, long long*, void*);
+int executar_trabalhador(struct problema*, struct opcoes*, char*);
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções do modo serviço.
+// * -----------------------------------------------------------------------------
+int executar_servico(char*, int, int, int);
+void* atender_cliente(void*);
+void tratar_requisicao(struct servico*, struct cliente_servico*, char*);
+struct instancia_servico* obter_instancia(struct servico*, char*, int, int*, int*, int*);
+void liberar_instancia(struct servico*, struct instancia_servico*);
+void* executar_tarefas_servico(void*);
+void executar_tarefa_servico(struct tarefa_servico*);
+void notificar_incumbente(long long, int*, int, void*);
+int responder_cliente(struct cliente_servico*, char*);
+void liberar_cliente(struct cliente_servico*);
+
+#endif /* modos_h */
@@ -0,0 +1,473 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "interno.h"
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções do perfil de desempenho por fase da busca.
+// *
+// * Os contadores de desempenho do processador (ciclos, instruções, falhas de
+// * cache, de previsão de desvios e de TLB) e os contadores de software do
+// * sistema (tempo de CPU e faltas de página) são abertos com perf_event_open
+// * como um único grupo, lido de uma só vez a cada troca de fase. A busca
+// * entra e sai das fases pelas macros PERFIL_ENTRAR e PERFIL_SAIR; a
+// * diferença entre duas leituras é atribuída à fase do topo da pilha, de
+// * forma que fases aninhadas (o VND das construções de elite, por exemplo)
+// * não sejam contadas duas vezes. O tempo fora de qualquer fase (controle do
+// * GVNS, cópias e aceitação das soluções) é atribuído à fase "demais".
+// *
+// * Os contadores que não puderem ser abertos (processador virtualizado sem
+// * contadores, perf_event_paranoid restritivo ou sistema diferente do Linux)
+// * ficam vazios no relatório, que mantém a quantidade de chamadas e o tempo
+// * de cada fase. Apenas a thread das execuções é medida: das construções
+// * distribuídas entre threads (--threads-construcao) contam o tempo e o
+// * trabalho da própria thread. Cada leitura custa uma chamada de sistema, de
+// * forma que as fases curtas das instâncias pequenas ficam mais lentas com o
+// * perfil.
+// * -----------------------------------------------------------------------------
+
+static const char* nomes_fases[] = {"construcao", "abalo", "path_relinking", "varredura_unificada", "swap", "2opt", "insercao", "oropt2", "oropt3", "demais"};
+static const char* nomes_contadores[] = {"ciclos", "instrucoes", "falhas_cache", "falhas_desvio", "falhas_tlb", "tempo_cpu", "faltas_pagina"};
+
+#ifdef __linux__
+static const unsigned int tipos_contadores[] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_SOFTWARE, PERF_TYPE_SOFTWARE};
+static const unsigned long long configuracoes_contadores[] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES,
+    PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+    PERF_COUNT_SW_TASK_CLOCK,
+    PERF_COUNT_SW_PAGE_FAULTS
+};
+
+/*
+ * Function: abrir_contador
+ * -----------------------------------------------------------------------------
+ *   Abre um contador da thread atual, apenas em modo usuário.
+ *
+ *   contador: índice do contador (ver nomes_contadores).
+ *   lider: descritor do líder do grupo (-1 para abrir o líder).
+ *
+ *   returns: o descritor do contador ou -1 (errno indica a falha).
+ */
+static int abrir_contador(int contador, int lider) {
+    struct perf_event_attr atributos;
+    
+    memset(&atributos, 0, sizeof(atributos));
+    atributos.size = sizeof(atributos);
+    atributos.type = tipos_contadores[contador];
+    atributos.config = configuracoes_contadores[contador];
+    atributos.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    atributos.exclude_kernel = 1;
+    atributos.exclude_hv = 1;
+    
+    return (int) syscall(SYS_perf_event_open, &atributos, 0, -1, lider, 0);
+}
+#endif
+
+/*
+ * Function: ler_contadores
+ * -----------------------------------------------------------------------------
+ *   Lê os valores acumulados dos contadores abertos. Quando o grupo divide
+ *   os contadores do processador com outros grupos (multiplexação), os
+ *   valores são estimados pela fração do tempo em que o grupo foi contado.
+ *
+ *   perfil: perfil em andamento.
+ *   valores: recebe o valor de cada contador (0 para os indisponíveis).
+ */
+static void ler_contadores(struct perfil* perfil, long long* valores) {
+    unsigned long long buffer[3 + QUANTIDADE_CONTADORES_PERFIL];
+    double escala = 1;
+    
+    memset(valores, 0, QUANTIDADE_CONTADORES_PERFIL * sizeof(long long));
+    
+    if(perfil->lider < 0 || read(perfil->lider, buffer, sizeof(buffer)) < (ssize_t) (3 * sizeof(unsigned long long))) {
+        return;
+    }
+    
+    //buffer: quantidade, tempo habilitado, tempo contado e os valores em ordem de abertura
+    if(buffer[2] > 0 && buffer[2] < buffer[1]) {
+        escala = (double) buffer[1] / buffer[2];
+    }
+    
+    for(int c = 0; c < QUANTIDADE_CONTADORES_PERFIL; c++) {
+        if(perfil->posicoes[c] >= 0 && (unsigned long long) perfil->posicoes[c] < buffer[0]) {
+            valores[c] = (long long) (buffer[3 + perfil->posicoes[c]] * escala);
+        }
+    }
+}
+
+/*
+ * Function: contabilizar_perfil
+ * -----------------------------------------------------------------------------
+ *   Atribui à fase do topo da pilha os contadores e o tempo decorridos desde
+ *   a leitura anterior.
+ *
+ *   perfil: perfil em andamento.
+ */
+static void contabilizar_perfil(struct perfil* perfil) {
+    struct medicao_perfil* m = &perfil->atual[perfil->pilha[perfil->profundidade - 1]];
+    long long valores[QUANTIDADE_CONTADORES_PERFIL];
+    double agora;
+    
+    ler_contadores(perfil, valores);
+    agora = relogio();
+    
+    for(int c = 0; c < QUANTIDADE_CONTADORES_PERFIL; c++) {
+        //a estimativa da multiplexação pode recuar levemente entre leituras
+        if(valores[c] > perfil->leitura[c]) {
+            m->contadores[c] += valores[c] - perfil->leitura[c];
+        }
+        
+        perfil->leitura[c] = valores[c];
+    }
+    
+    m->tempo += agora - perfil->instante;
+    perfil->instante = agora;
+}
+
+/*
+ * Function: criar_perfil
+ * -----------------------------------------------------------------------------
+ *   Cria o perfil de desempenho e abre os contadores da thread atual, que
+ *   deve ser a thread que realiza as execuções. Os contadores que não
+ *   puderem ser abertos ficam indisponíveis; o perfil é criado mesmo sem
+ *   nenhum contador.
+ *
+ *   returns: o perfil alocado.
+ */
+struct perfil* criar_perfil(void) {
+    struct perfil* perfil = calloc(1, sizeof(struct perfil));
+    int posicao = 0;
+    
+    perfil->lider = -1;
+    perfil->erro = 0;
+    
+    for(int c = 0; c < QUANTIDADE_CONTADORES_PERFIL; c++) {
+        perfil->descritores[c] = -1;
+        perfil->posicoes[c] = -1;
+    
+#ifdef __linux__
+        perfil->descritores[c] = abrir_contador(c, perfil->lider);
+        
+        if(perfil->descritores[c] < 0) {
+            if(!perfil->erro) {
+                perfil->erro = errno;
+            }
+            
+            continue;
+        }
+        
+        if(perfil->lider < 0) {
+            perfil->lider = perfil->descritores[c];
+        }
+        
+        perfil->posicoes[c] = posicao++;
+#else
+        perfil->erro = ENOSYS;
+#endif
+    }
+    
+    perfil->abertos = posicao;
+    
+    return perfil;
+}
+
+/*
+ * Function: contador_disponivel
+ * -----------------------------------------------------------------------------
+ *   Verifica se um contador do perfil foi aberto.
+ *
+ *   perfil: perfil de desempenho.
+ *   contador: índice do contador (ver nomes_contadores).
+ *
+ *   returns: TRUE caso o contador esteja disponível.
+ */
+int contador_disponivel(struct perfil* perfil, int contador) {
+    return perfil->posicoes[contador] >= 0;
+}
+
+/*
+ * Function: descrever_perfil
+ * -----------------------------------------------------------------------------
+ *   Exibe, na saída de erros, os contadores indisponíveis e o motivo da
+ *   primeira falha. Não exibe nada quando todos os contadores foram abertos.
+ *
+ *   perfil: perfil de desempenho.
+ */
+void descrever_perfil(struct perfil* perfil) {
+    if(perfil->abertos == QUANTIDADE_CONTADORES_PERFIL) {
+        return;
+    }
+    
+    fprintf(stderr, "Contadores de desempenho indisponíveis (%s):", perfil->erro ? strerror(perfil->erro) : "desconhecido");
+    
+    for(int c = 0; c < QUANTIDADE_CONTADORES_PERFIL; c++) {
+        if(!contador_disponivel(perfil, c)) {
+            fprintf(stderr, " %s", nomes_contadores[c]);
+        }
+    }
+    
+    fprintf(stderr, ". O perfil mantém os demais valores.\n");
+}
+
+/*
+ * Function: iniciar_execucao_perfil
+ * -----------------------------------------------------------------------------
+ *   Inicia a medição de uma execução, a partir da fase "demais".
+ *
+ *   perfil: perfil de desempenho.
+ */
+void iniciar_execucao_perfil(struct perfil* perfil) {
+    memset(perfil->atual, 0, sizeof(perfil->atual));
+    
+    perfil->pilha[0] = PERFIL_DEMAIS;
+    perfil->profundidade = 1;
+    perfil->excedentes = 0;
+    perfil->atual[PERFIL_DEMAIS].chamadas = 1;
+    
+    ler_contadores(perfil, perfil->leitura);
+    perfil->instante = relogio();
+}
+
+/*
+ * Function: entrar_fase_perfil
+ * -----------------------------------------------------------------------------
+ *   Encerra a medição da fase atual e inicia a medição da fase informada.
+ *   Utilizada pela macro PERFIL_ENTRAR.
+ *
+ *   perfil: perfil de desempenho.
+ *   fase: fase iniciada (PERFIL_*).
+ */
+void entrar_fase_perfil(struct perfil* perfil, int fase) {
+    if(perfil->profundidade < 1) {
+        return;
+    }
+    
+    //fases mais profundas que a pilha continuam atribuídas à fase do topo
+    if(perfil->profundidade == PROFUNDIDADE_MAXIMA_PERFIL) {
+        perfil->excedentes++;
+        return;
+    }
+    
+    //as vizinhanças sem movimento (além de QUANTIDADE_VIZINHANCAS_VND) ficam em "demais"
+    if(fase < 0 || fase >= QUANTIDADE_FASES_PERFIL) {
+        fase = PERFIL_DEMAIS;
+    }
+    
+    contabilizar_perfil(perfil);
+    
+    perfil->pilha[perfil->profundidade++] = fase;
+    perfil->atual[fase].chamadas++;
+}
+
+/*
+ * Function: sair_fase_perfil
+ * -----------------------------------------------------------------------------
+ *   Encerra a medição da fase atual e retoma a medição da fase anterior.
+ *   Utilizada pela macro PERFIL_SAIR.
+ *
+ *   perfil: perfil de desempenho.
+ */
+void sair_fase_perfil(struct perfil* perfil) {
+    if(perfil->excedentes > 0) {
+        perfil->excedentes--;
+        return;
+    }
+    
+    if(perfil->profundidade < 2) {
+        return;
+    }
+    
+    contabilizar_perfil(perfil);
+    perfil->profundidade--;
+}
+
+/*
+ * Function: concluir_execucao_perfil
+ * -----------------------------------------------------------------------------
+ *   Encerra a medição de uma execução, guardando as suas medições e
+ *   acumulando-as no total.
+ *
+ *   perfil: perfil de desempenho.
+ *   execucao: índice da execução.
+ */
+void concluir_execucao_perfil(struct perfil* perfil, int execucao) {
+    if(perfil->profundidade < 1) {
+        return;
+    }
+    
+    contabilizar_perfil(perfil);
+    perfil->profundidade = 0;
+    
+    if(perfil->quantidade == perfil->capacidade) {
+        perfil->capacidade = perfil->capacidade ? 2 * perfil->capacidade : 16;
+        perfil->execucoes = realloc(perfil->execucoes, (size_t) perfil->capacidade * QUANTIDADE_FASES_PERFIL * sizeof(struct medicao_perfil));
+        perfil->indices = realloc(perfil->indices, perfil->capacidade * sizeof(int));
+    }
+    
+    memcpy(&perfil->execucoes[(size_t) perfil->quantidade * QUANTIDADE_FASES_PERFIL], perfil->atual, sizeof(perfil->atual));
+    perfil->indices[perfil->quantidade] = execucao;
+    perfil->quantidade++;
+    
+    for(int f = 0; f < QUANTIDADE_FASES_PERFIL; f++) {
+        perfil->total[f].chamadas += perfil->atual[f].chamadas;
+        perfil->total[f].tempo += perfil->atual[f].tempo;
+        
+        for(int c = 0; c < QUANTIDADE_CONTADORES_PERFIL; c++) {
+            perfil->total[f].contadores[c] += perfil->atual[f].contadores[c];
+        }
+    }
+}
+
+/*
+ * Function: gravar_medicoes_perfil
+ * -----------------------------------------------------------------------------
+ *   Grava uma linha por fase medida de uma execução (ou do total).
+ *
+ *   arquivo: arquivo aberto para escrita.
+ *   perfil: perfil de desempenho.
+ *   execucao: identificação da execução na primeira coluna.
+ *   medicoes: medições das QUANTIDADE_FASES_PERFIL fases.
+ */
+static void gravar_medicoes_perfil(FILE* arquivo, struct perfil* perfil, const char* execucao, struct medicao_perfil* medicoes) {
+    struct medicao_perfil* m;
+    
+    for(int f = 0; f < QUANTIDADE_FASES_PERFIL; f++) {
+        m = &medicoes[f];
+        
+        if(!m->chamadas) {
+            continue;
+        }
+        
+        fprintf(arquivo, "%s;%s;%lld;%.6f", execucao, nomes_fases[f], m->chamadas, m->tempo);
+        
+        for(int c = 0; c < QUANTIDADE_CONTADORES_PERFIL; c++) {
+            if(contador_disponivel(perfil, c)) {
+                fprintf(arquivo, ";%lld", m->contadores[c]);
+            } else {
+                fprintf(arquivo, ";");
+            }
+            
+            //instruções por ciclo após as instruções
+            if(c == 1) {
+                if(contador_disponivel(perfil, 0) && contador_disponivel(perfil, 1) && m->contadores[0] > 0) {
+                    fprintf(arquivo, ";%.3f", (double) m->contadores[1] / m->contadores[0]);
+                } else {
+                    fprintf(arquivo, ";");
+                }
+            }
+        }
+        
+        fprintf(arquivo, "\n");
+    }
+}
+
+/*
+ * Function: gravar_perfil
+ * -----------------------------------------------------------------------------
+ *   Grava o relatório do perfil em CSV, com as linhas de cada execução
+ *   seguidas das linhas do total de todas as execuções (execucao = total):
+ *
+ *   execucao;fase;chamadas;tempo;ciclos;instrucoes;ipc;falhas_cache;
+ *   falhas_desvio;falhas_tlb;tempo_cpu;faltas_pagina
+ *
+ *   O tempo é dado em segundos e o tempo de CPU em nanossegundos; os
+ *   contadores indisponíveis ficam vazios.
+ *
+ *   perfil: perfil de desempenho.
+ *   caminho: arquivo gravado.
+ *
+ *   returns: TRUE caso o arquivo tenha sido gravado.
+ */
+int gravar_perfil(struct perfil* perfil, char* caminho) {
+    FILE* arquivo = fopen(caminho, "w");
+    char execucao[32];
+    
+    if(!arquivo) {
+        return FALSE;
+    }
+    
+    fprintf(arquivo, "execucao;fase;chamadas;tempo;ciclos;instrucoes;ipc;falhas_cache;falhas_desvio;falhas_tlb;tempo_cpu;faltas_pagina\n");
+    
+    for(int e = 0; e < perfil->quantidade; e++) {
+        snprintf(execucao, sizeof(execucao), "%d", perfil->indices[e]);
+        gravar_medicoes_perfil(arquivo, perfil, execucao, &perfil->execucoes[(size_t) e * QUANTIDADE_FASES_PERFIL]);
+    }
+    
+    gravar_medicoes_perfil(arquivo, perfil, "total", perfil->total);
+    
+    return fclose(arquivo) == 0;
+}
+
+/*
+ * Function: exibir_perfil
+ * -----------------------------------------------------------------------------
+ *   Exibe, na saída de erros para não se misturar às linhas de resultado, o
+ *   total de cada fase de todas as execuções, com a participação de cada
+ *   fase no tempo total e as taxas por mil instruções quando os contadores
+ *   estão disponíveis. O relatório completo é gravado por gravar_perfil.
+ *
+ *   perfil: perfil de desempenho.
+ */
+void exibir_perfil(struct perfil* perfil) {
+    struct medicao_perfil* m;
+    double tempo = 0;
+    
+    for(int f = 0; f < QUANTIDADE_FASES_PERFIL; f++) {
+        tempo += perfil->total[f].tempo;
+    }
+    
+    fprintf(stderr, "Perfil por fase (%d execuções):\n", perfil->quantidade);
+    
+    for(int f = 0; f < QUANTIDADE_FASES_PERFIL; f++) {
+        m = &perfil->total[f];
+        
+        if(!m->chamadas) {
+            continue;
+        }
+        
+        fprintf(stderr, "%-20s %10lld chamadas %9.3fs (%5.1f%%)", nomes_fases[f], m->chamadas, m->tempo, tempo > 0 ? 100 * m->tempo / tempo : 0);
+        
+        if(contador_disponivel(perfil, 0) && contador_disponivel(perfil, 1) && m->contadores[0] > 0) {
+            fprintf(stderr, "  IPC %.2f", (double) m->contadores[1] / m->contadores[0]);
+        }
+        
+        //falhas por mil instruções
+        for(int c = 2; c <= 4 && contador_disponivel(perfil, 1) && m->contadores[1] > 0; c++) {
+            if(contador_disponivel(perfil, c)) {
+                fprintf(stderr, "  %s/ki %.2f", nomes_contadores[c], 1000.0 * m->contadores[c] / m->contadores[1]);
+            }
+        }
+        
+        fprintf(stderr, "\n");
+    }
+}
+
+/*
+ * Function: liberar_perfil
+ * -----------------------------------------------------------------------------
+ *   Fecha os contadores e libera o perfil.
+ *
+ *   perfil: perfil de desempenho.
+ */
+void liberar_perfil(struct perfil* perfil) {
+    for(int c = 0; c < QUANTIDADE_CONTADORES_PERFIL; c++) {
+        if(perfil->descritores[c] >= 0) {
+            close(perfil->descritores[c]);
+        }
+    }
+    
+    free(perfil->execucoes);
+    free(perfil->indices);
+    free(perfil);
+}
@@ -0,0 +1,502 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <ctype.h>
+#include <limits.h>
+
+#include "interno.h"
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções de leitura e representação do problema.
+// * -----------------------------------------------------------------------------
+
+/*
+ * Function: ler_arquivo
+ * -----------------------------------------------------------------------------
+ *   Lê um arquivo com o formato definido e mapeia a matriz de adjacência para
+ *   memória. Arquivos no formato TSPLIB (iniciados por palavras-chave como
+ *   NAME ou DIMENSION) são lidos por ler_arquivo_tsplib. Em caso de erro o
+ *   problema fica sem dados alocados e nada é exibido; a mensagem é obtida
+ *   por descrever_erro.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   arquivo: caminho físico para o arquivo que será lido.
+ *   paginas_grandes: TRUE para alocar as tabelas grandes do problema em
+ *   páginas grandes (ver alocar_memoria).
+ *
+ *   returns: 0 em caso de sucesso ou o código do erro (ERRO_*).
+ */
+int ler_arquivo(struct problema* p, char* arquivo, int paginas_grandes) {
+    FILE* fp;
+    int erro;
+    int t;
+    int c;
+    
+    p->tipo_distancia = DISTANCIA_MATRIZ;
+    p->elementos = NULL;
+    p->coordenada_x = NULL;
+    p->coordenada_y = NULL;
+    p->cache = NULL;
+    p->matriz_compacta = NULL;
+    p->kernel = NULL;
+    p->contexto = NULL;
+    p->paginas_grandes = paginas_grandes;
+    
+    fp = fopen(arquivo, "r");
+    if(!fp) {
+        return ERRO_ABERTURA;
+    }
+    
+    //identificando o formato do arquivo pelo primeiro caractere
+    do {
+        c = fgetc(fp);
+    } while(c != EOF && isspace(c));
+    ungetc(c, fp);
+    
+    if(c != EOF && !isdigit(c)) {
+        erro = ler_arquivo_tsplib(p, fp);
+        fclose(fp);
+        return erro;
+    }
+    
+    if(fscanf(fp, "%d %d\n\n", &p->tamanho, &t) != 2 || p->tamanho <= 0) {
+        fclose(fp);
+        return ERRO_FORMATO;
+    }
+    
+    //alocando espaço para a matriz de adjacencia
+    p->elementos = alocar_matriz(p->tamanho, p->paginas_grandes);
+    
+    if(!p->elementos) {
+        fclose(fp);
+        return ERRO_MEMORIA;
+    }
+    
+    erro = 0;
+    
+    //pulando as linhas de 1s
+    for(int i = 0; i < p->tamanho && !erro; i++) {
+        erro = fscanf(fp, "%d ", &t) != 1;
+    }
+    
+    //percorrendo os elementos da matriz de ajdacencia que estao no arquivo
+    for(int i = 0; i < p->tamanho && !erro; i++) {
+        for(int j = 0; j < p->tamanho && !erro; j++) {
+            erro = fscanf(fp, "%d ", &p->elementos[i][j]) != 1;
+        }
+    }
+    
+    fclose(fp);
+    
+    if(erro) {
+        liberar_memoria(p->elementos[0]);
+        free(p->elementos);
+        p->elementos = NULL;
+        return ERRO_FORMATO;
+    }
+    
+    selecionar_kernel(p);
+    
+    return 0;
+}
+
+/*
+ * Function: ler_arquivo_tsplib
+ * -----------------------------------------------------------------------------
+ *   Lê uma instância no formato TSPLIB com a seção NODE_COORD_SECTION e os
+ *   tipos de distância EUC_2D, CEIL_2D ou ATT. Apenas as coordenadas são
+ *   mantidas em memória; a matriz de adjacência é montada somente para
+ *   instâncias com até TAMANHO_MAXIMO_MATRIZ elementos. O primeiro elemento
+ *   da seção de coordenadas é utilizado como origem (elemento 0).
+ *
+ *   p: estrutura de dados representando o problema.
+ *   fp: arquivo aberto posicionado no início do cabeçalho.
+ *
+ *   returns: 0 em caso de sucesso ou o código do erro (ERRO_*).
+ */
+int ler_arquivo_tsplib(struct problema* p, FILE* fp) {
+    char buffer[1024];
+    char valor[64];
+    char* separador;
+    int indice;
+    
+    p->tamanho = 0;
+    p->tipo_distancia = DISTANCIA_EUC_2D;
+    
+    while(fgets(buffer, sizeof(buffer), fp)) {
+        valor[0] = '\0';
+        separador = strchr(buffer, ':');
+        if(separador) {
+            sscanf(separador + 1, "%63s", valor);
+        }
+        
+        if(strncmp(buffer, "DIMENSION", 9) == 0) {
+            p->tamanho = atoi(valor);
+        } else if(strncmp(buffer, "EDGE_WEIGHT_TYPE", 16) == 0) {
+            if(strcmp(valor, "EUC_2D") == 0) {
+                p->tipo_distancia = DISTANCIA_EUC_2D;
+            } else if(strcmp(valor, "CEIL_2D") == 0) {
+                p->tipo_distancia = DISTANCIA_CEIL_2D;
+            } else if(strcmp(valor, "ATT") == 0) {
+                p->tipo_distancia = DISTANCIA_ATT;
+            } else {
+                return ERRO_DISTANCIA;
+            }
+        } else if(strncmp(buffer, "NODE_COORD_SECTION", 18) == 0) {
+            break;
+        }
+    }
+    
+    if(p->tamanho <= 0) {
+        return ERRO_FORMATO;
+    }
+    
+    p->coordenada_x = malloc(p->tamanho * sizeof(double));
+    p->coordenada_y = malloc(p->tamanho * sizeof(double));
+    
+    for(int i = 0; i < p->tamanho; i++) {
+        if(fscanf(fp, "%d %lf %lf", &indice, &p->coordenada_x[i], &p->coordenada_y[i]) != 3) {
+            free(p->coordenada_x);
+            free(p->coordenada_y);
+            p->coordenada_x = NULL;
+            p->coordenada_y = NULL;
+            return ERRO_FORMATO;
+        }
+    }
+    
+    //instâncias pequenas continuam utilizando a matriz de adjacência
+    if(p->tamanho <= TAMANHO_MAXIMO_MATRIZ) {
+        int** elementos = alocar_matriz(p->tamanho, p->paginas_grandes);
+        
+        if(!elementos) {
+            free(p->coordenada_x);
+            free(p->coordenada_y);
+            p->coordenada_x = NULL;
+            p->coordenada_y = NULL;
+            return ERRO_MEMORIA;
+        }
+        
+        for(int i = 0; i < p->tamanho; i++) {
+            for(int j = 0; j < p->tamanho; j++) {
+                elementos[i][j] = calcular_distancia(p, i, j);
+            }
+        }
+        
+        p->elementos = elementos;
+        selecionar_kernel(p);
+    }
+    
+    return 0;
+}
+
+/*
+ * Function: inicializar_problema
+ * -----------------------------------------------------------------------------
+ *   Inicializa o problema a partir de uma matriz de adjacência em memória,
+ *   sem a leitura de arquivos. A matriz é copiada.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   tamanho: quantidade de elementos.
+ *   matriz: matriz de adjacência armazenada por linhas (tamanho * tamanho).
+ *   paginas_grandes: TRUE para alocar as tabelas grandes do problema em
+ *   páginas grandes (ver alocar_memoria).
+ *
+ *   returns: 0 em caso de sucesso ou ERRO_MEMORIA.
+ */
+int inicializar_problema(struct problema* p, int tamanho, const int* matriz, int paginas_grandes) {
+    p->tamanho = tamanho;
+    p->tipo_distancia = DISTANCIA_MATRIZ;
+    p->coordenada_x = NULL;
+    p->coordenada_y = NULL;
+    p->cache = NULL;
+    p->matriz_compacta = NULL;
+    p->kernel = NULL;
+    p->contexto = NULL;
+    p->paginas_grandes = paginas_grandes;
+    p->elementos = alocar_matriz(tamanho, paginas_grandes);
+    
+    if(!p->elementos) {
+        return ERRO_MEMORIA;
+    }
+    
+    memcpy(p->elementos[0], matriz, (size_t) tamanho * tamanho * sizeof(int));
+    
+    selecionar_kernel(p);
+    
+    return 0;
+}
+
+/*
+ * Function: alocar_matriz
+ * -----------------------------------------------------------------------------
+ *   Aloca uma matriz de adjacência zerada em um único bloco contíguo (ver
+ *   alocar_memoria), com um vetor de ponteiros para o início de cada linha.
+ *
+ *   tamanho: quantidade de elementos.
+ *   paginas_grandes: TRUE para tentar utilizar páginas grandes.
+ *
+ *   returns: o vetor de ponteiros para as linhas da matriz ou NULL caso não
+ *   haja memória suficiente.
+ */
+int** alocar_matriz(int tamanho, int paginas_grandes) {
+    int** linhas = malloc(tamanho * sizeof(int*));
+    int* bloco = alocar_memoria((size_t) tamanho * tamanho * sizeof(int), paginas_grandes);
+    
+    if(!linhas || !bloco) {
+        free(linhas);
+        liberar_memoria(bloco);
+        return NULL;
+    }
+    
+    for(int i = 0; i < tamanho; i++) {
+        linhas[i] = bloco + (size_t) i * tamanho;
+    }
+    
+    return linhas;
+}
+
+/*
+ * Function: liberar_problema
+ * -----------------------------------------------------------------------------
+ *   Libera a memória alocada para a representação do problema.
+ *
+ *   p: estrutura de dados representando o problema.
+ */
+void liberar_problema(struct problema* p) {
+    if(p->elementos) {
+        liberar_memoria(p->elementos[0]);
+        free(p->elementos);
+    }
+    
+    if(p->cache) {
+        liberar_cache_distancias(p->cache);
+    }
+    
+    free(p->coordenada_x);
+    free(p->coordenada_y);
+    liberar_kernel(p);
+    
+    if(p->contexto) {
+        liberar_contexto(p->contexto);
+    }
+}
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções de acesso às distâncias entre os elementos.
+// * -----------------------------------------------------------------------------
+
+/*
+ * Function: calcular_distancia
+ * -----------------------------------------------------------------------------
+ *   Calcula a distância entre 2 elementos a partir das coordenadas, seguindo
+ *   as definições da TSPLIB para os tipos EUC_2D, CEIL_2D e ATT.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   i: elemento de origem.
+ *   j: elemento de destino.
+ */
+int calcular_distancia(struct problema* p, int i, int j) {
+    double dx = p->coordenada_x[i] - p->coordenada_x[j];
+    double dy = p->coordenada_y[i] - p->coordenada_y[j];
+    double r;
+    int t;
+    
+    switch (p->tipo_distancia) {
+        case DISTANCIA_CEIL_2D:
+            return (int) ceil(sqrt(dx * dx + dy * dy));
+        case DISTANCIA_ATT:
+            r = sqrt((dx * dx + dy * dy) / 10.0);
+            t = (int) (r + 0.5);
+            return t < r ? t + 1 : t;
+        default:
+            return (int) (sqrt(dx * dx + dy * dy) + 0.5);
+    }
+}
+
+/*
+ * Function: inicializar_cache_distancias
+ * -----------------------------------------------------------------------------
+ *   Cria um cache limitado de distâncias com política LRU. As distâncias são
+ *   armazenadas em blocos de BLOCO_CACHE_DISTANCIAS destinos consecutivos de
+ *   uma mesma origem, de forma que uma falta calcule apenas o bloco do
+ *   destino pedido e não a linha inteira. O cache ocupa a memória de
+ *   "linhas" linhas de distâncias.
+ *
+ *   Os blocos são localizados por uma tabela hash com encadeamento e a ordem
+ *   de uso é mantida por uma lista duplamente encadeada, de forma que tanto a
+ *   consulta quanto a substituição do bloco usado há mais tempo custem O(1).
+ *
+ *   p: estrutura de dados representando o problema.
+ *   linhas: quantidade de linhas de distâncias equivalente à capacidade.
+ */
+void inicializar_cache_distancias(struct problema* p, int linhas) {
+    struct cache_distancias* cache = malloc(sizeof(struct cache_distancias));
+    long long capacidade;
+    int baldes = 1;
+    
+    if(linhas > p->tamanho) {
+        linhas = p->tamanho;
+    }
+    
+    cache->blocos_linha = (p->tamanho + BLOCO_CACHE_DISTANCIAS - 1) / BLOCO_CACHE_DISTANCIAS;
+    capacidade = (long long) linhas * cache->blocos_linha;
+    cache->capacidade = capacidade < INT_MAX / BLOCO_CACHE_DISTANCIAS ? (int) capacidade : INT_MAX / BLOCO_CACHE_DISTANCIAS;
+    
+    while(baldes < cache->capacidade && baldes < INT_MAX / 2) {
+        baldes *= 2;
+    }
+    
+    cache->mascara = baldes - 1;
+    cache->baldes = malloc(baldes * sizeof(int));
+    cache->chaves = malloc(cache->capacidade * sizeof(long long));
+    cache->proximo_balde = malloc(cache->capacidade * sizeof(int));
+    cache->anterior = malloc(cache->capacidade * sizeof(int));
+    cache->proximo = malloc(cache->capacidade * sizeof(int));
+    cache->valores = alocar_memoria((size_t) cache->capacidade * BLOCO_CACHE_DISTANCIAS * sizeof(int), p->paginas_grandes);
+    
+    for(int b = 0; b < baldes; b++) {
+        cache->baldes[b] = -1;
+    }
+    
+    //os blocos começam vazios, encadeados do mais recente (0) ao menos recente
+    for(int s = 0; s < cache->capacidade; s++) {
+        cache->chaves[s] = -1;
+        cache->proximo_balde[s] = -1;
+        cache->anterior[s] = s - 1;
+        cache->proximo[s] = s + 1 < cache->capacidade ? s + 1 : -1;
+    }
+    
+    cache->mais_recente = 0;
+    cache->menos_recente = cache->capacidade - 1;
+    
+    p->cache = cache;
+}
+
+/*
+ * Function: balde_cache
+ * -----------------------------------------------------------------------------
+ *   Retorna o balde da tabela hash de um bloco (hash multiplicativo).
+ */
+static inline int balde_cache(struct cache_distancias* cache, long long chave) {
+    return (int) (((unsigned long long) chave * 0x9e3779b97f4a7c15ULL) >> 32) & cache->mascara;
+}
+
+/*
+ * Function: obter_distancia_cache
+ * -----------------------------------------------------------------------------
+ *   Retorna a distância entre 2 elementos pelo cache, calculando o bloco do
+ *   destino e substituindo o bloco usado há mais tempo caso ele não esteja
+ *   no cache.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   i: elemento de origem.
+ *   j: elemento de destino.
+ *
+ *   returns: a distância entre i e j.
+ */
+int obter_distancia_cache(struct problema* p, int i, int j) {
+    struct cache_distancias* cache = p->cache;
+    long long chave = (long long) i * cache->blocos_linha + j / BLOCO_CACHE_DISTANCIAS;
+    int balde = balde_cache(cache, chave);
+    int slot = cache->baldes[balde];
+    int* anterior;
+    int* bloco;
+    int inicio;
+    
+    while(slot >= 0 && cache->chaves[slot] != chave) {
+        slot = cache->proximo_balde[slot];
+    }
+    
+    if(slot < 0) {
+        slot = cache->menos_recente;
+        
+        //retirando o bloco substituído do seu balde
+        if(cache->chaves[slot] >= 0) {
+            anterior = &cache->baldes[balde_cache(cache, cache->chaves[slot])];
+            
+            while(*anterior != slot) {
+                anterior = &cache->proximo_balde[*anterior];
+            }
+            
+            *anterior = cache->proximo_balde[slot];
+        }
+        
+        bloco = cache->valores + (size_t) slot * BLOCO_CACHE_DISTANCIAS;
+        inicio = j - j % BLOCO_CACHE_DISTANCIAS;
+        
+        for(int k = 0; k < BLOCO_CACHE_DISTANCIAS && inicio + k < p->tamanho; k++) {
+            bloco[k] = calcular_distancia(p, i, inicio + k);
+        }
+        
+        cache->chaves[slot] = chave;
+        cache->proximo_balde[slot] = cache->baldes[balde];
+        cache->baldes[balde] = slot;
+    }
+    
+    //movendo o bloco para o início da lista de uso
+    if(slot != cache->mais_recente) {
+        cache->proximo[cache->anterior[slot]] = cache->proximo[slot];
+        
+        if(cache->proximo[slot] >= 0) {
+            cache->anterior[cache->proximo[slot]] = cache->anterior[slot];
+        } else {
+            cache->menos_recente = cache->anterior[slot];
+        }
+        
+        cache->anterior[slot] = -1;
+        cache->proximo[slot] = cache->mais_recente;
+        cache->anterior[cache->mais_recente] = slot;
+        cache->mais_recente = slot;
+    }
+    
+    return cache->valores[(size_t) slot * BLOCO_CACHE_DISTANCIAS + j % BLOCO_CACHE_DISTANCIAS];
+}
+
+/*
+ * Function: liberar_cache_distancias
+ * -----------------------------------------------------------------------------
+ *   Libera a memória alocada para um cache de distâncias.
+ *
+ *   cache: cache que será liberado.
+ */
+void liberar_cache_distancias(struct cache_distancias* cache) {
+    free(cache->baldes);
+    free(cache->chaves);
+    free(cache->proximo_balde);
+    free(cache->anterior);
+    free(cache->proximo);
+    liberar_memoria(cache->valores);
+    free(cache);
+}
+
+/*
+ * Function: descrever_erro
+ * -----------------------------------------------------------------------------
+ *   Descreve um código de erro retornado pelas funções da biblioteca, para
+ *   que o chamador decida como informá-lo.
+ *
+ *   erro: código do erro (ERRO_*).
+ *
+ *   returns: a descrição do erro.
+ */
+const char* descrever_erro(int erro) {
+    switch (erro) {
+        case ERRO_ABERTURA:
+            return "não foi possível abrir o arquivo";
+        case ERRO_FORMATO:
+            return "formato de instância inválido";
+        case ERRO_DISTANCIA:
+            return "tipo de distância não suportado (apenas EUC_2D, CEIL_2D e ATT)";
+        case ERRO_MEMORIA:
+            return "memória insuficiente";
+        case ERRO_CHECKPOINT:
+            return "checkpoint inválido ou gerado para outra instância ou com parâmetros diferentes";
+        case ERRO_SOLUCAO:
+            return "solução inválida para a instância (todos os elementos, a partir da origem)";
+        case ERRO_ALTERACOES:
+            return "operação inválida no arquivo de alterações ou instância sem a matriz de adjacência";
+        default:
+            return "erro desconhecido";
+    }
+}
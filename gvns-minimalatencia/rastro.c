@@ -0,0 +1,142 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "interno.h"
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções do rastro de eventos da busca.
+// * -----------------------------------------------------------------------------
+
+static const char* nomes_eventos[] = {"construcao", "abalo", "vizinhanca", "path_relinking", "melhora"};
+
+/*
+ * Function: criar_rastro
+ * -----------------------------------------------------------------------------
+ *   Cria um rastro de eventos com um buffer circular da capacidade
+ *   informada. Quando o buffer está cheio os eventos mais antigos são
+ *   sobrescritos, de forma que o registro nunca aloca memória nem interrompe
+ *   a busca.
+ *
+ *   capacidade: quantidade máxima de eventos mantidos.
+ *
+ *   returns: o rastro alocado.
+ */
+struct rastro* criar_rastro(long long capacidade) {
+    struct rastro* r = malloc(sizeof(struct rastro));
+    
+    if(capacidade < 1) {
+        capacidade = RASTRO_CAPACIDADE_PADRAO;
+    }
+    
+    r->eventos = malloc(capacidade * sizeof(struct evento_rastro));
+    r->capacidade = capacidade;
+    r->total = 0;
+    r->execucao = 0;
+    r->inicio = relogio();
+    
+    return r;
+}
+
+/*
+ * Function: registrar_evento
+ * -----------------------------------------------------------------------------
+ *   Registra um evento no rastro. Utilizada pelas macros RASTRO_EVENTO e
+ *   RASTRO_PONTO.
+ *
+ *   r: rastro.
+ *   tipo: tipo do evento (RASTRO_*).
+ *   inicio: instante de início do evento (ver relogio) ou -1 para um evento
+ *   pontual no instante atual.
+ *   vizinhanca: vizinhança associada ao evento (-1 para nenhuma).
+ *   custo: custo associado ao evento.
+ */
+void registrar_evento(struct rastro* r, int tipo, double inicio, int vizinhanca, long long custo) {
+    struct evento_rastro* e = &r->eventos[r->total % r->capacidade];
+    double agora = relogio();
+    
+    if(inicio < 0) {
+        inicio = agora;
+    }
+    
+    e->inicio = inicio - r->inicio;
+    e->duracao = agora - inicio;
+    e->custo = custo;
+    e->tipo = tipo;
+    e->execucao = r->execucao;
+    e->vizinhanca = vizinhanca;
+    
+    r->total++;
+}
+
+/*
+ * Function: gravar_rastro
+ * -----------------------------------------------------------------------------
+ *   Grava os eventos mantidos no rastro, do mais antigo para o mais recente.
+ *   Arquivos com a extensão .json recebem o formato trace-event do Chrome
+ *   (chrome://tracing ou Perfetto), com uma linha do tempo por execução e um
+ *   contador com o custo da solução incumbente; os demais recebem CSV:
+ *
+ *   execucao;evento;inicio;duracao;vizinhanca;custo
+ *
+ *   Os tempos são dados em segundos no CSV e em microssegundos no JSON, a
+ *   partir da criação do rastro.
+ *
+ *   r: rastro.
+ *   arquivo: arquivo de destino.
+ *
+ *   returns: TRUE caso o arquivo tenha sido gravado.
+ */
+int gravar_rastro(struct rastro* r, char* arquivo) {
+    FILE* fp;
+    struct evento_rastro* e;
+    long long primeiro = r->total > r->capacidade ? r->total - r->capacidade : 0;
+    size_t tamanho = strlen(arquivo);
+    int json = tamanho >= 5 && strcmp(arquivo + tamanho - 5, ".json") == 0;
+    
+    fp = fopen(arquivo, "w");
+    if(!fp) {
+        return FALSE;
+    }
+    
+    if(json) {
+        fprintf(fp, "{\"traceEvents\":[\n");
+    } else {
+        fprintf(fp, "execucao;evento;inicio;duracao;vizinhanca;custo\n");
+    }
+    
+    for(long long k = primeiro; k < r->total; k++) {
+        e = &r->eventos[k % r->capacidade];
+        
+        if(!json) {
+            fprintf(fp, "%d;%s;%.9f;%.9f;%d;%lld\n", e->execucao, nomes_eventos[e->tipo], e->inicio, e->duracao, e->vizinhanca, e->custo);
+        } else if(e->tipo == RASTRO_MELHORA) {
+            fprintf(fp, "{\"name\":\"custo\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":0,\"tid\":%d,\"args\":{\"execucao %d\":%lld}},\n", e->inicio * 1e6, e->execucao, e->execucao, e->custo);
+            fprintf(fp, "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":0,\"tid\":%d,\"args\":{\"vizinhanca\":%d,\"custo\":%lld}}", nomes_eventos[e->tipo], e->inicio * 1e6, e->execucao, e->vizinhanca, e->custo);
+        } else {
+            fprintf(fp, "{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%d,\"args\":{\"vizinhanca\":%d,\"custo\":%lld}}", nomes_eventos[e->tipo], e->inicio * 1e6, e->duracao * 1e6, e->execucao, e->vizinhanca, e->custo);
+        }
+        
+        if(json && k < r->total - 1) {
+            fprintf(fp, ",\n");
+        }
+    }
+    
+    if(json) {
+        fprintf(fp, "\n],\"descartados\":%lld}\n", primeiro);
+    }
+    
+    return fclose(fp) == 0;
+}
+
+/*
+ * Function: liberar_rastro
+ * -----------------------------------------------------------------------------
+ *   Libera a memória alocada para o rastro.
+ *
+ *   r: rastro que será liberado.
+ */
+void liberar_rastro(struct rastro* r) {
+    free(r->eventos);
+    free(r);
+}
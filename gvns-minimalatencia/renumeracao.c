@@ -0,0 +1,164 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+
+#include "interno.h"
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções da renumeração dos elementos.
+// *
+// * Os índices dos elementos no arquivo da instância são arbitrários, de forma
+// * que posições consecutivas de uma solução acessam linhas e colunas
+// * distantes da matriz de adjacência. A renumeração atribui índices
+// * consecutivos a elementos próximos (na ordem de uma solução conhecida ou
+// * de uma cadeia gulosa de vizinhos mais próximos) e permuta a matriz uma
+// * única vez; a busca é realizada com os novos índices e as soluções são
+// * traduzidas para os índices originais apenas na saída. A origem mantém o
+// * índice 0.
+// * -----------------------------------------------------------------------------
+
+/*
+ * Function: ordenar_por_proximidade
+ * -----------------------------------------------------------------------------
+ *   Monta a cadeia gulosa de vizinhos mais próximos a partir da origem: o
+ *   próximo elemento da cadeia é o elemento ainda não incluído mais próximo
+ *   do último incluído (empates pelo menor índice).
+ *
+ *   p: estrutura de dados representando o problema.
+ *
+ *   returns: a ordem dos elementos na cadeia (p->tamanho posições), em que
+ *   ordem[k] é o índice original do elemento que recebe o índice k.
+ */
+int* ordenar_por_proximidade(struct problema* p) {
+    int* ordem = malloc(p->tamanho * sizeof(int));
+    char* incluido = calloc(p->tamanho, sizeof(char));
+    int atual = 0;
+    int proximo;
+    int menor;
+    int d;
+    
+    ordem[0] = 0;
+    incluido[0] = TRUE;
+    
+    for(int k = 1; k < p->tamanho; k++) {
+        proximo = -1;
+        menor = INT_MAX;
+        
+        for(int j = 0; j < p->tamanho; j++) {
+            if(!incluido[j]) {
+                d = distancia(p, atual, j);
+                
+                if(d < menor || proximo < 0) {
+                    menor = d;
+                    proximo = j;
+                }
+            }
+        }
+        
+        ordem[k] = proximo;
+        incluido[proximo] = TRUE;
+        atual = proximo;
+    }
+    
+    free(incluido);
+    
+    return ordem;
+}
+
+/*
+ * Function: renumerar_problema
+ * -----------------------------------------------------------------------------
+ *   Permuta a matriz de adjacência e as coordenadas do problema, de forma que
+ *   o elemento ordem[k] passe a ter o índice k, e monta novamente a matriz
+ *   compacta do kernel de custo. Deve ser chamada antes da preparação do
+ *   contexto e da criação dos solucionadores.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   ordem: nova ordem dos elementos (ver ordenar_por_proximidade), com
+ *   ordem[0] = 0.
+ *
+ *   returns: 0 em caso de sucesso ou ERRO_MEMORIA, com o problema inalterado.
+ */
+int renumerar_problema(struct problema* p, const int* ordem) {
+    int n = p->tamanho;
+    int** elementos;
+    double* coordenadas;
+    
+    if(p->elementos) {
+        elementos = alocar_matriz(n, p->paginas_grandes);
+        
+        if(!elementos) {
+            return ERRO_MEMORIA;
+        }
+        
+        for(int i = 0; i < n; i++) {
+            for(int j = 0; j < n; j++) {
+                elementos[i][j] = p->elementos[ordem[i]][ordem[j]];
+            }
+        }
+        
+        liberar_memoria(p->elementos[0]);
+        free(p->elementos);
+        p->elementos = elementos;
+        
+        selecionar_kernel(p);
+    }
+    
+    if(p->coordenada_x) {
+        coordenadas = malloc(n * sizeof(double));
+        for(int i = 0; i < n; i++) {
+            coordenadas[i] = p->coordenada_x[ordem[i]];
+        }
+        free(p->coordenada_x);
+        p->coordenada_x = coordenadas;
+        
+        coordenadas = malloc(n * sizeof(double));
+        for(int i = 0; i < n; i++) {
+            coordenadas[i] = p->coordenada_y[ordem[i]];
+        }
+        free(p->coordenada_y);
+        p->coordenada_y = coordenadas;
+    }
+    
+    return 0;
+}
+
+/*
+ * Function: traduzir_solucao
+ * -----------------------------------------------------------------------------
+ *   Traduz uma solução com os novos índices para os índices originais.
+ *
+ *   tamanho: tamanho do problema.
+ *   ordem: ordem utilizada na renumeração.
+ *   solucao: solução traduzida (tamanho + 1 posições).
+ */
+void traduzir_solucao(int tamanho, const int* ordem, int* solucao) {
+    for(int k = 0; k <= tamanho; k++) {
+        solucao[k] = ordem[solucao[k]];
+    }
+}
+
+/*
+ * Function: renumerar_solucao
+ * -----------------------------------------------------------------------------
+ *   Traduz uma solução com os índices originais para os novos índices
+ *   (operação inversa de traduzir_solucao).
+ *
+ *   tamanho: tamanho do problema.
+ *   ordem: ordem utilizada na renumeração.
+ *   solucao: solução traduzida (tamanho + 1 posições).
+ */
+void renumerar_solucao(int tamanho, const int* ordem, int* solucao) {
+    int* indices = malloc(tamanho * sizeof(int));
+    
+    for(int k = 0; k < tamanho; k++) {
+        indices[ordem[k]] = k;
+    }
+    
+    for(int k = 0; k <= tamanho; k++) {
+        solucao[k] = indices[solucao[k]];
+    }
+    
+    free(indices);
+}
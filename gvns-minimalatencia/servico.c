@@ -0,0 +1,1110 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+
+#include "modos.h"
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções do modo serviço.
+// *
+// * O serviço permanece em execução recebendo requisições no formato JSON, uma
+// * por linha, pela entrada padrão ou pelos clientes conectados a um socket de
+// * domínio Unix. As instâncias lidas, com o seu contexto pré-processado,
+// * permanecem em um cache LRU, de forma que as requisições seguintes sobre a
+// * mesma instância não repitam a leitura do arquivo. As execuções de todas as
+// * requisições são realizadas por um conjunto fixo de threads.
+// *
+// * Requisição (apenas a instância é obrigatória):
+// *   {"id": 7, "instancia": "arquivo.txt", "iteracoes": 100,
+// *    "vizinhancas": 5, "construcao_aleatoria": 1, "execucoes": 4,
+// *    "semente": 0, "alvo": 0, "tempo_maximo": 2.5, "construcoes": 1,
+// *    "elite": 1, "cache_linhas": 0, "varredura_unificada": false,
+// *    "vnd_localizado": false, "incumbentes": true}
+// *   A instância também pode ser informada diretamente, no lugar de
+// *   "instancia", por "matriz": [[0, 3], [3, 0]]. A execução i utiliza a
+// *   semente semente + i. Os valores numéricos, exceto a semente e o alvo,
+// *   não podem ultrapassar INT_MAX; execucoes e vizinhancas são limitados a
+// *   SERVICO_MAXIMO_EXECUCOES e SERVICO_MAXIMO_VIZINHANCAS.
+// *
+// * Respostas (com o id da requisição):
+// *   {"id": 7, "tipo": "incumbente", "execucao": i, "custo": c, "tempo": t, "solucao": [...]}
+// *   {"id": 7, "tipo": "resultado", "execucao": i, "semente": s, "custo": c, "tempo": t, "solucao": [...]}
+// *   {"id": 7, "tipo": "fim", "execucoes": n, "melhor": c, "tempo": t, "cache": true}
+// *   {"id": 7, "tipo": "erro", "mensagem": "..."}
+// *   Uma incumbente é enviada a cada melhora da melhor solução entre todas as
+// *   execuções da requisição; "cache" indica se a instância já estava em
+// *   memória.
+// * -----------------------------------------------------------------------------
+
+/*
+ * Function: pular_espacos_json
+ * -----------------------------------------------------------------------------
+ *   Avança o texto até o próximo caractere que não seja um espaço.
+ */
+static void pular_espacos_json(char** texto) {
+    while(**texto == ' ' || **texto == '\t' || **texto == '\r' || **texto == '\n') {
+        (*texto)++;
+    }
+}
+
+/*
+ * Function: ler_cadeia_json
+ * -----------------------------------------------------------------------------
+ *   Lê uma cadeia de caracteres JSON (sem suporte a \u).
+ *
+ *   texto: posição do texto, avançada até o fim da cadeia.
+ *   destino: cadeia lida.
+ *   capacidade: tamanho do destino.
+ *
+ *   returns: TRUE caso a cadeia tenha sido lida.
+ */
+static int ler_cadeia_json(char** texto, char* destino, size_t capacidade) {
+    char* t = *texto;
+    size_t usados = 0;
+    char c;
+    
+    if(*t != '"') {
+        return FALSE;
+    }
+    
+    for(t++; *t && *t != '"'; t++) {
+        c = *t;
+        
+        if(c == '\\') {
+            c = *++t;
+            
+            if(c == 'n') {
+                c = '\n';
+            } else if(c == 't') {
+                c = '\t';
+            } else if(c != '"' && c != '\\' && c != '/') {
+                return FALSE;
+            }
+        }
+        
+        if(usados + 1 >= capacidade) {
+            return FALSE;
+        }
+        
+        destino[usados++] = c;
+    }
+    
+    if(*t != '"') {
+        return FALSE;
+    }
+    
+    destino[usados] = '\0';
+    *texto = t + 1;
+    
+    return TRUE;
+}
+
+/*
+ * Function: ler_inteiro_json
+ * -----------------------------------------------------------------------------
+ *   Lê um número inteiro JSON. Os valores true e false são lidos como TRUE e
+ *   FALSE.
+ *
+ *   texto: posição do texto, avançada até o fim do número.
+ *   valor: número lido.
+ *
+ *   returns: TRUE caso o número tenha sido lido.
+ */
+static int ler_inteiro_json(char** texto, long long* valor) {
+    char* fim;
+    
+    if(strncmp(*texto, "true", 4) == 0 || strncmp(*texto, "false", 5) == 0) {
+        *valor = **texto == 't';
+        *texto += *valor ? 4 : 5;
+        return TRUE;
+    }
+    
+    *valor = strtoll(*texto, &fim, 10);
+    
+    if(fim == *texto || *fim == '.' || *fim == 'e' || *fim == 'E') {
+        return FALSE;
+    }
+    
+    *texto = fim;
+    
+    return TRUE;
+}
+
+/*
+ * Function: pular_valor_json
+ * -----------------------------------------------------------------------------
+ *   Avança o texto até o fim do próximo valor JSON (cadeia, número, literal,
+ *   vetor ou objeto).
+ *
+ *   texto: posição do texto.
+ *
+ *   returns: TRUE caso o valor seja válido.
+ */
+static int pular_valor_json(char** texto) {
+    char* t;
+    char fechamento;
+    
+    pular_espacos_json(texto);
+    t = *texto;
+    
+    if(*t == '"') {
+        for(t++; *t && *t != '"'; t++) {
+            if(*t == '\\' && t[1]) {
+                t++;
+            }
+        }
+        
+        if(!*t) {
+            return FALSE;
+        }
+        
+        *texto = t + 1;
+        return TRUE;
+    }
+    
+    if(*t == '[' || *t == '{') {
+        fechamento = *t == '[' ? ']' : '}';
+        (*texto)++;
+        pular_espacos_json(texto);
+        
+        if(**texto == fechamento) {
+            (*texto)++;
+            return TRUE;
+        }
+        
+        while(TRUE) {
+            if(fechamento == '}') {
+                if(!pular_valor_json(texto)) {
+                    return FALSE;
+                }
+                
+                pular_espacos_json(texto);
+                
+                if(**texto != ':') {
+                    return FALSE;
+                }
+                
+                (*texto)++;
+            }
+            
+            if(!pular_valor_json(texto)) {
+                return FALSE;
+            }
+            
+            pular_espacos_json(texto);
+            
+            if(**texto == fechamento) {
+                (*texto)++;
+                return TRUE;
+            }
+            
+            if(**texto != ',') {
+                return FALSE;
+            }
+            
+            (*texto)++;
+        }
+    }
+    
+    //números e literais (true, false e null)
+    while(*t && strchr("+-.0123456789eEtrufalsn", *t)) {
+        t++;
+    }
+    
+    if(t == *texto) {
+        return FALSE;
+    }
+    
+    *texto = t;
+    
+    return TRUE;
+}
+
+/*
+ * Function: ler_matriz_json
+ * -----------------------------------------------------------------------------
+ *   Lê uma matriz de adjacência quadrada representada por um vetor JSON de
+ *   linhas.
+ *
+ *   texto: posição do texto, avançada até o fim da matriz.
+ *   matriz: recebe a matriz lida, armazenada por linhas (liberada pelo
+ *   chamador).
+ *   tamanho: recebe a quantidade de elementos.
+ *
+ *   returns: TRUE caso a matriz tenha sido lida.
+ */
+static int ler_matriz_json(char** texto, int** matriz, int* tamanho) {
+    int capacidade = 64;
+    int quantidade = 0;
+    int linhas = 0;
+    int colunas;
+    long long valor;
+    
+    *matriz = malloc(capacidade * sizeof(int));
+    *tamanho = 0;
+    
+    pular_espacos_json(texto);
+    if(**texto != '[') {
+        return FALSE;
+    }
+    (*texto)++;
+    
+    do {
+        pular_espacos_json(texto);
+        if(**texto != '[') {
+            return FALSE;
+        }
+        (*texto)++;
+        
+        colunas = 0;
+        do {
+            pular_espacos_json(texto);
+            if(!ler_inteiro_json(texto, &valor) || valor < INT_MIN || valor > INT_MAX) {
+                return FALSE;
+            }
+            
+            if(quantidade == capacidade) {
+                capacidade *= 2;
+                *matriz = realloc(*matriz, capacidade * sizeof(int));
+            }
+            
+            (*matriz)[quantidade++] = (int) valor;
+            colunas++;
+            pular_espacos_json(texto);
+        } while(**texto == ',' && (*texto)++);
+        
+        if(**texto != ']' || (linhas > 0 && colunas != *tamanho)) {
+            return FALSE;
+        }
+        (*texto)++;
+        
+        *tamanho = colunas;
+        linhas++;
+        pular_espacos_json(texto);
+    } while(**texto == ',' && (*texto)++);
+    
+    if(**texto != ']' || linhas != *tamanho) {
+        return FALSE;
+    }
+    (*texto)++;
+    
+    return TRUE;
+}
+
+/*
+ * Function: ler_requisicao
+ * -----------------------------------------------------------------------------
+ *   Lê os campos de uma requisição. Campos desconhecidos são ignorados.
+ *
+ *   linha: requisição recebida.
+ *   r: requisição preenchida (id, opções, semente, execuções e incumbentes).
+ *   caminho: recebe o arquivo da instância (vazio quando não informado).
+ *   capacidade: tamanho de caminho.
+ *   matriz: recebe a matriz informada diretamente (NULL quando não
+ *   informada).
+ *   tamanho: recebe a quantidade de elementos da matriz.
+ *
+ *   returns: NULL ou a descrição do erro encontrado.
+ */
+static const char* ler_requisicao(char* linha, struct requisicao_servico* r, char* caminho, size_t capacidade, int** matriz, int* tamanho) {
+    char chave[64];
+    char* inicio;
+    long long valor;
+    
+    caminho[0] = '\0';
+    pular_espacos_json(&linha);
+    
+    if(*linha != '{') {
+        return "a requisição deve ser um objeto JSON";
+    }
+    linha++;
+    pular_espacos_json(&linha);
+    
+    while(*linha != '}') {
+        if(!ler_cadeia_json(&linha, chave, sizeof(chave))) {
+            return "JSON inválido";
+        }
+        
+        pular_espacos_json(&linha);
+        if(*linha != ':') {
+            return "JSON inválido";
+        }
+        linha++;
+        pular_espacos_json(&linha);
+        
+        if(strcmp(chave, "id") == 0) {
+            inicio = linha;
+            
+            if((*linha != '"' && *linha != '-' && (*linha < '0' || *linha > '9')) || !pular_valor_json(&linha) || linha - inicio > 256) {
+                return "o id deve ser um número ou uma cadeia de até 256 caracteres";
+            }
+            
+            free(r->id);
+            r->id = malloc(linha - inicio + 1);
+            memcpy(r->id, inicio, linha - inicio);
+            r->id[linha - inicio] = '\0';
+        } else if(strcmp(chave, "instancia") == 0) {
+            if(!ler_cadeia_json(&linha, caminho, capacidade)) {
+                return "instância inválida";
+            }
+        } else if(strcmp(chave, "matriz") == 0) {
+            free(*matriz);
+            if(!ler_matriz_json(&linha, matriz, tamanho)) {
+                return "a matriz deve ser um vetor de linhas de mesmo tamanho";
+            }
+        } else if(strcmp(chave, "tempo_maximo") == 0) {
+            r->opcoes.tempo_maximo = strtod(linha, &inicio);
+            
+            if(inicio == linha) {
+                return "tempo_maximo inválido";
+            }
+            
+            linha = inicio;
+        } else if(strcmp(chave, "iteracoes") == 0 || strcmp(chave, "vizinhancas") == 0 || strcmp(chave, "construcao_aleatoria") == 0
+                  || strcmp(chave, "execucoes") == 0 || strcmp(chave, "semente") == 0 || strcmp(chave, "alvo") == 0
+                  || strcmp(chave, "construcoes") == 0 || strcmp(chave, "elite") == 0 || strcmp(chave, "cache_linhas") == 0
+                  || strcmp(chave, "varredura_unificada") == 0 || strcmp(chave, "vnd_localizado") == 0 || strcmp(chave, "incumbentes") == 0) {
+            if(!ler_inteiro_json(&linha, &valor) || valor < 0) {
+                return "os parâmetros numéricos devem ser inteiros não negativos";
+            }
+            
+            //apenas a semente e o alvo não são armazenados em um int
+            if(valor > INT_MAX && strcmp(chave, "semente") != 0 && strcmp(chave, "alvo") != 0) {
+                return "parâmetro numérico acima do limite de um inteiro";
+            }
+            
+            if(strcmp(chave, "iteracoes") == 0) {
+                r->opcoes.iteracoes = (int) valor;
+            } else if(strcmp(chave, "vizinhancas") == 0) {
+                r->opcoes.vizinhancas = (int) valor;
+            } else if(strcmp(chave, "construcao_aleatoria") == 0) {
+                r->opcoes.construcao_aleatoria = (int) valor;
+            } else if(strcmp(chave, "execucoes") == 0) {
+                r->execucoes = (int) valor;
+            } else if(strcmp(chave, "semente") == 0) {
+                r->semente = (unsigned long long) valor;
+            } else if(strcmp(chave, "alvo") == 0) {
+                r->opcoes.alvo = valor;
+            } else if(strcmp(chave, "construcoes") == 0) {
+                r->opcoes.construcoes = (int) valor;
+            } else if(strcmp(chave, "elite") == 0) {
+                r->opcoes.elite = (int) valor;
+            } else if(strcmp(chave, "cache_linhas") == 0) {
+                r->opcoes.linhas_cache = (int) valor;
+            } else if(strcmp(chave, "varredura_unificada") == 0) {
+                r->opcoes.varredura_unificada = valor ? VARREDURA_POR_VIZINHANCA : FALSE;
+            } else if(strcmp(chave, "vnd_localizado") == 0) {
+                r->opcoes.busca_localizada = valor != 0;
+            } else {
+                r->incumbentes = valor != 0;
+            }
+        } else if(!pular_valor_json(&linha)) {
+            return "JSON inválido";
+        }
+        
+        pular_espacos_json(&linha);
+        if(*linha == ',') {
+            linha++;
+            pular_espacos_json(&linha);
+        } else if(*linha != '}') {
+            return "JSON inválido";
+        }
+    }
+    
+    if(!caminho[0] && !*matriz) {
+        return "a requisição deve informar a instância ou a matriz";
+    }
+    
+    if(r->execucoes < 1 || r->opcoes.vizinhancas < 1) {
+        return "execucoes e vizinhancas devem ser positivos";
+    }
+    
+    if(r->execucoes > SERVICO_MAXIMO_EXECUCOES || r->opcoes.vizinhancas > SERVICO_MAXIMO_VIZINHANCAS) {
+        return "execucoes ou vizinhancas acima do limite do serviço";
+    }
+    
+    return NULL;
+}
+
+/*
+ * Function: enviar_resposta
+ * -----------------------------------------------------------------------------
+ *   Envia ao cliente da requisição uma linha de resposta com o id da
+ *   requisição, os campos informados e, opcionalmente, uma solução.
+ *
+ *   r: requisição.
+ *   campos: campos da resposta, já formatados em JSON.
+ *   tamanho: tamanho do problema.
+ *   solucao: solução enviada (NULL para nenhuma).
+ */
+static void enviar_resposta(struct requisicao_servico* r, char* campos, int tamanho, int* solucao) {
+    const char* id = r->id ? r->id : "null";
+    char* linha = malloc(strlen(id) + strlen(campos) + (solucao ? (size_t) (tamanho + 1) * 12 : 0) + 32);
+    size_t usados = sprintf(linha, "{\"id\":%s,%s", id, campos);
+    
+    if(solucao) {
+        usados += sprintf(linha + usados, ",\"solucao\":[");
+        
+        for(int i = 0; i <= tamanho; i++) {
+            usados += sprintf(linha + usados, i ? ",%d" : "%d", solucao[i]);
+        }
+        
+        linha[usados++] = ']';
+    }
+    
+    strcpy(linha + usados, "}\n");
+    responder_cliente(r->cliente, linha);
+    
+    free(linha);
+}
+
+/*
+ * Function: criar_cliente
+ * -----------------------------------------------------------------------------
+ *   Cria um cliente do serviço. A referência inicial pertence à leitura das
+ *   requisições do cliente (ver atender_cliente).
+ *
+ *   v: serviço.
+ *   entrada: descritor de onde as requisições são lidas.
+ *   saida: descritor onde as respostas são escritas.
+ *
+ *   returns: o cliente alocado.
+ */
+static struct cliente_servico* criar_cliente(struct servico* v, int entrada, int saida) {
+    struct cliente_servico* c = calloc(1, sizeof(struct cliente_servico));
+    
+    c->servico = v;
+    c->saida = saida;
+    c->referencias = 1;
+    iniciar_conexao(&c->conexao, entrada);
+    pthread_mutex_init(&c->mutex, NULL);
+    
+    return c;
+}
+
+/*
+ * Function: executar_servico
+ * -----------------------------------------------------------------------------
+ *   Executa o serviço até o fim da entrada padrão (caminho "-") ou, com um
+ *   socket, indefinidamente, atendendo cada cliente conectado em uma thread
+ *   própria. Ao término, aguarda as requisições em andamento.
+ *
+ *   caminho: caminho do socket de domínio Unix ou "-" para a entrada padrão.
+ *   threads: quantidade de threads das execuções (0 utiliza um thread por
+ *   processador).
+ *   capacidade_cache: quantidade de instâncias mantidas em cache.
+ *   paginas_grandes: TRUE para alocar as tabelas grandes das instâncias em
+ *   páginas grandes (ver alocar_memoria).
+ *
+ *   returns: TRUE caso o serviço tenha sido encerrado normalmente.
+ */
+int executar_servico(char* caminho, int threads, int capacidade_cache, int paginas_grandes) {
+    struct servico v;
+    struct cliente_servico* c;
+    pthread_t* trabalhadores;
+    pthread_t leitor;
+    int servidor;
+    int fd;
+    int sucesso = TRUE;
+    
+    signal(SIGPIPE, SIG_IGN);
+    
+    if(threads <= 0) {
+        threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    
+    if(threads < 1) {
+        threads = 1;
+    }
+    
+    memset(&v, 0, sizeof(v));
+    v.capacidade_cache = capacidade_cache > 0 ? capacidade_cache : 1;
+    v.paginas_grandes = paginas_grandes;
+    pthread_mutex_init(&v.mutex_cache, NULL);
+    pthread_mutex_init(&v.mutex, NULL);
+    pthread_cond_init(&v.tarefas, NULL);
+    pthread_cond_init(&v.ociosidade, NULL);
+    
+    trabalhadores = malloc(threads * sizeof(pthread_t));
+    
+    for(int t = 0; t < threads; t++) {
+        pthread_create(&trabalhadores[t], NULL, executar_tarefas_servico, &v);
+    }
+    
+    if(strcmp(caminho, "-") == 0) {
+        atender_cliente(criar_cliente(&v, STDIN_FILENO, STDOUT_FILENO));
+    } else {
+        servidor = conectar_socket(caminho, TRUE);
+        
+        if(servidor < 0) {
+            printf("Não foi possível criar o socket %s\n", caminho);
+            sucesso = FALSE;
+        } else {
+            while((fd = accept(servidor, NULL, NULL)) >= 0 || errno == EINTR) {
+                if(fd < 0) {
+                    continue;
+                }
+                
+                c = criar_cliente(&v, fd, fd);
+                pthread_create(&leitor, NULL, atender_cliente, c);
+                pthread_detach(leitor);
+            }
+            
+            close(servidor);
+            unlink(caminho);
+        }
+    }
+    
+    //aguardando as requisições em andamento antes de encerrar as threads
+    pthread_mutex_lock(&v.mutex);
+    while(v.requisicoes > 0) {
+        pthread_cond_wait(&v.ociosidade, &v.mutex);
+    }
+    v.encerrar = TRUE;
+    pthread_cond_broadcast(&v.tarefas);
+    pthread_mutex_unlock(&v.mutex);
+    
+    for(int t = 0; t < threads; t++) {
+        pthread_join(trabalhadores[t], NULL);
+    }
+    
+    for(int k = 0; k < v.quantidade_instancias; k++) {
+        liberar_problema(&v.instancias[k]->problema);
+        free(v.instancias[k]->chave);
+        free(v.instancias[k]);
+    }
+    
+    free(v.instancias);
+    free(trabalhadores);
+    pthread_mutex_destroy(&v.mutex_cache);
+    pthread_mutex_destroy(&v.mutex);
+    pthread_cond_destroy(&v.tarefas);
+    pthread_cond_destroy(&v.ociosidade);
+    
+    return sucesso;
+}
+
+/*
+ * Function: atender_cliente
+ * -----------------------------------------------------------------------------
+ *   Lê as requisições de um cliente até o fim da sua entrada. As respostas
+ *   das requisições em andamento continuam sendo enviadas após o fim da
+ *   entrada.
+ *
+ *   argumento: cliente (struct cliente_servico).
+ *
+ *   returns: NULL.
+ */
+void* atender_cliente(void* argumento) {
+    struct cliente_servico* c = argumento;
+    char* linha;
+    char* t;
+    
+    while(receber_linha(&c->conexao, TRUE, &linha) == 1) {
+        t = linha;
+        pular_espacos_json(&t);
+        
+        if(*t) {
+            tratar_requisicao(c->servico, c, t);
+        }
+    }
+    
+    liberar_cliente(c);
+    
+    return NULL;
+}
+
+/*
+ * Function: tratar_requisicao
+ * -----------------------------------------------------------------------------
+ *   Interpreta uma requisição, obtém a sua instância do cache e coloca as
+ *   suas execuções na fila do serviço. Requisições inválidas recebem uma
+ *   resposta de erro.
+ *
+ *   v: serviço.
+ *   c: cliente que enviou a requisição.
+ *   linha: requisição recebida.
+ */
+void tratar_requisicao(struct servico* v, struct cliente_servico* c, char* linha) {
+    struct requisicao_servico* r = calloc(1, sizeof(struct requisicao_servico));
+    struct tarefa_servico* t;
+    char* caminho = malloc(PATH_MAX);
+    int* matriz = NULL;
+    int tamanho = 0;
+    const char* erro;
+    char mensagem[160];
+    char campos[256];
+    int codigo;
+    
+    inicializar_opcoes(&r->opcoes);
+    r->cliente = c;
+    r->execucoes = 1;
+    r->incumbentes = TRUE;
+    r->melhor = LLONG_MAX;
+    
+    erro = ler_requisicao(linha, r, caminho, PATH_MAX, &matriz, &tamanho);
+    
+    if(!erro) {
+        r->instancia = obter_instancia(v, caminho[0] ? caminho : NULL, tamanho, matriz, &r->reaproveitada, &codigo);
+        
+        if(!r->instancia) {
+            snprintf(mensagem, sizeof(mensagem), "não foi possível ler a instância: %s", descrever_erro(codigo));
+            erro = mensagem;
+        }
+    }
+    
+    free(caminho);
+    free(matriz);
+    
+    if(erro) {
+        snprintf(campos, sizeof(campos), "\"tipo\":\"erro\",\"mensagem\":\"%s\"", erro);
+        enviar_resposta(r, campos, 0, NULL);
+        free(r->id);
+        free(r);
+        return;
+    }
+    
+    //o serviço não imprime mensagens de depuração nem grava checkpoints
+    r->opcoes.debug = FALSE;
+    r->opcoes.debug_caminhos = FALSE;
+    r->opcoes.ao_melhorar = notificar_incumbente;
+    
+    //como no modo serial, as instâncias pequenas são resolvidas uma única vez pelo método exato
+    if(r->instancia->problema.tamanho <= TAMANHO_MAXIMO_EXATO) {
+        r->execucoes = 1;
+    }
+    
+    r->pendentes = r->execucoes;
+    r->inicio = relogio();
+    pthread_mutex_init(&r->mutex, NULL);
+    
+    pthread_mutex_lock(&c->mutex);
+    c->referencias++;
+    pthread_mutex_unlock(&c->mutex);
+    
+    pthread_mutex_lock(&v->mutex);
+    v->requisicoes++;
+    
+    for(int i = 0; i < r->execucoes; i++) {
+        t = malloc(sizeof(struct tarefa_servico));
+        t->requisicao = r;
+        t->execucao = i;
+        t->proxima = NULL;
+        
+        if(v->ultima) {
+            v->ultima->proxima = t;
+        } else {
+            v->primeira = t;
+        }
+        v->ultima = t;
+    }
+    
+    pthread_cond_broadcast(&v->tarefas);
+    pthread_mutex_unlock(&v->mutex);
+}
+
+/*
+ * Function: remover_instancias_antigas
+ * -----------------------------------------------------------------------------
+ *   Remove do cache as instâncias usadas há mais tempo, sem requisições em
+ *   andamento, até que haja espaço para uma nova instância. Deve ser chamada
+ *   com o cache bloqueado.
+ *
+ *   v: serviço.
+ */
+static void remover_instancias_antigas(struct servico* v) {
+    int antiga;
+    
+    while(v->quantidade_instancias >= v->capacidade_cache) {
+        antiga = -1;
+        
+        for(int k = 0; k < v->quantidade_instancias; k++) {
+            if(v->instancias[k]->referencias == 0 && (antiga < 0 || v->instancias[k]->ultimo_uso < v->instancias[antiga]->ultimo_uso)) {
+                antiga = k;
+            }
+        }
+        
+        //todas as instâncias estão em uso; o cache excede a capacidade temporariamente
+        if(antiga < 0) {
+            return;
+        }
+        
+        liberar_problema(&v->instancias[antiga]->problema);
+        free(v->instancias[antiga]->chave);
+        free(v->instancias[antiga]);
+        
+        v->instancias[antiga] = v->instancias[--v->quantidade_instancias];
+    }
+}
+
+/*
+ * Function: buscar_instancia
+ * -----------------------------------------------------------------------------
+ *   Procura uma instância no cache e, quando encontrada, registra uma
+ *   referência para o chamador. Deve ser chamada com o cache bloqueado.
+ *
+ *   v: serviço.
+ *   chave: chave da instância (ver obter_instancia).
+ *
+ *   returns: a instância ou NULL caso ela não esteja em cache.
+ */
+static struct instancia_servico* buscar_instancia(struct servico* v, const char* chave) {
+    for(int k = 0; k < v->quantidade_instancias; k++) {
+        if(strcmp(v->instancias[k]->chave, chave) == 0) {
+            v->instancias[k]->referencias++;
+            v->instancias[k]->ultimo_uso = ++v->relogio;
+            return v->instancias[k];
+        }
+    }
+    
+    return NULL;
+}
+
+/*
+ * Function: obter_instancia
+ * -----------------------------------------------------------------------------
+ *   Retorna a instância do cache, lendo-a e preparando o seu contexto quando
+ *   ainda não está em memória. Os arquivos são identificados pelo caminho,
+ *   pela data de modificação e pelo tamanho, de forma que um arquivo
+ *   alterado seja lido novamente; as matrizes informadas diretamente, pela
+ *   assinatura do conteúdo.
+ *
+ *   A leitura e o contexto são preparados sem bloquear o cache, de forma que
+ *   a leitura de uma instância grande não atrase as requisições das
+ *   instâncias já em memória. Se outra requisição inserir a mesma instância
+ *   nesse intervalo, a cópia já inserida é utilizada e a lida é descartada.
+ *
+ *   v: serviço.
+ *   caminho: arquivo da instância (NULL para utilizar a matriz).
+ *   tamanho: quantidade de elementos da matriz.
+ *   matriz: matriz de adjacência armazenada por linhas.
+ *   reaproveitada: recebe TRUE quando a instância já estava em cache.
+ *   erro: recebe o código do erro (ERRO_*) quando a instância não é obtida.
+ *
+ *   returns: a instância, com uma referência para o chamador (ver
+ *   liberar_instancia), ou NULL caso a instância não possa ser lida.
+ */
+struct instancia_servico* obter_instancia(struct servico* v, char* caminho, int tamanho, int* matriz, int* reaproveitada, int* erro) {
+    struct instancia_servico* instancia;
+    struct problema p;
+    struct stat estado;
+    char* chave;
+    FILE* fp;
+    
+    if(caminho) {
+        //a chave do cache utiliza a data de modificação e o tamanho do arquivo
+        if(stat(caminho, &estado) != 0 || !(fp = fopen(caminho, "r"))) {
+            *erro = ERRO_ABERTURA;
+            return NULL;
+        }
+        fclose(fp);
+        
+        chave = malloc(strlen(caminho) + 64);
+        sprintf(chave, "%s:%lld:%lld", caminho, (long long) estado.st_mtime, (long long) estado.st_size);
+    } else {
+        *erro = inicializar_problema(&p, tamanho, matriz, v->paginas_grandes);
+        
+        if(*erro) {
+            return NULL;
+        }
+        
+        chave = malloc(64);
+        sprintf(chave, "matriz:%d:%016llx", tamanho, calcular_assinatura(&p));
+    }
+    
+    pthread_mutex_lock(&v->mutex_cache);
+    instancia = buscar_instancia(v, chave);
+    pthread_mutex_unlock(&v->mutex_cache);
+    
+    *reaproveitada = instancia != NULL;
+    
+    if(instancia) {
+        free(chave);
+        
+        if(!caminho) {
+            liberar_problema(&p);
+        }
+        
+        return instancia;
+    }
+    
+    if(caminho) {
+        *erro = ler_arquivo(&p, caminho, v->paginas_grandes);
+        
+        if(*erro) {
+            free(chave);
+            return NULL;
+        }
+    }
+    
+    *erro = preparar_contexto(&p, NULL);
+    
+    if(*erro) {
+        liberar_problema(&p);
+        free(chave);
+        return NULL;
+    }
+    
+    pthread_mutex_lock(&v->mutex_cache);
+    
+    //outra requisição pode ter inserido a mesma instância durante a leitura
+    instancia = buscar_instancia(v, chave);
+    
+    if(!instancia) {
+        remover_instancias_antigas(v);
+        
+        instancia = malloc(sizeof(struct instancia_servico));
+        instancia->chave = chave;
+        instancia->problema = p;
+        instancia->referencias = 1;
+        instancia->ultimo_uso = ++v->relogio;
+        
+        v->instancias = realloc(v->instancias, (v->quantidade_instancias + 1) * sizeof(struct instancia_servico*));
+        v->instancias[v->quantidade_instancias++] = instancia;
+        chave = NULL;
+    }
+    
+    pthread_mutex_unlock(&v->mutex_cache);
+    
+    if(chave) {
+        *reaproveitada = TRUE;
+        free(chave);
+        liberar_problema(&p);
+    }
+    
+    return instancia;
+}
+
+/*
+ * Function: liberar_instancia
+ * -----------------------------------------------------------------------------
+ *   Devolve a referência de uma requisição a uma instância do cache. A
+ *   instância permanece em memória até ser removida por
+ *   remover_instancias_antigas.
+ *
+ *   v: serviço.
+ *   instancia: instância obtida por obter_instancia.
+ */
+void liberar_instancia(struct servico* v, struct instancia_servico* instancia) {
+    pthread_mutex_lock(&v->mutex_cache);
+    instancia->referencias--;
+    pthread_mutex_unlock(&v->mutex_cache);
+}
+
+/*
+ * Function: executar_tarefas_servico
+ * -----------------------------------------------------------------------------
+ *   Função executada pelas threads do serviço: retira as execuções da fila,
+ *   na ordem de chegada, até o encerramento do serviço.
+ *
+ *   argumento: serviço (struct servico).
+ *
+ *   returns: NULL.
+ */
+void* executar_tarefas_servico(void* argumento) {
+    struct servico* v = argumento;
+    struct tarefa_servico* t;
+    
+    while(TRUE) {
+        pthread_mutex_lock(&v->mutex);
+        
+        while(!v->primeira && !v->encerrar) {
+            pthread_cond_wait(&v->tarefas, &v->mutex);
+        }
+        
+        t = v->primeira;
+        
+        if(t) {
+            v->primeira = t->proxima;
+            
+            if(!v->primeira) {
+                v->ultima = NULL;
+            }
+        }
+        
+        pthread_mutex_unlock(&v->mutex);
+        
+        if(!t) {
+            return NULL;
+        }
+        
+        executar_tarefa_servico(t);
+        free(t);
+    }
+}
+
+/*
+ * Function: executar_tarefa_servico
+ * -----------------------------------------------------------------------------
+ *   Realiza uma execução de uma requisição e envia o seu resultado. As
+ *   instâncias com até TAMANHO_MAXIMO_EXATO elementos são resolvidas pelo
+ *   método exato (ver tratar_requisicao). A última execução concluída envia
+ *   o fim da requisição e a libera. As execuções de um cliente desconectado
+ *   são descartadas.
+ *
+ *   t: tarefa (execução) realizada.
+ */
+void executar_tarefa_servico(struct tarefa_servico* t) {
+    struct requisicao_servico* r = t->requisicao;
+    struct cliente_servico* c = r->cliente;
+    struct servico* v = c->servico;
+    struct problema* p = &r->instancia->problema;
+    struct opcoes opcoes = r->opcoes;
+    struct solucionador* s;
+    int* solucao;
+    char campos[256];
+    long long custo;
+    double inicio;
+    int encerrado;
+    int concluida;
+    
+    pthread_mutex_lock(&c->mutex);
+    encerrado = c->encerrado;
+    pthread_mutex_unlock(&c->mutex);
+    
+    if(!encerrado) {
+        opcoes.dados = t;
+        s = criar_solucionador(p, &opcoes);
+        solucao = inicializar_solucao(p->tamanho, NULL);
+        
+        inicio = relogio();
+        custo = p->tamanho <= TAMANHO_MAXIMO_EXATO ? resolver_exato(p, solucao) : -1;
+        
+        if(custo < 0) {
+            custo = executar_gvns(s, r->semente + t->execucao, solucao);
+        }
+        
+        pthread_mutex_lock(&r->mutex);
+        if(custo < r->melhor) {
+            r->melhor = custo;
+        }
+        pthread_mutex_unlock(&r->mutex);
+        
+        snprintf(campos, sizeof(campos), "\"tipo\":\"resultado\",\"execucao\":%d,\"semente\":%llu,\"custo\":%lld,\"tempo\":%.6f", t->execucao, r->semente + t->execucao, custo, relogio() - inicio);
+        enviar_resposta(r, campos, p->tamanho, solucao);
+        
+        liberar_solucionador(s);
+        free(solucao);
+    }
+    
+    pthread_mutex_lock(&r->mutex);
+    concluida = --r->pendentes == 0;
+    pthread_mutex_unlock(&r->mutex);
+    
+    if(!concluida) {
+        return;
+    }
+    
+    if(r->melhor < LLONG_MAX) {
+        snprintf(campos, sizeof(campos), "\"tipo\":\"fim\",\"execucoes\":%d,\"melhor\":%lld,\"tempo\":%.6f,\"cache\":%s", r->execucoes, r->melhor, relogio() - r->inicio, r->reaproveitada ? "true" : "false");
+        enviar_resposta(r, campos, 0, NULL);
+    }
+    
+    liberar_instancia(v, r->instancia);
+    liberar_cliente(c);
+    pthread_mutex_destroy(&r->mutex);
+    free(r->id);
+    free(r);
+    
+    pthread_mutex_lock(&v->mutex);
+    v->requisicoes--;
+    pthread_cond_broadcast(&v->ociosidade);
+    pthread_mutex_unlock(&v->mutex);
+}
+
+/*
+ * Function: notificar_incumbente
+ * -----------------------------------------------------------------------------
+ *   Função ao_melhorar das execuções do serviço: envia ao cliente as
+ *   melhoras da melhor solução entre todas as execuções da requisição.
+ */
+void notificar_incumbente(long long custo, int* solucao, int tamanho, void* dados) {
+    struct tarefa_servico* t = dados;
+    struct requisicao_servico* r = t->requisicao;
+    char campos[256];
+    
+    //o envio é feito com a requisição bloqueada para preservar a ordem das melhoras
+    pthread_mutex_lock(&r->mutex);
+    
+    if(custo < r->melhor) {
+        r->melhor = custo;
+        
+        if(r->incumbentes) {
+            snprintf(campos, sizeof(campos), "\"tipo\":\"incumbente\",\"execucao\":%d,\"custo\":%lld,\"tempo\":%.6f", t->execucao, custo, relogio() - r->inicio);
+            enviar_resposta(r, campos, tamanho, solucao);
+        }
+    }
+    
+    pthread_mutex_unlock(&r->mutex);
+}
+
+/*
+ * Function: responder_cliente
+ * -----------------------------------------------------------------------------
+ *   Escreve uma linha de resposta para o cliente. As escritas de threads
+ *   diferentes não se intercalam; após uma falha de escrita o cliente é
+ *   considerado desconectado.
+ *
+ *   c: cliente.
+ *   linha: resposta, terminada pelo fim de linha.
+ *
+ *   returns: TRUE caso a resposta tenha sido escrita por completo.
+ */
+int responder_cliente(struct cliente_servico* c, char* linha) {
+    size_t tamanho = strlen(linha);
+    size_t escritos = 0;
+    ssize_t n;
+    int sucesso;
+    
+    pthread_mutex_lock(&c->mutex);
+    
+    while(!c->encerrado && escritos < tamanho) {
+        n = write(c->saida, linha + escritos, tamanho - escritos);
+        
+        if(n < 0 && errno == EINTR) {
+            continue;
+        }
+        
+        if(n <= 0) {
+            c->encerrado = TRUE;
+        } else {
+            escritos += n;
+        }
+    }
+    
+    sucesso = !c->encerrado;
+    pthread_mutex_unlock(&c->mutex);
+    
+    return sucesso;
+}
+
+/*
+ * Function: liberar_cliente
+ * -----------------------------------------------------------------------------
+ *   Devolve uma referência ao cliente. A última referência fecha a conexão e
+ *   libera o cliente.
+ *
+ *   c: cliente.
+ */
+void liberar_cliente(struct cliente_servico* c) {
+    int ultima;
+    
+    pthread_mutex_lock(&c->mutex);
+    ultima = --c->referencias == 0;
+    pthread_mutex_unlock(&c->mutex);
+    
+    if(!ultima) {
+        return;
+    }
+    
+    encerrar_conexao(&c->conexao);
+    pthread_mutex_destroy(&c->mutex);
+    free(c);
+}
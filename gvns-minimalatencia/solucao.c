@@ -0,0 +1,150 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "interno.h"
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções da representação das soluções durante a busca.
+// *
+// * O índice de posições é mantido por todas as funções que alteram a
+// * solução; o custo é recalculado apenas quando a solução está marcada como
+// * alterada (ver custo_solucao).
+// * -----------------------------------------------------------------------------
+
+/*
+ * Function: criar_solucao
+ * -----------------------------------------------------------------------------
+ *   Aloca uma solução, com os elementos e o índice de posições em um único
+ *   bloco de memória.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   elementos: elementos iniciais da solução (NULL para uma solução que será
+ *   escrita posteriormente por duplicar_solucao ou definir_solucao).
+ *
+ *   returns: a solução alocada, com o custo ainda não calculado.
+ */
+struct solucao* criar_solucao(struct problema* p, int* elementos) {
+    struct solucao* s = malloc(sizeof(struct solucao) + (2 * (size_t) p->tamanho + 1) * sizeof(int));
+    
+    s->elementos = (int*) (s + 1);
+    s->posicoes = s->elementos + p->tamanho + 1;
+    s->custo = 0;
+    s->alterada = TRUE;
+    
+    if(elementos) {
+        definir_solucao(p, s, elementos, -1);
+    }
+    
+    return s;
+}
+
+/*
+ * Function: definir_solucao
+ * -----------------------------------------------------------------------------
+ *   Substitui os elementos da solução e reconstrói o índice de posições.
+ *   Utilizada quando os elementos são escritos diretamente (construção,
+ *   abalos, soluções recebidas ou restauradas de um checkpoint).
+ *
+ *   p: estrutura de dados representando o problema.
+ *   s: solução que será alterada.
+ *   elementos: novos elementos (podem ser os próprios elementos da solução,
+ *   já escritos pelo chamador).
+ *   custo: custo dos novos elementos ou -1 caso não seja conhecido.
+ */
+void definir_solucao(struct problema* p, struct solucao* s, int* elementos, long long custo) {
+    if(elementos != s->elementos) {
+        copiar_solucao(p->tamanho, elementos, s->elementos);
+    }
+    
+    atualizar_posicoes(s, 0, p->tamanho - 1);
+    
+    s->custo = custo;
+    s->alterada = custo < 0;
+}
+
+/*
+ * Function: duplicar_solucao
+ * -----------------------------------------------------------------------------
+ *   Copia uma solução com o seu custo e o seu índice de posições.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   origem: solução de origem.
+ *   destino: solução de destino.
+ */
+void duplicar_solucao(struct problema* p, struct solucao* origem, struct solucao* destino) {
+    if(origem == destino) {
+        return;
+    }
+    
+    memcpy(destino->elementos, origem->elementos, (2 * (size_t) p->tamanho + 1) * sizeof(int));
+    destino->custo = origem->custo;
+    destino->alterada = origem->alterada;
+}
+
+/*
+ * Function: custo_solucao
+ * -----------------------------------------------------------------------------
+ *   Retorna o custo da solução, calculando-o apenas quando a solução foi
+ *   alterada desde o último cálculo.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   s: solução.
+ *
+ *   returns: custo da solução.
+ */
+long long custo_solucao(struct problema* p, struct solucao* s) {
+    if(s->alterada) {
+        s->custo = calcular_custo(p, s->elementos);
+        s->alterada = FALSE;
+    }
+    
+    return s->custo;
+}
+
+/*
+ * Function: atualizar_posicoes
+ * -----------------------------------------------------------------------------
+ *   Atualiza o índice de posições dos elementos de um trecho da solução
+ *   alterado diretamente.
+ *
+ *   s: solução.
+ *   inicio: primeira posição alterada.
+ *   fim: última posição alterada.
+ */
+void atualizar_posicoes(struct solucao* s, int inicio, int fim) {
+    for(int k = inicio; k <= fim; k++) {
+        s->posicoes[s->elementos[k]] = k;
+    }
+}
+
+/*
+ * Function: trocar_elementos
+ * -----------------------------------------------------------------------------
+ *   Troca os elementos de duas posições da solução, mantendo o índice de
+ *   posições. O custo passa a ser desconhecido.
+ *
+ *   s: solução.
+ *   i: primeira posição.
+ *   j: segunda posição.
+ */
+void trocar_elementos(struct solucao* s, int i, int j) {
+    int tmp = s->elementos[i];
+    
+    s->elementos[i] = s->elementos[j];
+    s->elementos[j] = tmp;
+    s->posicoes[s->elementos[i]] = i;
+    s->posicoes[s->elementos[j]] = j;
+    s->alterada = TRUE;
+}
+
+/*
+ * Function: liberar_solucao
+ * -----------------------------------------------------------------------------
+ *   Libera a memória alocada para a solução.
+ *
+ *   s: solução que será liberada.
+ */
+void liberar_solucao(struct solucao* s) {
+    free(s);
+}
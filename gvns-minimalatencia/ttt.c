@@ -0,0 +1,161 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "modos.h"
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções do experimento time-to-target (TTT).
+// * -----------------------------------------------------------------------------
+
+/*
+ * Function: executar_ttt
+ * -----------------------------------------------------------------------------
+ *   Realiza o experimento time-to-target: as execuções são distribuídas entre
+ *   as threads informadas e cada uma continua até alcançar o alvo das opções
+ *   ou esgotar o tempo máximo (opcoes->tempo_maximo). A execução i utiliza a
+ *   semente i, como no modo serial, e o tempo registrado é o tempo de relógio
+ *   (e não o tempo de processador) até o término da execução.
+ *
+ *   p: estrutura de dados representando o problema (compartilhada entre as
+ *   threads).
+ *   opcoes: opções de execução do método.
+ *   execucoes: quantidade de execuções.
+ *   threads: quantidade de threads (0 utiliza um thread por processador).
+ *
+ *   returns: vetor com o resultado de cada execução.
+ */
+struct resultado_ttt* executar_ttt(struct problema* p, struct opcoes* opcoes, int execucoes, int threads) {
+    struct experimento_ttt e;
+    pthread_t* trabalhadores;
+    
+    if(threads <= 0) {
+        threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    
+    if(threads > execucoes) {
+        threads = execucoes;
+    }
+    
+    if(threads < 1) {
+        threads = 1;
+    }
+    
+    e.problema = p;
+    e.opcoes = opcoes;
+    e.execucoes = execucoes;
+    e.proxima = 0;
+    e.resultados = calloc(execucoes, sizeof(struct resultado_ttt));
+    pthread_mutex_init(&e.mutex, NULL);
+    
+    trabalhadores = malloc(threads * sizeof(pthread_t));
+    
+    for(int t = 0; t < threads; t++) {
+        pthread_create(&trabalhadores[t], NULL, executar_execucoes_ttt, &e);
+    }
+    
+    for(int t = 0; t < threads; t++) {
+        pthread_join(trabalhadores[t], NULL);
+    }
+    
+    pthread_mutex_destroy(&e.mutex);
+    free(trabalhadores);
+    
+    return e.resultados;
+}
+
+/*
+ * Function: executar_execucoes_ttt
+ * -----------------------------------------------------------------------------
+ *   Função executada por cada thread do experimento. A thread possui o seu
+ *   próprio solucionador e retira a próxima execução pendente até que todas
+ *   tenham sido realizadas.
+ *
+ *   argumento: experimento em andamento (struct experimento_ttt).
+ */
+void* executar_execucoes_ttt(void* argumento) {
+    struct experimento_ttt* e = argumento;
+    struct solucionador* s = criar_solucionador(e->problema, e->opcoes);
+    int* solucao = inicializar_solucao(e->problema->tamanho, NULL);
+    double inicio;
+    int i;
+    
+    while(TRUE) {
+        pthread_mutex_lock(&e->mutex);
+        i = e->proxima++;
+        pthread_mutex_unlock(&e->mutex);
+        
+        if(i >= e->execucoes) {
+            break;
+        }
+        
+        inicio = relogio();
+        e->resultados[i].execucao = i;
+        e->resultados[i].valor = executar_gvns(s, i, solucao);
+        e->resultados[i].tempo = relogio() - inicio;
+        e->resultados[i].alcancado = e->resultados[i].valor <= e->opcoes->alvo;
+    }
+    
+    free(solucao);
+    liberar_solucionador(s);
+    
+    return NULL;
+}
+
+/*
+ * Function: comparar_resultados_ttt
+ * -----------------------------------------------------------------------------
+ *   Ordena os resultados pelo tempo, com as execuções que não alcançaram o
+ *   alvo ao final.
+ */
+static int comparar_resultados_ttt(const void* a, const void* b) {
+    const struct resultado_ttt* x = a;
+    const struct resultado_ttt* y = b;
+    
+    if(x->alcancado != y->alcancado) {
+        return y->alcancado - x->alcancado;
+    }
+    
+    if(x->tempo != y->tempo) {
+        return x->tempo < y->tempo ? -1 : 1;
+    }
+    
+    return x->execucao - y->execucao;
+}
+
+/*
+ * Function: imprimir_ttt
+ * -----------------------------------------------------------------------------
+ *   Ordena os resultados e imprime a distribuição empírica do tempo até o
+ *   alvo. Para a k-ésima execução mais rápida (k = 1..execucoes) é impressa a
+ *   probabilidade acumulada (k - 0.5) / execucoes, de forma que a saída possa
+ *   ser plotada diretamente como um gráfico TTT. As execuções que esgotaram o
+ *   tempo máximo não entram na distribuição, mas continuam contando no
+ *   denominador.
+ *
+ *   Saída:
+ *   <NOME_ARQUIVO>;<K>;<TEMPO>;<PROBABILIDADE>;<EXECUCAO>;<VALOR>
+ *   ...
+ *   <NOME_ARQUIVO>;<ALCANCADAS>;<EXECUCOES>;<TEMPO_MEDIO>
+ *
+ *   arquivo: nome do arquivo da instância.
+ *   resultados: resultados das execuções (são reordenados).
+ *   execucoes: quantidade de execuções.
+ */
+void imprimir_ttt(char* arquivo, struct resultado_ttt* resultados, int execucoes) {
+    int alcancadas = 0;
+    double total = 0;
+    
+    qsort(resultados, execucoes, sizeof(struct resultado_ttt), comparar_resultados_ttt);
+    
+    for(int k = 0; k < execucoes && resultados[k].alcancado; k++) {
+        printf("%s;%d;%.6f;%.6f;%d;%lld\n", arquivo, k + 1, resultados[k].tempo, (k + 0.5) / execucoes, resultados[k].execucao, resultados[k].valor);
+        
+        total += resultados[k].tempo;
+        alcancadas++;
+    }
+    
+    printf("%s;%d;%d;%.6f\n", arquivo, alcancadas, execucoes, alcancadas ? total / alcancadas : 0);
+}
@@ -0,0 +1,820 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+
+#include "interno.h"
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções da varredura unificada das vizinhanças do VND.
+// *
+// * Os prefixos da solução explorada são calculados uma única vez por
+// * varredura e compartilhados por todas as vizinhanças. Com o arco t ligando
+// * as posições t e t + 1 (peso p->tamanho - t), os vetores guardam:
+// *
+// *   [0]: soma dos arcos anteriores a t;
+// *   [1]: soma de t * arco para os arcos anteriores a t;
+// *   [2] e [3]: as mesmas somas para os arcos percorridos no sentido inverso
+// *   (utilizadas pelo 2-opt, que inverte um trecho da solução).
+// * -----------------------------------------------------------------------------
+
+/*
+ * Function: preparar_prefixos
+ * -----------------------------------------------------------------------------
+ *   Calcula os prefixos da solução utilizados na avaliação dos movimentos.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   solucao: solução explorada.
+ *   prefixos: 4 vetores de p->tamanho + 1 posições, em sequência.
+ *
+ *   returns: custo da solução.
+ */
+long long preparar_prefixos(struct problema* p, int* solucao, long long* prefixos) {
+    long long* soma = prefixos;
+    long long* soma_ponderada = soma + p->tamanho + 1;
+    long long* soma_inversa = soma_ponderada + p->tamanho + 1;
+    long long* soma_inversa_ponderada = soma_inversa + p->tamanho + 1;
+    long long d;
+    long long d_inversa;
+    
+    soma[0] = soma_ponderada[0] = soma_inversa[0] = soma_inversa_ponderada[0] = 0;
+    
+    for(int t = 0; t < p->tamanho; t++) {
+        d = distancia(p, solucao[t], solucao[t + 1]);
+        d_inversa = distancia(p, solucao[t + 1], solucao[t]);
+        
+        soma[t + 1] = soma[t] + d;
+        soma_ponderada[t + 1] = soma_ponderada[t] + t * d;
+        soma_inversa[t + 1] = soma_inversa[t] + d_inversa;
+        soma_inversa_ponderada[t + 1] = soma_inversa_ponderada[t] + t * d_inversa;
+    }
+    
+    return p->tamanho * soma[p->tamanho] - soma_ponderada[p->tamanho];
+}
+
+/*
+ * Function: variacao_trecho
+ * -----------------------------------------------------------------------------
+ *   Variação do custo ao deslocar o trecho de tamanho elementos iniciado na
+ *   posição i para que termine na posição j (j >= i + tamanho), recuando os
+ *   elementos entre eles. É a avaliação comum aos movimentos inserção
+ *   (tamanho 1), or opt2 (tamanho 2) e or opt3 (tamanho 3).
+ *
+ *   Os arcos recuados ganham tamanho unidades de peso e os arcos internos do
+ *   trecho perdem o deslocamento do trecho; apenas os 3 arcos das
+ *   extremidades mudam de fato.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   solucao: solução explorada.
+ *   soma: prefixo dos arcos da solução (ver preparar_prefixos).
+ *   i: posição inicial do trecho.
+ *   tamanho: quantidade de elementos do trecho.
+ *   j: posição final do trecho após o movimento.
+ *
+ *   returns: variação do custo da solução.
+ */
+static inline long long variacao_trecho(struct problema* p, int* solucao, long long* soma, int i, int tamanho, int j) {
+    long long n = p->tamanho;
+    int fim = i + tamanho - 1;
+    long long variacao;
+    
+    //removendo os arcos das extremidades do trecho e o arco de destino
+    variacao = - (soma[i] - soma[i - 1]) * (n - i + 1)
+        - (soma[fim + 1] - soma[fim]) * (n - fim)
+        - (soma[j + 1] - soma[j]) * (n - j);
+    
+    //arcos recuados e arcos internos do trecho
+    variacao += tamanho * (soma[j] - soma[fim + 1]);
+    variacao -= (long long) (j - fim) * (soma[fim] - soma[i]);
+    
+    //novos arcos
+    variacao += (long long) distancia(p, solucao[i - 1], solucao[fim + 1]) * (n - i + 1)
+        + (long long) distancia(p, solucao[j], solucao[i]) * (n - j + tamanho)
+        + (long long) distancia(p, solucao[fim], solucao[j + 1]) * (n - j);
+    
+    return variacao;
+}
+
+/*
+ * Function: variacao_swap
+ * -----------------------------------------------------------------------------
+ *   Variação do custo ao trocar os elementos das posições i e j (j > i).
+ *   Apenas os arcos que chegam e saem das duas posições mudam.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   solucao: solução explorada.
+ *   soma: prefixo dos arcos da solução (ver preparar_prefixos).
+ *   i: primeira posição.
+ *   j: segunda posição.
+ *
+ *   returns: variação do custo da solução.
+ */
+static inline long long variacao_swap(struct problema* p, int* solucao, long long* soma, int i, int j) {
+    long long n = p->tamanho;
+    long long antes, depois;
+    
+    if(j == i + 1) {
+        antes = (soma[i] - soma[i - 1]) * (n - i + 1) + (soma[i + 1] - soma[i]) * (n - i) + (soma[j + 1] - soma[j]) * (n - j);
+        depois = (long long) distancia(p, solucao[i - 1], solucao[j]) * (n - i + 1) + (long long) distancia(p, solucao[j], solucao[i]) * (n - i) + (long long) distancia(p, solucao[i], solucao[j + 1]) * (n - j);
+    } else {
+        antes = (soma[i] - soma[i - 1]) * (n - i + 1) + (soma[i + 1] - soma[i]) * (n - i) + (soma[j] - soma[j - 1]) * (n - j + 1) + (soma[j + 1] - soma[j]) * (n - j);
+        depois = (long long) distancia(p, solucao[i - 1], solucao[j]) * (n - i + 1) + (long long) distancia(p, solucao[j], solucao[i + 1]) * (n - i) + (long long) distancia(p, solucao[j - 1], solucao[i]) * (n - j + 1) + (long long) distancia(p, solucao[i], solucao[j + 1]) * (n - j);
+    }
+    
+    return depois - antes;
+}
+
+/*
+ * Function: variacao_2opt
+ * -----------------------------------------------------------------------------
+ *   Variação do custo ao inverter o trecho entre as posições i e j: os arcos
+ *   internos passam a ser percorridos no sentido inverso e com os pesos
+ *   espelhados, e os 2 arcos das extremidades são substituídos.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   solucao: solução explorada.
+ *   prefixos: prefixos da solução (ver preparar_prefixos).
+ *   i: posição inicial do trecho.
+ *   j: posição final do trecho.
+ *
+ *   returns: variação do custo da solução.
+ */
+static inline long long variacao_2opt(struct problema* p, int* solucao, long long* prefixos, int i, int j) {
+    long long* soma = prefixos;
+    long long* soma_ponderada = soma + p->tamanho + 1;
+    long long* soma_inversa = soma_ponderada + p->tamanho + 1;
+    long long* soma_inversa_ponderada = soma_inversa + p->tamanho + 1;
+    long long n = p->tamanho;
+    long long interno;
+    
+    interno = (n - i - j + 1) * (soma_inversa[j] - soma_inversa[i]) + (soma_inversa_ponderada[j] - soma_inversa_ponderada[i])
+        - n * (soma[j] - soma[i]) + (soma_ponderada[j] - soma_ponderada[i]);
+    
+    return interno
+        - (soma[i] - soma[i - 1]) * (n - i + 1) - (soma[j + 1] - soma[j]) * (n - j)
+        + (long long) distancia(p, solucao[i - 1], solucao[j]) * (n - i + 1) + (long long) distancia(p, solucao[i], solucao[j + 1]) * (n - j);
+}
+
+/*
+ * Function: registrar_movimento
+ * -----------------------------------------------------------------------------
+ *   Registra o movimento (i, j) como o melhor da vizinhança quando o custo é
+ *   estritamente menor, preservando o critério de desempate das funções
+ *   realizar_* (o primeiro movimento na ordem da exploração).
+ */
+static inline void registrar_movimento(struct movimento* m, long long custo, int i, int j) {
+    if(custo < m->custo) {
+        m->custo = custo;
+        m->i = i;
+        m->j = j;
+    }
+}
+
+/*
+ * Function: varrer_vizinhancas
+ * -----------------------------------------------------------------------------
+ *   Avalia, em uma única varredura dos pares (i, j), os movimentos de todas
+ *   as vizinhanças do VND (swap, 2-opt, inserção, or opt2 e or opt3) e aplica
+ *   um dos melhores movimentos encontrados na solução resultado.
+ *
+ *   Cada movimento é avaliado em O(1) a partir dos prefixos da solução,
+ *   compartilhados pelas vizinhanças. O melhor movimento de cada vizinhança
+ *   é o mesmo encontrado pela respectiva função realizar_*.
+ *
+ *   No modo VARREDURA_POR_VIZINHANCA é aplicado o movimento de menor índice
+ *   de vizinhança que melhora a solução, exatamente como o VND sequencial; no
+ *   modo VARREDURA_MELHOR_GERAL é aplicado o melhor movimento entre todas as
+ *   vizinhanças.
+ *
+ *   s: solucionador com o problema e as opções de execução.
+ *   explorada: solução explorada.
+ *   vizinhancas: número de vizinhanças do VND.
+ *   regiao: posições marcadas pelo VND localizado (NULL avalia todas).
+ *   prefixos: área de trabalho com 4 * (p->tamanho + 1) posições.
+ *   resultado: recebe a solução com o movimento aplicado e o seu custo.
+ *
+ *   returns: a vizinhança do movimento aplicado ou -1 caso nenhum movimento
+ *   melhore a solução (resultado não é escrita).
+ */
+int varrer_vizinhancas(struct solucionador* s, struct solucao* explorada, int vizinhancas, const char* regiao, long long* prefixos, struct solucao* resultado) {
+    struct problema* p = &s->problema;
+    int* solucao = explorada->elementos;
+    struct movimento melhores[QUANTIDADE_VIZINHANCAS_VND];
+    long long* soma = prefixos;
+    long long alvo = s->opcoes.alvo;
+    long long custo;
+    int escolhida = -1;
+    
+    if(vizinhancas > QUANTIDADE_VIZINHANCAS_VND) {
+        vizinhancas = QUANTIDADE_VIZINHANCAS_VND;
+    }
+    
+    custo = preparar_prefixos(p, solucao, prefixos);
+    
+    for(int v = 0; v < vizinhancas; v++) {
+        melhores[v].custo = custo;
+        melhores[v].i = 0;
+        melhores[v].j = 0;
+    }
+    
+    for(int i = 1; i < p->tamanho; i++) {
+        for(int j = i + 1; j < p->tamanho; j++) {
+            if(!MOVIMENTO_NA_REGIAO(regiao, i, j)) {
+                continue;
+            }
+            
+            if(melhores[0].custo > alvo) {
+                registrar_movimento(&melhores[0], custo + variacao_swap(p, solucao, soma, i, j), i, j);
+            }
+            
+            if(vizinhancas > 1 && melhores[1].custo > alvo && i < p->tamanho - 1) {
+                registrar_movimento(&melhores[1], custo + variacao_2opt(p, solucao, prefixos, i, j), i, j);
+            }
+            
+            if(vizinhancas > 2 && melhores[2].custo > alvo) {
+                registrar_movimento(&melhores[2], custo + variacao_trecho(p, solucao, soma, i, 1, j), i, j);
+            }
+            
+            if(vizinhancas > 3 && melhores[3].custo > alvo && j >= i + 2 && j < p->tamanho - 1) {
+                registrar_movimento(&melhores[3], custo + variacao_trecho(p, solucao, soma, i, 2, j), i, j);
+            }
+            
+            if(vizinhancas > 4 && melhores[4].custo > alvo && j >= i + 3 && j < p->tamanho - 2) {
+                registrar_movimento(&melhores[4], custo + variacao_trecho(p, solucao, soma, i, 3, j), i, j);
+            }
+        }
+    }
+    
+    for(int v = 0; v < vizinhancas; v++) {
+        if(melhores[v].custo >= custo) {
+            continue;
+        }
+        
+        if(escolhida < 0) {
+            escolhida = v;
+            
+            if(s->opcoes.varredura_unificada == VARREDURA_POR_VIZINHANCA) {
+                break;
+            }
+        } else if(melhores[v].custo < melhores[escolhida].custo) {
+            escolhida = v;
+        }
+    }
+    
+    if(escolhida >= 0) {
+        aplicar_movimento(p, explorada, escolhida, melhores[escolhida].i, melhores[escolhida].j, melhores[escolhida].custo, resultado);
+    }
+    
+    return escolhida;
+}
+
+/*
+ * Function: aplicar_movimento
+ * -----------------------------------------------------------------------------
+ *   Aplica o movimento (i, j) da vizinhança informada, com a mesma semântica
+ *   das funções realizar_*, atualizando o índice de posições apenas no trecho
+ *   alterado. É a função utilizada por todas as vizinhanças do VND para
+ *   aplicar o movimento escolhido.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   solucao: solução original.
+ *   vizinhanca: vizinhança do movimento (0 a QUANTIDADE_VIZINHANCAS_VND - 1).
+ *   i: primeira posição do movimento.
+ *   j: segunda posição do movimento.
+ *   custo: custo da solução com o movimento aplicado.
+ *   resultado: recebe a solução com o movimento aplicado (pode ser a própria
+ *   solução original).
+ */
+void aplicar_movimento(struct problema* p, struct solucao* solucao, int vizinhanca, int i, int j, long long custo, struct solucao* resultado) {
+    int* elementos = resultado->elementos;
+    int tamanho = vizinhanca - 1;
+    int trecho[3];
+    
+    duplicar_solucao(p, solucao, resultado);
+    
+    if(vizinhanca == 0) {
+        trecho[0] = elementos[i];
+        elementos[i] = elementos[j];
+        elementos[j] = trecho[0];
+    } else if(vizinhanca == 1) {
+        realizar_swap_2opt(p, elementos, i, j, elementos);
+    } else {
+        //inserção, or opt2 e or opt3: o trecho passa a terminar na posição j
+        memcpy(trecho, elementos + i, tamanho * sizeof(int));
+        memmove(elementos + i, elementos + i + tamanho, (j - i - tamanho + 1) * sizeof(int));
+        memcpy(elementos + j - tamanho + 1, trecho, tamanho * sizeof(int));
+    }
+    
+    atualizar_posicoes(resultado, i, j);
+    resultado->custo = custo;
+    resultado->alterada = FALSE;
+}
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções da tabela persistente de ganhos do VND completo.
+// *
+// * Após um movimento de melhora, o VND reinicia pela primeira vizinhança e
+// * reavalia todos os movimentos, embora apenas os que envolvem as posições
+// * alteradas tenham mudado de valor. A tabela guarda, para cada vizinhança e
+// * cada posição i, o melhor movimento (i, j) e a sua variação, além da
+// * solução para a qual esses valores foram calculados. A cada consulta, as
+// * posições alteradas desde a consulta anterior são identificadas e apenas
+// * as linhas e movimentos afetados são reavaliados (em O(1) cada, a partir
+// * dos prefixos da solução):
+// *
+// *   swap: o movimento (i, j) depende apenas dos elementos de i - 1 a i + 1
+// *   e de j - 1 a j + 1; as linhas afetadas são recalculadas e, nas demais,
+// *   apenas as colunas afetadas são reavaliadas;
+// *   2-opt, inserção e or opt: o movimento (i, j) depende de todos os
+// *   elementos de i - 1 a j + 1; as linhas iniciadas após a última posição
+// *   alterada são mantidas e, nas anteriores, apenas os movimentos que
+// *   alcançam a primeira posição alterada são reavaliados, quando o melhor
+// *   movimento da linha não é um deles.
+// *
+// * Os pesos dos arcos dependem apenas das posições, que não mudam fora do
+// * trecho alterado. O melhor movimento de cada vizinhança é o mesmo
+// * encontrado pela respectiva função realizar_* (o primeiro na ordem da
+// * exploração, inclusive com alvo).
+// * -----------------------------------------------------------------------------
+
+/*
+ * Function: limites_linha_ganhos
+ * -----------------------------------------------------------------------------
+ *   Intervalo das posições j dos movimentos (i, j) da vizinhança, o mesmo
+ *   explorado pelas funções realizar_*.
+ *
+ *   n: tamanho do problema.
+ *   vizinhanca: vizinhança do movimento.
+ *   i: primeira posição do movimento.
+ *   inicio: recebe a primeira posição j.
+ *   fim: recebe a última posição j (menor que inicio quando a linha é vazia).
+ */
+static inline void limites_linha_ganhos(int n, int vizinhanca, int i, int* inicio, int* fim) {
+    switch (vizinhanca) {
+        case 1:
+            *inicio = i + 1;
+            *fim = i < n - 1 ? n - 1 : 0;
+            break;
+        case 3:
+            *inicio = i + 2;
+            *fim = n - 2;
+            break;
+        case 4:
+            *inicio = i + 3;
+            *fim = n - 3;
+            break;
+        default:
+            *inicio = i + 1;
+            *fim = n - 1;
+    }
+}
+
+/*
+ * Function: variacao_movimento
+ * -----------------------------------------------------------------------------
+ *   Variação do custo do movimento (i, j) da vizinhança informada.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   solucao: solução explorada.
+ *   prefixos: prefixos da solução (ver preparar_prefixos).
+ *   vizinhanca: vizinhança do movimento.
+ *   i: primeira posição do movimento.
+ *   j: segunda posição do movimento.
+ *
+ *   returns: variação do custo da solução.
+ */
+static inline long long variacao_movimento(struct problema* p, int* solucao, long long* prefixos, int vizinhanca, int i, int j) {
+    switch (vizinhanca) {
+        case 0:
+            return variacao_swap(p, solucao, prefixos, i, j);
+        case 1:
+            return variacao_2opt(p, solucao, prefixos, i, j);
+        default:
+            return variacao_trecho(p, solucao, prefixos, i, vizinhanca - 1, j);
+    }
+}
+
+/*
+ * Function: avaliar_linha_ganhos
+ * -----------------------------------------------------------------------------
+ *   Avalia os movimentos (i, j) da linha i com j a partir de primeira,
+ *   substituindo o melhor movimento da linha quando a variação é
+ *   estritamente menor (empates pelo menor j).
+ *
+ *   p: estrutura de dados representando o problema.
+ *   linhas: linhas da vizinhança.
+ *   solucao: solução explorada.
+ *   prefixos: prefixos da solução.
+ *   vizinhanca: vizinhança da tabela.
+ *   i: linha avaliada.
+ *   primeira: primeira posição j avaliada.
+ */
+static void avaliar_linha_ganhos(struct problema* p, struct linhas_ganhos* linhas, int* solucao, long long* prefixos, int vizinhanca, int i, int primeira) {
+    long long variacao;
+    int inicio, fim;
+    
+    limites_linha_ganhos(p->tamanho, vizinhanca, i, &inicio, &fim);
+    
+    if(primeira < inicio) {
+        primeira = inicio;
+    }
+    
+    for(int j = primeira; j <= fim; j++) {
+        variacao = variacao_movimento(p, solucao, prefixos, vizinhanca, i, j);
+        
+        if(variacao < linhas->variacao[i]) {
+            linhas->variacao[i] = variacao;
+            linhas->melhor_j[i] = j;
+        }
+    }
+}
+
+/*
+ * Function: recalcular_linha_ganhos
+ * -----------------------------------------------------------------------------
+ *   Recalcula o melhor movimento da linha i.
+ *
+ *   Parâmetros: ver avaliar_linha_ganhos.
+ */
+static void recalcular_linha_ganhos(struct problema* p, struct linhas_ganhos* linhas, int* solucao, long long* prefixos, int vizinhanca, int i) {
+    linhas->variacao[i] = LLONG_MAX;
+    linhas->melhor_j[i] = 0;
+    
+    avaliar_linha_ganhos(p, linhas, solucao, prefixos, vizinhanca, i, 0);
+}
+
+/*
+ * Function: preparar_tabela_ganhos
+ * -----------------------------------------------------------------------------
+ *   Retorna a tabela de ganhos do solucionador, alocando-a na primeira
+ *   chamada. A tabela ocupa O(n) posições por vizinhança.
+ *
+ *   s: solucionador com o problema e as opções de execução.
+ *
+ *   returns: a tabela de ganhos.
+ */
+struct tabela_ganhos* preparar_tabela_ganhos(struct solucionador* s) {
+    struct tabela_ganhos* t = s->ganhos;
+    int n = s->problema.tamanho;
+    
+    if(t) {
+        return t;
+    }
+    
+    t = malloc(sizeof(struct tabela_ganhos));
+    t->prefixos = malloc(4 * (size_t) (n + 1) * sizeof(long long));
+    t->afetada = malloc((n + 1) * sizeof(char));
+    t->alteradas = malloc((n + 1) * sizeof(int));
+    
+    for(int v = 0; v < QUANTIDADE_VIZINHANCAS_VND; v++) {
+        t->linhas[v].referencia = malloc((n + 1) * sizeof(int));
+        t->linhas[v].melhor_j = malloc((n + 1) * sizeof(int));
+        t->linhas[v].variacao = malloc((n + 1) * sizeof(long long));
+        t->linhas[v].valida = FALSE;
+    }
+    
+    s->ganhos = t;
+    
+    return t;
+}
+
+/*
+ * Function: atualizar_linhas_ganhos
+ * -----------------------------------------------------------------------------
+ *   Atualiza as linhas da vizinhança para a solução explorada, reavaliando
+ *   apenas os movimentos afetados pelas posições alteradas desde a última
+ *   atualização (ver o início deste bloco).
+ *
+ *   p: estrutura de dados representando o problema.
+ *   t: tabela de ganhos.
+ *   vizinhanca: vizinhança atualizada.
+ *   solucao: solução explorada.
+ */
+static void atualizar_linhas_ganhos(struct problema* p, struct tabela_ganhos* t, int vizinhanca, int* solucao) {
+    struct linhas_ganhos* linhas = &t->linhas[vizinhanca];
+    int n = p->tamanho;
+    int quantidade = 0;
+    int primeira, ultima;
+    int afetadas = 0;
+    int inicio, fim;
+    long long variacao;
+    
+    if(linhas->valida) {
+        for(int k = 1; k < n; k++) {
+            if(linhas->referencia[k] != solucao[k]) {
+                t->alteradas[quantidade++] = k;
+            }
+        }
+        
+        if(quantidade == 0) {
+            return;
+        }
+    }
+    
+    if(!linhas->valida || quantidade > n / FRACAO_RECALCULO_TABELA_GANHOS) {
+        for(int i = 1; i < n; i++) {
+            recalcular_linha_ganhos(p, linhas, solucao, t->prefixos, vizinhanca, i);
+        }
+    } else if(vizinhanca == 0) {
+        memset(t->afetada, FALSE, (n + 1) * sizeof(char));
+        
+        for(int k = 0; k < quantidade; k++) {
+            t->afetada[t->alteradas[k] - 1] = TRUE;
+            t->afetada[t->alteradas[k]] = TRUE;
+            t->afetada[t->alteradas[k] + 1] = TRUE;
+        }
+        
+        //as posições afetadas, em ordem crescente, reaproveitando o vetor das alteradas
+        for(int k = 1; k < n; k++) {
+            if(t->afetada[k]) {
+                t->alteradas[afetadas++] = k;
+            }
+        }
+        
+        for(int i = 1; i < n; i++) {
+            if(t->afetada[i] || t->afetada[linhas->melhor_j[i]]) {
+                recalcular_linha_ganhos(p, linhas, solucao, t->prefixos, vizinhanca, i);
+                continue;
+            }
+            
+            limites_linha_ganhos(n, vizinhanca, i, &inicio, &fim);
+            
+            for(int k = 0; k < afetadas; k++) {
+                int j = t->alteradas[k];
+                
+                if(j < inicio || j > fim) {
+                    continue;
+                }
+                
+                variacao = variacao_movimento(p, solucao, t->prefixos, vizinhanca, i, j);
+                
+                if(variacao < linhas->variacao[i] || (variacao == linhas->variacao[i] && j < linhas->melhor_j[i])) {
+                    linhas->variacao[i] = variacao;
+                    linhas->melhor_j[i] = j;
+                }
+            }
+        }
+    } else {
+        primeira = t->alteradas[0];
+        ultima = t->alteradas[quantidade - 1];
+        
+        //as linhas iniciadas após a última alteração não mudam
+        for(int i = 1; i <= ultima + 1 && i < n; i++) {
+            if(linhas->melhor_j[i] && linhas->melhor_j[i] <= primeira - 2) {
+                avaliar_linha_ganhos(p, linhas, solucao, t->prefixos, vizinhanca, i, primeira - 1);
+            } else {
+                recalcular_linha_ganhos(p, linhas, solucao, t->prefixos, vizinhanca, i);
+            }
+        }
+    }
+    
+    copiar_solucao(n, solucao, linhas->referencia);
+    linhas->valida = TRUE;
+}
+
+/*
+ * Function: explorar_tabela_ganhos
+ * -----------------------------------------------------------------------------
+ *   Equivalente a encontrar_melhor_vizinho para a solução inteira (sem
+ *   região), com o melhor movimento obtido da tabela persistente de ganhos.
+ *   Utilizada pelo VND completo em instâncias com ao menos
+ *   TAMANHO_MINIMO_TABELA_GANHOS elementos (ver vnd_localizado).
+ *
+ *   s: solucionador com o problema e as opções de execução.
+ *   explorada: solução explorada.
+ *   vizinhanca: vizinhança explorada.
+ *   resultado: recebe a solução com o melhor movimento aplicado.
+ *
+ *   returns: custo do melhor vizinho, escrito em resultado apenas quando é
+ *   menor que o custo da solução explorada.
+ */
+long long explorar_tabela_ganhos(struct solucionador* s, struct solucao* explorada, int vizinhanca, struct solucao* resultado) {
+    struct problema* p = &s->problema;
+    struct tabela_ganhos* t = preparar_tabela_ganhos(s);
+    struct linhas_ganhos* linhas;
+    int* solucao = explorada->elementos;
+    long long custo = custo_solucao(p, explorada);
+    long long melhor = custo;
+    int melhor_i = 0;
+    int melhor_j = 0;
+    int inicio, fim;
+    
+    if(vizinhanca >= QUANTIDADE_VIZINHANCAS_VND || custo <= s->opcoes.alvo) {
+        return custo;
+    }
+    
+    linhas = &t->linhas[vizinhanca];
+    
+    preparar_prefixos(p, solucao, t->prefixos);
+    atualizar_linhas_ganhos(p, t, vizinhanca, solucao);
+    
+    for(int i = 1; i < p->tamanho; i++) {
+        if(linhas->melhor_j[i] && custo + linhas->variacao[i] < melhor) {
+            melhor = custo + linhas->variacao[i];
+            melhor_i = i;
+            melhor_j = linhas->melhor_j[i];
+        }
+    }
+    
+    //com alvo, a exploração sequencial para no primeiro movimento que o alcança
+    if(melhor_i && melhor <= s->opcoes.alvo) {
+        for(int i = 1; i < p->tamanho; i++) {
+            if(!linhas->melhor_j[i] || custo + linhas->variacao[i] > s->opcoes.alvo) {
+                continue;
+            }
+            
+            limites_linha_ganhos(p->tamanho, vizinhanca, i, &inicio, &fim);
+            
+            for(int j = inicio; j <= fim; j++) {
+                melhor = custo + variacao_movimento(p, solucao, t->prefixos, vizinhanca, i, j);
+                
+                if(melhor <= s->opcoes.alvo) {
+                    melhor_i = i;
+                    melhor_j = j;
+                    break;
+                }
+            }
+            
+            break;
+        }
+    }
+    
+    if(melhor_i) {
+        aplicar_movimento(p, explorada, vizinhanca, melhor_i, melhor_j, melhor, resultado);
+    }
+    
+    return melhor;
+}
+
+/*
+ * Function: liberar_tabela_ganhos
+ * -----------------------------------------------------------------------------
+ *   Libera a tabela de ganhos.
+ *
+ *   t: tabela que será liberada.
+ */
+void liberar_tabela_ganhos(struct tabela_ganhos* t) {
+    for(int v = 0; v < QUANTIDADE_VIZINHANCAS_VND; v++) {
+        free(t->linhas[v].referencia);
+        free(t->linhas[v].melhor_j);
+        free(t->linhas[v].variacao);
+    }
+    
+    free(t->prefixos);
+    free(t->afetada);
+    free(t->alteradas);
+    free(t);
+}
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções de verificação das avaliações em O(1).
+// *
+// * A varredura unificada, a tabela de ganhos e a avaliação vetorial devem
+// * escolher exatamente o mesmo movimento das funções realizar_*, que
+// * calculam o custo completo de cada vizinho. A verificação percorre VNDs
+// * completos a partir de soluções aleatórias e compara, a cada passo, as
+// * variações e os movimentos escolhidos por cada avaliação com os das
+// * funções realizar_*.
+// * -----------------------------------------------------------------------------
+
+/*
+ * Function: mesmo_vizinho
+ * -----------------------------------------------------------------------------
+ *   Compara o resultado de uma exploração com o da função realizar_*
+ *   correspondente: o mesmo custo e, quando ele melhora a solução explorada,
+ *   a mesma solução resultado.
+ *
+ *   p: estrutura de dados representando o problema.
+ *   custo: custo da solução explorada.
+ *   custo_referencia: custo retornado pela função realizar_*.
+ *   referencia: solução escrita pela função realizar_*.
+ *   custo_obtido: custo retornado pela exploração verificada.
+ *   obtido: solução escrita pela exploração verificada.
+ *
+ *   returns: TRUE caso os resultados coincidam.
+ */
+static int mesmo_vizinho(struct problema* p, long long custo, long long custo_referencia, struct solucao* referencia, long long custo_obtido, struct solucao* obtido) {
+    if(custo_obtido != custo_referencia) {
+        return FALSE;
+    }
+    
+    return custo_referencia >= custo || memcmp(referencia->elementos, obtido->elementos, (p->tamanho + 1) * sizeof(int)) == 0;
+}
+
+/*
+ * Function: verificar_vizinhancas
+ * -----------------------------------------------------------------------------
+ *   Confere as avaliações em O(1) das vizinhanças do VND com as funções
+ *   realizar_*. A partir de cada solução de teste (ver gerar_solucoes_teste)
+ *   é realizado um VND completo com as funções realizar_* e, a cada passo:
+ *
+ *   - a variação de cada movimento (i, j) de cada vizinhança avaliada (ver
+ *   variacao_movimento) é comparada ao custo calculado após aplicar o
+ *   movimento;
+ *   - o melhor vizinho obtido pela tabela de ganhos e, em instâncias com até
+ *   TAMANHO_MAXIMO_VETORIAL elementos e distâncias de 16 bits, pela
+ *   avaliação vetorial é comparado ao da função realizar_*;
+ *   - a vizinhança e a solução escolhidas por varrer_vizinhancas são
+ *   comparadas às do VND sequencial.
+ *
+ *   Cada passo avalia O(n^3) distâncias, de forma que a verificação se
+ *   destina às instâncias pequenas. Exibe uma linha por avaliação:
+ *
+ *   <AVALIACAO>;<COMPARACOES>;<DIVERGENCIAS>
+ *
+ *   p: estrutura de dados representando o problema.
+ *   quantidade: quantidade de soluções de teste.
+ *
+ *   returns: quantidade total de divergências.
+ */
+long long verificar_vizinhancas(struct problema* p, int quantidade) {
+    static const char* nomes[] = {"variacoes", "tabela_ganhos", "vetorial", "varredura_unificada"};
+    struct opcoes opcoes;
+    struct solucionador* s;
+    struct solucao* atual;
+    struct solucao* referencia;
+    struct solucao* candidata;
+    int n = p->tamanho;
+    int* solucoes = gerar_solucoes_teste(p, quantidade);
+    long long* prefixos = malloc(4 * (size_t) (n + 1) * sizeof(long long));
+    long long comparacoes[4] = {0, 0, 0, 0};
+    long long divergencias[4] = {0, 0, 0, 0};
+    long long total = 0;
+    long long custo, custo_referencia, custo_obtido;
+    int vetorial = n <= TAMANHO_MAXIMO_VETORIAL && p->kernel && p->kernel->bits == 16;
+    int escolhida;
+    int inicio, fim;
+    
+    inicializar_opcoes(&opcoes);
+    opcoes.alvo = 0;
+    opcoes.varredura_unificada = VARREDURA_POR_VIZINHANCA;
+    s = criar_solucionador(p, &opcoes);
+    p = &s->problema;
+    
+    referencia = criar_solucao(p, NULL);
+    candidata = criar_solucao(p, NULL);
+    
+    for(int k = 0; k < quantidade; k++) {
+        atual = criar_solucao(p, solucoes + (size_t) k * (n + 1));
+        
+        do {
+            custo = custo_solucao(p, atual);
+            escolhida = -1;
+            
+            //as vizinhanças do VND sequencial até a primeira que melhora a solução
+            for(int v = 0; v < QUANTIDADE_VIZINHANCAS_VND && escolhida < 0; v++) {
+                preparar_prefixos(p, atual->elementos, prefixos);
+                
+                for(int i = 1; i < n; i++) {
+                    limites_linha_ganhos(n, v, i, &inicio, &fim);
+                    
+                    for(int j = inicio; j <= fim; j++) {
+                        aplicar_movimento(p, atual, v, i, j, 0, candidata);
+                        
+                        comparacoes[0]++;
+                        divergencias[0] += custo + variacao_movimento(p, atual->elementos, prefixos, v, i, j) != calcular_custo(p, candidata->elementos);
+                    }
+                }
+                
+                custo_referencia = encontrar_melhor_vizinho(s, atual, v, NULL, referencia);
+                
+                custo_obtido = explorar_tabela_ganhos(s, atual, v, candidata);
+                comparacoes[1]++;
+                divergencias[1] += !mesmo_vizinho(p, custo, custo_referencia, referencia, custo_obtido, candidata);
+                
+                if(vetorial) {
+                    custo_obtido = explorar_vizinhanca_vetorial(s, atual, v, NULL, candidata);
+                    comparacoes[2]++;
+                    divergencias[2] += !mesmo_vizinho(p, custo, custo_referencia, referencia, custo_obtido, candidata);
+                }
+                
+                if(custo_referencia < custo) {
+                    escolhida = v;
+                }
+            }
+            
+            comparacoes[3]++;
+            divergencias[3] += varrer_vizinhancas(s, atual, QUANTIDADE_VIZINHANCAS_VND, NULL, prefixos, candidata) != escolhida
+                || (escolhida >= 0 && !mesmo_vizinho(p, custo, referencia->custo, referencia, candidata->custo, candidata));
+            
+            if(escolhida >= 0) {
+                duplicar_solucao(p, referencia, atual);
+            }
+        } while(escolhida >= 0);
+        
+        liberar_solucao(atual);
+    }
+    
+    for(int c = 0; c < 4; c++) {
+        printf("%s;%lld;%lld\n", nomes[c], comparacoes[c], divergencias[c]);
+        total += divergencias[c];
+    }
+    
+    liberar_solucao(referencia);
+    liberar_solucao(candidata);
+    liberar_solucionador(s);
+    free(prefixos);
+    free(solucoes);
+    
+    return total;
+}
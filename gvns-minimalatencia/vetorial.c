@@ -0,0 +1,284 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "interno.h"
+
+// * -----------------------------------------------------------------------------
+// * Bloco de funções da avaliação vetorial do VND nas instâncias pequenas.
+// *
+// * Com até TAMANHO_MAXIMO_VETORIAL elementos, o custo de uma solução é
+// * calculado em poucos nanossegundos e o VND é dominado pela quantidade de
+// * avaliações completas (uma por movimento). A avaliação vetorial calcula a
+// * variação de custo de todos os movimentos (i, j) de uma linha i ao mesmo
+// * tempo, um movimento por lane: as distâncias são lidas de uma cópia da
+// * matriz ordenada pela solução explorada (distancias[a][b] é a distância
+// * entre os elementos das posições a e b, e a transposta guarda as colunas),
+// * de forma que os valores de j consecutivos ocupam posições consecutivas e
+// * são carregados sem acessos indiretos. Os trechos deslocados ou invertidos
+// * pelo movimento são avaliados a partir dos prefixos da solução (ver
+// * preparar_prefixos). As linhas da cópia são montadas sob demanda e
+// * refeitas apenas quando a solução explorada muda, de forma que as
+// * vizinhanças avaliadas sem melhora as reaproveitam.
+// *
+// * As linhas guardam a coluna c na posição c + 1, de forma que as lanes de
+// * j - 1 e j + 1 também sejam carregadas diretamente. Todos os valores cabem
+// * em int com distâncias de 16 bits (ver kernels.c).
+// *
+// * Os movimentos de cada linha são percorridos na mesma ordem das funções
+// * realizar_*, com o mesmo critério de escolha e de interrupção ao alcançar o
+// * alvo, de forma que o movimento aplicado seja sempre o mesmo.
+// * -----------------------------------------------------------------------------
+/*
+ * Function: preparar_percurso_vetorial
+ * -----------------------------------------------------------------------------
+ *   Retorna a cópia da matriz ordenada pela solução, alocando-a na primeira
+ *   chamada. Quando a solução mudou desde a última chamada, apenas os
+ *   prefixos são recalculados e as linhas passam a ser montadas sob demanda
+ *   (ver linha_distancias e linha_transposta), já que o VND localizado
+ *   avalia poucas linhas de cada solução.
+ *
+ *   s: solucionador com o problema e as opções de execução.
+ *   solucao: solução explorada.
+ *
+ *   returns: a cópia da matriz ordenada pela solução.
+ */
+static struct percurso_vetorial* preparar_percurso_vetorial(struct solucionador* s, int* solucao) {
+    struct problema* p = &s->problema;
+    struct percurso_vetorial* v = s->vetorial;
+    int n = p->tamanho;
+    int inverso;
+    
+    if(!v) {
+        v = calloc(1, sizeof(struct percurso_vetorial));
+        s->vetorial = v;
+    } else if(v->geracao && memcmp(v->referencia, solucao, (n + 1) * sizeof(int)) == 0) {
+        return v;
+    }
+    
+    //prefixos dos arcos nos dois sentidos (ver preparar_prefixos)
+    for(int t = 0; t < n; t++) {
+        v->arco[t + 1] = distancia(p, solucao[t], solucao[t + 1]);
+        inverso = distancia(p, solucao[t + 1], solucao[t]);
+        
+        v->soma[t + 2] = v->soma[t + 1] + v->arco[t + 1];
+        v->soma_ponderada[t + 2] = v->soma_ponderada[t + 1] + t * v->arco[t + 1];
+        v->soma_inversa[t + 2] = v->soma_inversa[t + 1] + inverso;
+        v->soma_inversa_ponderada[t + 2] = v->soma_inversa_ponderada[t + 1] + t * inverso;
+    }
+    
+    memcpy(v->referencia, solucao, (n + 1) * sizeof(int));
+    v->geracao++;
+    
+    return v;
+}
+
+/*
+ * Function: linha_distancias
+ * -----------------------------------------------------------------------------
+ *   Retorna a linha a da matriz ordenada pela solução (distâncias do elemento
+ *   da posição a aos elementos de cada posição), montando-a caso ainda não
+ *   tenha sido montada para a solução atual.
+ *
+ *   v: cópia da matriz ordenada pela solução.
+ *   p: estrutura de dados representando o problema.
+ *   a: posição do elemento.
+ *
+ *   returns: a linha, com a coluna c na posição c + 1.
+ */
+static inline const int* linha_distancias(struct percurso_vetorial* v, struct problema* p, int a) {
+    const int* distancias = p->elementos[v->referencia[a]];
+    
+    if(v->geracao_distancias[a] != v->geracao) {
+        for(int b = 0; b <= p->tamanho; b++) {
+            v->distancias[a][b + 1] = distancias[v->referencia[b]];
+        }
+        
+        v->geracao_distancias[a] = v->geracao;
+    }
+    
+    return v->distancias[a];
+}
+
+/*
+ * Function: linha_transposta
+ * -----------------------------------------------------------------------------
+ *   Retorna a linha b da transposta da matriz ordenada pela solução
+ *   (distâncias dos elementos de cada posição ao elemento da posição b),
+ *   montando-a caso ainda não tenha sido montada para a solução atual.
+ *
+ *   v: cópia da matriz ordenada pela solução.
+ *   p: estrutura de dados representando o problema.
+ *   b: posição do elemento.
+ *
+ *   returns: a linha, com a coluna c na posição c + 1.
+ */
+static inline const int* linha_transposta(struct percurso_vetorial* v, struct problema* p, int b) {
+    int elemento = v->referencia[b];
+    
+    if(v->geracao_transposta[b] != v->geracao) {
+        for(int a = 0; a <= p->tamanho; a++) {
+            v->transposta[b][a + 1] = p->elementos[v->referencia[a]][elemento];
+        }
+        
+        v->geracao_transposta[b] = v->geracao;
+    }
+    
+    return v->transposta[b];
+}
+
+/*
+ * Function: variacoes_linha
+ * -----------------------------------------------------------------------------
+ *   Calcula a variação de custo dos movimentos (i, j) da linha i de uma
+ *   vizinhança, um movimento por lane (lane j). Os laços têm a quantidade de
+ *   lanes fixa e sem dependência entre elas, de forma que o compilador os
+ *   converta em instruções vetoriais. As lanes fora dos limites da vizinhança
+ *   recebem valores sem significado.
+ *
+ *   v: cópia da matriz ordenada pela solução explorada.
+ *   p: estrutura de dados representando o problema.
+ *   vizinhanca: vizinhança avaliada (0 swap, 1 2-opt, 2 inserção, 3 or opt
+ *   de 2 e 4 or opt de 3 elementos).
+ *   i: linha avaliada.
+ *   variacao: variações de custo da linha (TAMANHO_MAXIMO_VETORIAL lanes).
+ */
+static void variacoes_linha(struct percurso_vetorial* v, struct problema* p, int vizinhanca, int i, int* restrict variacao) {
+    int n = p->tamanho;
+    const int* arco = &v->arco[1];
+    const int* soma = &v->soma[1];
+    const int* antes = &linha_distancias(v, p, i - 1)[1];
+    const int* origem;
+    const int* destino;
+    const int* seguinte;
+    int bloco;
+    
+    switch (vizinhanca) {
+        case 0:
+            //os dois elementos trocados e os seus quatro arcos
+            origem = &linha_distancias(v, p, i)[1];
+            destino = &linha_transposta(v, p, i)[1];
+            seguinte = &linha_transposta(v, p, i + 1)[1];
+            
+            for(int j = 0; j < TAMANHO_MAXIMO_VETORIAL; j++) {
+                variacao[j] = (antes[j] - arco[i - 1]) * (n - i + 1)
+                            + (seguinte[j] - arco[i]) * (n - i)
+                            + (destino[j - 1] - arco[j - 1]) * (n - j + 1)
+                            + (origem[j + 1] - arco[j]) * (n - j);
+            }
+            
+            //elementos adjacentes: o arco entre eles apenas muda de sentido
+            if(i + 1 < TAMANHO_MAXIMO_VETORIAL) {
+                variacao[i + 1] = (antes[i + 1] - arco[i - 1]) * (n - i + 1)
+                                + (destino[i + 1] - arco[i]) * (n - i)
+                                + (origem[i + 2] - arco[i + 1]) * (n - i - 1);
+            }
+            break;
+        case 1:
+            //extremidades do trecho invertido e o trecho percorrido no sentido inverso
+            origem = &linha_distancias(v, p, i)[1];
+            
+            for(int j = 0; j < TAMANHO_MAXIMO_VETORIAL; j++) {
+                variacao[j] = (antes[j] - arco[i - 1]) * (n - i + 1)
+                            + (origem[j + 1] - arco[j]) * (n - j)
+                            + (n - i + 1 - j) * (v->soma_inversa[j + 1] - v->soma_inversa[i + 1])
+                            + (v->soma_inversa_ponderada[j + 1] - v->soma_inversa_ponderada[i + 1])
+                            - n * (soma[j] - soma[i])
+                            + (v->soma_ponderada[j + 1] - v->soma_ponderada[i + 1]);
+            }
+            break;
+        default:
+            //o bloco de i a i + bloco - 1 passa a terminar na posição j
+            bloco = vizinhanca - 1;
+            origem = &linha_distancias(v, p, i + bloco - 1)[1];
+            destino = &linha_transposta(v, p, i)[1];
+            
+            for(int j = 0; j < TAMANHO_MAXIMO_VETORIAL; j++) {
+                variacao[j] = (antes[i + bloco] - arco[i - 1]) * (n - i + 1)
+                            - arco[i + bloco - 1] * (n - i - bloco + 1)
+                            + destino[j] * (n - j + bloco)
+                            + (origem[j + 1] - arco[j]) * (n - j)
+                            + bloco * (soma[j] - soma[i + bloco])
+                            - (j - bloco + 1 - i) * (soma[i + bloco - 1] - soma[i]);
+            }
+            break;
+    }
+}
+
+/*
+ * Function: explorar_vizinhanca_vetorial
+ * -----------------------------------------------------------------------------
+ *   Explora uma vizinhança do VND calculando as variações de cada linha com a
+ *   avaliação vetorial, com o mesmo resultado da função realizar_*
+ *   correspondente. Utilizada apenas em problemas com até
+ *   TAMANHO_MAXIMO_VETORIAL elementos e distâncias de 16 bits.
+ *
+ *   s: solucionador com o problema e as opções de execução.
+ *   explorada: solução que terá sua vizinhança explorada.
+ *   vizinhanca: vizinhança explorada.
+ *   regiao: posições marcadas pelo VND localizado (NULL avalia todos os
+ *   movimentos).
+ *   resultado: a melhor solução encontrada.
+ *
+ *   returns: custo da melhor solução encontrada. A solução resultado só é
+ *   escrita quando esse custo é menor que o custo da solução explorada.
+ */
+long long explorar_vizinhanca_vetorial(struct solucionador* s, struct solucao* explorada, int vizinhanca, const char* regiao, struct solucao* resultado) {
+    struct problema* p = &s->problema;
+    struct percurso_vetorial* v;
+    int variacao[TAMANHO_MAXIMO_VETORIAL];
+    int n = p->tamanho;
+    int bloco = vizinhanca < 3 ? 1 : vizinhanca - 1;
+    long long custo_inicial, custo, custo_tmp;
+    int melhor_i = 0;
+    int melhor_j = 0;
+    int ultima = n - bloco;
+    
+    custo_inicial = custo = custo_solucao(p, explorada);
+    v = preparar_percurso_vetorial(s, explorada->elementos);
+    
+    //última posição marcada que pode ser o j de algum movimento
+    while(regiao && ultima > 0 && !regiao[ultima]) {
+        ultima--;
+    }
+    
+    //apenas as linhas com algum movimento (j de i + bloco a n - bloco) na região
+    for(int i = 1; i <= n - 2 * bloco && custo > s->opcoes.alvo; i++) {
+        if(regiao && !regiao[i] && ultima < i + bloco) {
+            continue;
+        }
+        
+        variacoes_linha(v, p, vizinhanca, i, variacao);
+        
+        for(int j = i + bloco; j <= n - bloco && custo > s->opcoes.alvo; j++) {
+            if(!MOVIMENTO_NA_REGIAO(regiao, i, j)) {
+                continue;
+            }
+            
+            custo_tmp = custo_inicial + variacao[j];
+            
+            if(custo_tmp < custo) {
+                custo = custo_tmp;
+                melhor_i = i;
+                melhor_j = j;
+            }
+        }
+    }
+    
+    if(melhor_i) {
+        aplicar_movimento(p, explorada, vizinhanca, melhor_i, melhor_j, custo, resultado);
+    }
+    
+    return custo;
+}
+
+/*
+ * Function: liberar_percurso_vetorial
+ * -----------------------------------------------------------------------------
+ *   Libera a cópia da matriz ordenada pela solução.
+ *
+ *   v: cópia que será liberada.
+ */
+void liberar_percurso_vetorial(struct percurso_vetorial* v) {
+    free(v);
+}